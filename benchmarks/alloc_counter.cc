@@ -0,0 +1,34 @@
+#include "alloc_counter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace sequoia::benchmarks {
+
+namespace {
+std::atomic<int64_t> g_alloc_count{0};
+} // namespace
+
+int64_t allocCount() noexcept {
+    return g_alloc_count.load(std::memory_order_relaxed);
+}
+
+} // namespace sequoia::benchmarks
+
+// 替换全局 operator new / delete，仅用于统计分配次数
+void* operator new(std::size_t size) {
+    sequoia::benchmarks::g_alloc_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstdint>
+
+namespace sequoia::benchmarks {
+
+/**
+ * @brief 进程内累计的堆分配次数（alloc_counter.cc 替换了全局 operator new）
+ */
+[[nodiscard]] int64_t allocCount() noexcept;
+
+} // namespace sequoia::benchmarks
@@ -0,0 +1,272 @@
+#include <benchmark/benchmark.h>
+#include <sequoia/utils/any_to_string.h>
+#include <sequoia/utils/arithmetic.h>
+#include <sequoia/utils/decimal.h>
+#include <sequoia/utils/simd/cpu.h>
+
+#include <array>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace sequoia::utils;
+
+namespace {
+
+std::string makeBytes(int64_t size) {
+    std::string bytes(static_cast<size_t>(size), '\0');
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<char>(i * 131 + 7);
+    }
+    return bytes;
+}
+
+// 第二个参数为 SimdLevel，便于对比各指令集实现
+void applyLevel(benchmark::State& state) {
+    const auto level = simd::setMaxLevel(static_cast<simd::SimdLevel>(state.range(1)));
+    state.SetLabel(std::string(simd::levelName(level)));
+}
+
+void BM_ByteToHex(benchmark::State& state) {
+    applyLevel(state);
+    const std::string bytes = makeBytes(state.range(0));
+    std::vector<char> out(bytes.size() * 2);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(byteToHex(bytes, out));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void BM_HexToByte(benchmark::State& state) {
+    applyLevel(state);
+    const std::string hex = byteToHex(makeBytes(state.range(0)));
+    std::vector<char> out(hex.size() / 2);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(hexToByte(hex, out));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void hexArguments(benchmark::internal::Benchmark* bench) {
+    for (int64_t size : {32, 1024, 64 * 1024}) {
+        for (auto level : {simd::SimdLevel::Scalar, simd::SimdLevel::SSE2, simd::SimdLevel::AVX2}) {
+            bench->Args({size, static_cast<int64_t>(level)});
+        }
+    }
+}
+
+void BM_ToLower(benchmark::State& state) {
+    applyLevel(state);
+    std::string str(static_cast<size_t>(state.range(0)), 'A');
+    for (size_t i = 0; i < str.size(); i += 3) {
+        str[i] = 'x';
+    }
+    for (auto _ : state) {
+        toLower(str);
+        toUpper(str);
+        benchmark::DoNotOptimize(str.data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * 2);
+}
+
+// 模拟一行 TSV 记录，字段长度 8~16
+std::string makeRecord(int64_t fields) {
+    std::string record;
+    for (int64_t i = 0; i < fields; ++i) {
+        record.append(8 + static_cast<size_t>(i % 9), static_cast<char>('a' + i % 26));
+        record.push_back('\t');
+    }
+    return record;
+}
+
+void BM_Split_Vector(benchmark::State& state) {
+    applyLevel(state);
+    const std::string record = makeRecord(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(split(record, '\t').size());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(record.size()));
+}
+
+void BM_Split_View(benchmark::State& state) {
+    applyLevel(state);
+    const std::string record = makeRecord(state.range(0));
+    for (auto _ : state) {
+        size_t total = 0;
+        for (std::string_view field : split_view(record, '\t')) {
+            total += field.size();
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(record.size()));
+}
+
+void splitArguments(benchmark::internal::Benchmark* bench) {
+    for (int64_t fields : {8, 64, 1024}) {
+        for (auto level : {simd::SimdLevel::Scalar, simd::SimdLevel::AVX2}) {
+            bench->Args({fields, static_cast<int64_t>(level)});
+        }
+    }
+}
+
+std::vector<double> makePrices(int64_t count) {
+    std::vector<double> prices(static_cast<size_t>(count));
+    for (size_t i = 0; i < prices.size(); ++i) {
+        prices[i] = static_cast<double>(i % 100000) * 0.0137 + 0.005;
+    }
+    return prices;
+}
+
+// 逐个调用：每次都重新计算 scale
+void BM_RoundEx_PerValue(benchmark::State& state) {
+    const std::vector<double> prices = makePrices(state.range(0));
+    std::vector<double> out(prices.size());
+    for (auto _ : state) {
+        for (size_t i = 0; i < prices.size(); ++i) {
+            out[i] = roundEx(prices[i], 2);
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_RoundEx_Span(benchmark::State& state) {
+    applyLevel(state);
+    const std::vector<double> prices = makePrices(state.range(0));
+    std::vector<double> out(prices.size());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(roundEx(prices, out, 2));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_FloorEx_Span(benchmark::State& state) {
+    applyLevel(state);
+    const std::vector<double> prices = makePrices(state.range(0));
+    std::vector<double> out(prices.size());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(floorEx(prices, out, 2));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 运行时小数位数：编译器无法预知 ndigits，每次调用都要查表并判断正负
+void BM_RoundEx_RuntimeDigits(benchmark::State& state) {
+    const std::vector<double> prices = makePrices(state.range(0));
+    std::vector<double> out(prices.size());
+    int32_t ndigits = static_cast<int32_t>(state.range(1));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ndigits);
+        for (size_t i = 0; i < prices.size(); ++i) {
+            out[i] = roundEx(prices[i], ndigits);
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 编译期小数位数：scale 为常量，只剩乘法、舍入和除法
+template <int32_t NDigits>
+void BM_RoundEx_CompileTimeDigits(benchmark::State& state) {
+    const std::vector<double> prices = makePrices(state.range(0));
+    std::vector<double> out(prices.size());
+    for (auto _ : state) {
+        for (size_t i = 0; i < prices.size(); ++i) {
+            out[i] = roundEx<NDigits>(prices[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 十进制精确舍入：最短往返转换 + 整数舍入
+void BM_RoundExact_PerValue(benchmark::State& state) {
+    const std::vector<double> prices = makePrices(state.range(0));
+    std::vector<double> out(prices.size());
+    for (auto _ : state) {
+        for (size_t i = 0; i < prices.size(); ++i) {
+            out[i] = roundExact(prices[i], 2);
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 文本协议编码：std::to_string（定长 6 位小数、每次分配）与 format_number（最短往返、写入栈缓冲区）
+void BM_DoubleToString_StdToString(benchmark::State& state) {
+    const std::vector<double> prices = makePrices(state.range(0));
+    for (auto _ : state) {
+        for (const double price : prices) {
+            benchmark::DoNotOptimize(std::to_string(price));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_DoubleToString_FormatNumber(benchmark::State& state) {
+    const std::vector<double> prices = makePrices(state.range(0));
+    std::array<char, 64> buffer;
+    for (auto _ : state) {
+        for (const double price : prices) {
+            benchmark::DoNotOptimize(format_number(price, std::span<char>(buffer)));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+std::vector<std::string> makePriceTexts(int64_t count) {
+    std::vector<std::string> texts;
+    for (const double price : makePrices(count)) {
+        texts.push_back(format_number(price));
+    }
+    return texts;
+}
+
+void BM_StringToDouble_Stod(benchmark::State& state) {
+    const std::vector<std::string> texts = makePriceTexts(state.range(0));
+    for (auto _ : state) {
+        for (const auto& text : texts) {
+            benchmark::DoNotOptimize(std::stod(text));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_StringToDouble_ParseNumber(benchmark::State& state) {
+    const std::vector<std::string> texts = makePriceTexts(state.range(0));
+    for (auto _ : state) {
+        for (const auto& text : texts) {
+            benchmark::DoNotOptimize(parse_number<double>(text));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void roundArguments(benchmark::internal::Benchmark* bench) {
+    for (auto level : {simd::SimdLevel::Scalar, simd::SimdLevel::AVX2, simd::SimdLevel::AVX512}) {
+        bench->Args({1 << 20, static_cast<int64_t>(level)});
+    }
+}
+
+} // namespace
+
+BENCHMARK(BM_ByteToHex)->Apply(hexArguments);
+BENCHMARK(BM_HexToByte)->Apply(hexArguments);
+BENCHMARK(BM_ToLower)->Apply(hexArguments);
+BENCHMARK(BM_Split_Vector)->Apply(splitArguments);
+BENCHMARK(BM_Split_View)->Apply(splitArguments);
+BENCHMARK(BM_RoundEx_PerValue)->Arg(1 << 20);
+BENCHMARK(BM_RoundEx_RuntimeDigits)->Args({1 << 20, 2})->Args({1 << 20, 4});
+BENCHMARK_TEMPLATE(BM_RoundEx_CompileTimeDigits, 2)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_RoundEx_CompileTimeDigits, 4)->Arg(1 << 20);
+BENCHMARK(BM_RoundExact_PerValue)->Arg(1 << 20);
+BENCHMARK(BM_DoubleToString_StdToString)->Arg(1 << 16);
+BENCHMARK(BM_DoubleToString_FormatNumber)->Arg(1 << 16);
+BENCHMARK(BM_StringToDouble_Stod)->Arg(1 << 16);
+BENCHMARK(BM_StringToDouble_ParseNumber)->Arg(1 << 16);
+BENCHMARK(BM_RoundEx_Span)->Apply(roundArguments);
+BENCHMARK(BM_FloorEx_Span)->Apply(roundArguments);
+
+BENCHMARK_MAIN();
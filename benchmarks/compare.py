@@ -0,0 +1,108 @@
+#!/usr/bin/env python3
+"""对比两次 Google Benchmark JSON 结果，标出变慢的基准。
+
+用法：
+    compare.py BASELINE CURRENT [--threshold 0.10] [--metric cpu_time]
+
+BASELINE / CURRENT 可以是单个 JSON 文件（--benchmark_out 的输出），也可以是
+目录（按文件名配对，对应 CMake 的 benchmark_run 目标输出）。
+运行时使用了 --benchmark_repetitions 时取 median 聚合值，否则取单次结果。
+存在超过阈值的变慢时退出码为 1，便于接入 CI。
+"""
+
+import argparse
+import json
+import sys
+from pathlib import Path
+
+
+def load_results(path):
+    """读取一个结果文件，返回 {基准名: 耗时(ns)}。"""
+    with open(path, encoding="utf-8") as f:
+        data = json.load(f)
+
+    scale = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+    single, median = {}, {}
+    for bench in data.get("benchmarks", []):
+        if bench.get("error_occurred"):
+            continue
+        unit = scale.get(bench.get("time_unit", "ns"), 1.0)
+        name = bench.get("run_name", bench["name"])
+        if bench.get("run_type") == "aggregate":
+            if bench.get("aggregate_name") == "median":
+                median[name] = bench
+        else:
+            single.setdefault(name, bench)
+        bench["_scale"] = unit
+    # 有聚合值时以 median 为准
+    merged = dict(single)
+    merged.update(median)
+    return merged
+
+
+def collect(path):
+    """返回 {(文件名, 基准名): 结果}。"""
+    path = Path(path)
+    if not path.exists():
+        return {}
+    files = sorted(path.glob("*.json")) if path.is_dir() else [path]
+    results = {}
+    for file in files:
+        for name, bench in load_results(file).items():
+            results[(file.name, name)] = bench
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare Google Benchmark JSON results against a baseline.")
+    parser.add_argument("baseline", help="baseline JSON file or directory")
+    parser.add_argument("current", help="current JSON file or directory")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="relative slowdown reported as a regression (default: 0.10)")
+    parser.add_argument("--metric", choices=("cpu_time", "real_time"), default="cpu_time",
+                        help="time field to compare (default: cpu_time)")
+    args = parser.parse_args()
+
+    baseline = collect(args.baseline)
+    current = collect(args.current)
+    if not baseline:
+        print(f"no benchmark results in {args.baseline}", file=sys.stderr)
+        return 2
+
+    # 单文件对比时忽略文件名
+    if Path(args.baseline).is_file() and Path(args.current).is_file():
+        baseline = {("", name): bench for (_, name), bench in baseline.items()}
+        current = {("", name): bench for (_, name), bench in current.items()}
+
+    regressions = 0
+    width = max(len(name) for _, name in baseline) + 2
+    print(f"{'benchmark':<{width}} {'baseline':>14} {'current':>14} {'change':>9}")
+    for key in sorted(baseline):
+        _, name = key
+        old = baseline[key]
+        new = current.get(key)
+        old_time = old[args.metric] * old["_scale"]
+        if new is None:
+            print(f"{name:<{width}} {old_time:>12.1f}ns {'missing':>14}")
+            continue
+        new_time = new[args.metric] * new["_scale"]
+        change = (new_time - old_time) / old_time if old_time > 0 else 0.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  REGRESSION"
+            regressions += 1
+        elif change < -args.threshold:
+            flag = "  improved"
+        print(f"{name:<{width}} {old_time:>12.1f}ns {new_time:>12.1f}ns {change:>+8.1%}{flag}")
+
+    for key in sorted(current.keys() - baseline.keys()):
+        print(f"{key[1]:<{width}} {'new':>14}")
+
+    if regressions:
+        print(f"\n{regressions} benchmark(s) slower than baseline by more than {args.threshold:.0%}")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,53 @@
+#include <benchmark/benchmark.h>
+#include <sequoia/utils/arithmetic.h>
+#include <sequoia/utils/csv.h>
+#include <sequoia/utils/simd/cpu.h>
+
+#include <string>
+
+using namespace sequoia::utils;
+
+namespace {
+
+// 每行 8 个字段，其中一个为带引号的字段
+std::string makeCsv(int64_t lines) {
+    std::string data;
+    for (int64_t i = 0; i < lines; ++i) {
+        data += std::to_string(i) + ",alpha,beta,\"gamma, delta\",12.5,0.001,some_longer_text_field,z\n";
+    }
+    return data;
+}
+
+void BM_Csv_SplitPerLine(benchmark::State& state) {
+    const std::string data = makeCsv(state.range(0));
+    for (auto _ : state) {
+        size_t fields = 0;
+        for (std::string_view line : split_view(data, '\n')) {
+            fields += split(line, ',').size();
+        }
+        benchmark::DoNotOptimize(fields);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(data.size()));
+}
+
+void BM_Csv_Tokenizer(benchmark::State& state) {
+    const auto level = simd::setMaxLevel(static_cast<simd::SimdLevel>(state.range(1)));
+    state.SetLabel(std::string(simd::levelName(level)));
+    const std::string data = makeCsv(state.range(0));
+    const CsvTokenizer tokenizer;
+    CsvIndex index;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tokenizer.tokenize(data, index));
+        benchmark::DoNotOptimize(index.field_count());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(data.size()));
+}
+
+} // namespace
+
+// 注意：split 版本不处理引号，仅作为分配开销的对照
+BENCHMARK(BM_Csv_SplitPerLine)->Arg(10000);
+BENCHMARK(BM_Csv_Tokenizer)->Args({10000, static_cast<int64_t>(simd::SimdLevel::Scalar)});
+BENCHMARK(BM_Csv_Tokenizer)->Args({10000, static_cast<int64_t>(simd::SimdLevel::AVX2)});
+
+BENCHMARK_MAIN();
@@ -0,0 +1,127 @@
+#include <benchmark/benchmark.h>
+#include <sequoia/utils/encoding.h>
+#include <sequoia/utils/simd/cpu.h>
+
+#include <string>
+#include <vector>
+
+using namespace sequoia::utils;
+
+namespace {
+
+std::string makeUtf8(int64_t repeat) {
+    std::string str;
+    for (int64_t i = 0; i < repeat; ++i) {
+        str += "订单ab";
+    }
+    return str;
+}
+
+void BM_Utf8ToGbk(benchmark::State& state) {
+    const std::string utf8 = makeUtf8(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(utf8_to_gbk(utf8));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(utf8.size()));
+}
+
+// 以 ASCII 为主的数据：每 64 字节中夹一个中文字符
+std::string makeMostlyAscii(int64_t size) {
+    std::string str;
+    while (static_cast<int64_t>(str.size()) < size) {
+        str += std::string(61, 'x') + "中";
+    }
+    return str;
+}
+
+void BM_GbkToUtf8_MostlyAscii_Iconv(benchmark::State& state) {
+    const std::string gbk = utf8_to_gbk(makeMostlyAscii(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(convert_encoding(gbk, "UTF-8", "GBK"));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(gbk.size()));
+}
+
+void BM_GbkToUtf8_MostlyAscii_Native(benchmark::State& state) {
+    const std::string gbk = utf8_to_gbk(makeMostlyAscii(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(gbk_to_utf8(gbk));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(gbk.size()));
+}
+
+void BM_Utf8ToGbk_Iconv(benchmark::State& state) {
+    const std::string utf8 = makeUtf8(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(convert_encoding(utf8, "GBK", "UTF-8"));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(utf8.size()));
+}
+
+void BM_Utf8ToGbk_Buffer(benchmark::State& state) {
+    const std::string utf8 = makeUtf8(state.range(0));
+    std::vector<char> out(utf8.size());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(utf8_to_gbk(utf8, out));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(utf8.size()));
+}
+
+void BM_GbkToUtf8_Streaming(benchmark::State& state) {
+    const std::string gbk = utf8_to_gbk(makeUtf8(state.range(0)));
+    constexpr size_t kChunkSize = 4096;
+    StreamingConverter converter("UTF-8", "GBK");
+    std::string out;
+    for (auto _ : state) {
+        out.clear();
+        converter.reset();
+        for (size_t pos = 0; pos < gbk.size(); pos += kChunkSize) {
+            converter.convert(std::string_view(gbk).substr(pos, kChunkSize), out);
+        }
+        converter.finish(out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(gbk.size()));
+}
+
+// 第二个参数为 SimdLevel
+void BM_IsValidUtf8(benchmark::State& state) {
+    const auto level = simd::setMaxLevel(static_cast<simd::SimdLevel>(state.range(1)));
+    state.SetLabel(std::string(simd::levelName(level)));
+    const std::string utf8 = makeUtf8(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(is_valid_utf8(utf8));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(utf8.size()));
+}
+
+// 此前只能尝试转换为 GBK 来判断是否合法
+void BM_IsValidUtf8_ViaGbk(benchmark::State& state) {
+    const std::string utf8 = makeUtf8(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(convert_encoding(utf8, "GBK", "UTF-8").has_value());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(utf8.size()));
+}
+
+void BM_Utf8DisplayWidth(benchmark::State& state) {
+    const std::string utf8 = makeMostlyAscii(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(utf8_display_width(utf8));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(utf8.size()));
+}
+
+} // namespace
+
+BENCHMARK(BM_Utf8ToGbk)->Arg(2)->Arg(64)->Arg(4096);
+BENCHMARK(BM_Utf8ToGbk_Iconv)->Arg(2)->Arg(64)->Arg(4096);
+BENCHMARK(BM_Utf8ToGbk_Buffer)->Arg(2)->Arg(64)->Arg(4096);
+BENCHMARK(BM_GbkToUtf8_MostlyAscii_Iconv)->Arg(64 * 1024);
+BENCHMARK(BM_GbkToUtf8_MostlyAscii_Native)->Arg(64 * 1024);
+BENCHMARK(BM_GbkToUtf8_Streaming)->Arg(64 * 1024);
+BENCHMARK(BM_IsValidUtf8)->Args({8192, 0})->Args({8192, 2});
+BENCHMARK(BM_IsValidUtf8_ViaGbk)->Arg(8192);
+BENCHMARK(BM_Utf8DisplayWidth)->Arg(64 * 1024);
+
+BENCHMARK_MAIN();
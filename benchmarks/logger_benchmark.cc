@@ -0,0 +1,64 @@
+#include <benchmark/benchmark.h>
+#include <sequoia/utils/log/logger.h>
+
+#include <spdlog/async.h>
+#include <spdlog/sinks/null_sink.h>
+
+#include <string>
+
+using namespace sequoia::utils::log;
+
+namespace {
+
+// 与生产配置相同的异步 logger，但输出到 null sink，计时不受终端 I/O 影响。
+// Logger 构造时先按 section 查找已注册的 spdlog logger，因此预先注册同名实例即可替换
+Logger& benchLogger() {
+    static const LoggerPtr logger = [] {
+        spdlog::init_thread_pool(8192, 1);
+        auto sink = std::make_shared<spdlog::sinks::null_sink_mt>();
+        auto internal = std::make_shared<spdlog::async_logger>(
+            "SEQUOIA", sink, spdlog::thread_pool(), spdlog::async_overflow_policy::block);
+        internal->set_level(spdlog::level::level_enum::info);
+        spdlog::register_logger(internal);
+        return Logger::defaultLogger();
+    }();
+    return *logger;
+}
+
+// LOG_* 宏每次调用都会取默认 logger
+void BM_Logger_DefaultLogger(benchmark::State& state) {
+    (void)benchLogger();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Logger::defaultLogger());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// 低于当前级别的日志：只有级别判断
+void BM_Logger_Filtered(benchmark::State& state) {
+    Logger& logger = benchLogger();
+    int64_t i = 0;
+    for (auto _ : state) {
+        logger.debug("order {} price {}", ++i, 12.5);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// 输出的日志：格式化并投递到异步队列，多线程时竞争同一队列
+void BM_Logger_Enabled(benchmark::State& state) {
+    Logger& logger = benchLogger();
+    const std::string text(static_cast<size_t>(state.range(0)), 'x');
+    int64_t i = 0;
+    for (auto _ : state) {
+        logger.info("order {} price {} {}", ++i, 12.5, text);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+BENCHMARK(BM_Logger_DefaultLogger)->ThreadRange(1, 8);
+BENCHMARK(BM_Logger_Filtered)->ThreadRange(1, 8);
+BENCHMARK(BM_Logger_Enabled)->Arg(16)->Arg(256)->ThreadRange(1, 8);
+
+BENCHMARK_MAIN();
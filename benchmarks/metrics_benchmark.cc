@@ -0,0 +1,68 @@
+#include <benchmark/benchmark.h>
+#include <sequoia/utils/metrics/metrics.h>
+
+#include <atomic>
+
+using namespace sequoia::utils;
+using namespace sequoia::utils::metrics;
+
+namespace {
+
+// 基线：所有线程共享同一个原子变量
+void BM_SharedAtomic_Inc(benchmark::State& state) {
+    alignas(64) static std::atomic<uint64_t> value{0};
+    for (auto _ : state) {
+        value.fetch_add(1, std::memory_order_relaxed);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_Counter_Inc(benchmark::State& state) {
+    static Counter* counter = MetricsRegistry::instance().counter("benchmark_counter_total");
+    for (auto _ : state) {
+        counter->inc();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_Gauge_Add(benchmark::State& state) {
+    static Gauge* gauge = MetricsRegistry::instance().gauge("benchmark_gauge");
+    for (auto _ : state) {
+        gauge->add(1.0);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_Summary_Observe(benchmark::State& state) {
+    static Summary* summary = MetricsRegistry::instance().summary("benchmark_latency_ns");
+    uint64_t value = 1;
+    for (auto _ : state) {
+        summary->observe(value);
+        value = value * 7 % 1'000'003;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// 导出含 state.range(0) 个带标签计数器的注册表
+void BM_Registry_Expose(benchmark::State& state) {
+    MetricsRegistry registry;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        Params labels;
+        labels.set("id", i);
+        registry.counter("benchmark_orders_total", labels)->inc(static_cast<uint64_t>(i));
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(registry.expose());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+BENCHMARK(BM_SharedAtomic_Inc)->ThreadRange(1, 8);
+BENCHMARK(BM_Counter_Inc)->ThreadRange(1, 8);
+BENCHMARK(BM_Gauge_Add)->ThreadRange(1, 8);
+BENCHMARK(BM_Summary_Observe)->ThreadRange(1, 8);
+BENCHMARK(BM_Registry_Expose)->Arg(16)->Arg(1024);
+
+BENCHMARK_MAIN();
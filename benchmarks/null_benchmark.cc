@@ -0,0 +1,148 @@
+#include <benchmark/benchmark.h>
+#include <sequoia/utils/nullable_column.h>
+#include <sequoia/utils/simd/cpu.h>
+
+#include <string>
+#include <vector>
+
+using namespace sequoia::utils;
+
+namespace {
+
+// 第二个参数为 SimdLevel，便于对比各指令集实现
+void applyLevel(benchmark::State& state) {
+    const auto level = simd::setMaxLevel(static_cast<simd::SimdLevel>(state.range(1)));
+    state.SetLabel(std::string(simd::levelName(level)));
+}
+
+// 约 1/8 的元素为 NaN 哨兵
+std::vector<double> makeSentinelPrices(int64_t count) {
+    std::vector<double> prices(static_cast<size_t>(count));
+    for (size_t i = 0; i < prices.size(); ++i) {
+        prices[i] = (i * 2654435761u) % 8 == 0 ? static_cast<double>(Null<double>())
+                                               : static_cast<double>(i % 1000) * 0.01;
+    }
+    return prices;
+}
+
+// 原有做法：逐个检查哨兵再累加
+void BM_SentinelSum_PerValue(benchmark::State& state) {
+    const auto prices = makeSentinelPrices(state.range(0));
+    for (auto _ : state) {
+        double sum = 0;
+        for (const double price : prices) {
+            if (!(price == Null<double>())) {
+                sum += price;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_NullableColumn_Sum(benchmark::State& state) {
+    applyLevel(state);
+    const auto column = NullableColumn<double>::from_sentinel(makeSentinelPrices(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(column.sum());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_NullableColumn_Min(benchmark::State& state) {
+    applyLevel(state);
+    const auto column = NullableColumn<double>::from_sentinel(makeSentinelPrices(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(column.min());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_NullableColumn_FromSentinel(benchmark::State& state) {
+    applyLevel(state);
+    const auto prices = makeSentinelPrices(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(NullableColumn<double>::from_sentinel(prices));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_NullableColumn_FillNull(benchmark::State& state) {
+    applyLevel(state);
+    const auto column = NullableColumn<double>::from_sentinel(makeSentinelPrices(state.range(0)));
+    std::vector<double> out(column.size());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(column.fill_null(0.0, out));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_CountNull(benchmark::State& state) {
+    applyLevel(state);
+    const auto prices = makeSentinelPrices(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(count_null<double>(prices));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 只有最后一个元素为 null：扫描整个数组
+void BM_FindFirstNull(benchmark::State& state) {
+    applyLevel(state);
+    std::vector<double> prices(static_cast<size_t>(state.range(0)), 1.0);
+    prices.back() = Null<double>();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(find_first_null<double>(prices));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_CompactNonNull(benchmark::State& state) {
+    applyLevel(state);
+    const auto prices = makeSentinelPrices(state.range(0));
+    std::vector<double> out(prices.size());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(compact_non_null<double>(prices, out));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_ReplaceNull(benchmark::State& state) {
+    applyLevel(state);
+    const auto prices = makeSentinelPrices(state.range(0));
+    std::vector<double> work(prices.size());
+    for (auto _ : state) {
+        state.PauseTiming();
+        work = prices;
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(replace_null<double>(work, 0.0));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void levelArguments(benchmark::internal::Benchmark* bench) {
+    for (auto level : {simd::SimdLevel::Scalar, simd::SimdLevel::AVX2, simd::SimdLevel::AVX512}) {
+        bench->Args({1 << 16, static_cast<int64_t>(level)});
+    }
+}
+
+// 哨兵内核只有 AVX2 实现
+void sentinelArguments(benchmark::internal::Benchmark* bench) {
+    for (auto level : {simd::SimdLevel::Scalar, simd::SimdLevel::AVX2}) {
+        bench->Args({1 << 16, static_cast<int64_t>(level)});
+    }
+}
+
+} // namespace
+
+BENCHMARK(BM_SentinelSum_PerValue)->Arg(1 << 16);
+BENCHMARK(BM_CountNull)->Apply(sentinelArguments);
+BENCHMARK(BM_FindFirstNull)->Apply(sentinelArguments);
+BENCHMARK(BM_CompactNonNull)->Apply(sentinelArguments);
+BENCHMARK(BM_ReplaceNull)->Apply(sentinelArguments);
+BENCHMARK(BM_NullableColumn_Sum)->Apply(levelArguments);
+BENCHMARK(BM_NullableColumn_Min)->Apply(levelArguments);
+BENCHMARK(BM_NullableColumn_FromSentinel)->Apply(levelArguments);
+BENCHMARK(BM_NullableColumn_FillNull)->Apply(levelArguments);
+
+BENCHMARK_MAIN();
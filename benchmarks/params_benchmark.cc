@@ -0,0 +1,138 @@
+#include <benchmark/benchmark.h>
+#include <sequoia/utils/any_converter.h>
+#include <sequoia/utils/arena_params.h>
+#include "alloc_counter.h"
+#include "perf_counters.h"
+
+#include <any>
+#include <array>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+using namespace sequoia::utils;
+
+namespace {
+
+// 模拟单次请求的参数集：短字符串键，混合标量与短字符串值
+std::vector<std::string> makeKeys(int64_t count) {
+    std::vector<std::string> keys;
+    keys.reserve(count);
+    for (int64_t i = 0; i < count; ++i) {
+        keys.push_back("request_param_" + std::to_string(i));
+    }
+    return keys;
+}
+
+template <typename ParamsType>
+void fillParams(ParamsType& params, const std::vector<std::string>& keys) {
+    for (size_t i = 0; i < keys.size(); ++i) {
+        switch (i % 3) {
+            case 0: params.set(keys[i], static_cast<int>(i)); break;
+            case 1: params.set(keys[i], static_cast<double>(i) * 0.5); break;
+            default: params.set(keys[i], "value"); break;
+        }
+    }
+}
+
+void reportAllocations(benchmark::State& state, int64_t allocs_before) {
+    state.counters["allocs"] = benchmark::Counter(
+        static_cast<double>(sequoia::benchmarks::allocCount() - allocs_before),
+        benchmark::Counter::kAvgIterations);
+}
+
+void BM_Params_Build(benchmark::State& state) {
+    const auto keys = makeKeys(state.range(0));
+    const int64_t allocs_before = sequoia::benchmarks::allocCount();
+    const auto perf_before = sequoia::benchmarks::perfSnapshot();
+    for (auto _ : state) {
+        Params params;
+        fillParams(params, keys);
+        benchmark::DoNotOptimize(params.size());
+    }
+    reportAllocations(state, allocs_before);
+    sequoia::benchmarks::reportPerfCounters(state, perf_before);
+}
+
+void BM_ArenaParams_Build(benchmark::State& state) {
+    const auto keys = makeKeys(state.range(0));
+    alignas(std::max_align_t) std::array<std::byte, 64 * 1024> buffer{};
+    const int64_t allocs_before = sequoia::benchmarks::allocCount();
+    const auto perf_before = sequoia::benchmarks::perfSnapshot();
+    for (auto _ : state) {
+        ArenaParams params(buffer.data(), buffer.size());
+        fillParams(params, keys);
+        benchmark::DoNotOptimize(params.size());
+    }
+    reportAllocations(state, allocs_before);
+    sequoia::benchmarks::reportPerfCounters(state, perf_before);
+}
+
+void BM_ArenaParams_ToParams(benchmark::State& state) {
+    const auto keys = makeKeys(state.range(0));
+    alignas(std::max_align_t) std::array<std::byte, 64 * 1024> buffer{};
+    ArenaParams params(buffer.data(), buffer.size());
+    fillParams(params, keys);
+    const int64_t allocs_before = sequoia::benchmarks::allocCount();
+    for (auto _ : state) {
+        Params heap_params = params.to_params();
+        benchmark::DoNotOptimize(heap_params);
+    }
+    reportAllocations(state, allocs_before);
+}
+
+// 通用序列化器的原有做法：按顺序尝试 any_cast，类型不符时捕获 std::bad_any_cast
+std::vector<std::any> makeAnyValues(int64_t count) {
+    std::vector<std::any> values;
+    values.reserve(count);
+    for (int64_t i = 0; i < count; ++i) {
+        switch (i % 3) {
+            case 0: values.emplace_back(static_cast<int>(i)); break;
+            case 1: values.emplace_back(static_cast<double>(i) * 0.5); break;
+            default: values.emplace_back(std::string("value")); break;
+        }
+    }
+    return values;
+}
+
+std::string castChainToString(const std::any& value) {
+    try {
+        return any_to_string<int>(value);
+    } catch (const std::bad_any_cast&) {
+    }
+    try {
+        return any_to_string<double>(value);
+    } catch (const std::bad_any_cast&) {
+    }
+    return any_to_string<std::string>(value);
+}
+
+void BM_AnyToString_CastChain(benchmark::State& state) {
+    const auto values = makeAnyValues(state.range(0));
+    for (auto _ : state) {
+        for (const auto& value : values) {
+            benchmark::DoNotOptimize(castChainToString(value));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_AnyToString_Registry(benchmark::State& state) {
+    const auto values = makeAnyValues(state.range(0));
+    std::vector<std::string> out(values.size());
+    const auto& registry = ConverterRegistry::instance();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(registry.to_strings(values, out));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+BENCHMARK(BM_AnyToString_CastChain)->Arg(128);
+BENCHMARK(BM_AnyToString_Registry)->Arg(128);
+BENCHMARK(BM_Params_Build)->RangeMultiplier(4)->Range(8, 128);
+BENCHMARK(BM_ArenaParams_Build)->RangeMultiplier(4)->Range(8, 128);
+BENCHMARK(BM_ArenaParams_ToParams)->RangeMultiplier(4)->Range(8, 128);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <sequoia/utils/trace/perf_counter.h>
+
+namespace sequoia::benchmarks {
+
+/**
+ * @brief 当前线程的硬件计数（计数器不可用时为全 0）
+ */
+[[nodiscard]] inline utils::trace::PerfSample perfSnapshot() noexcept {
+    utils::trace::PerfSample sample;
+    (void)utils::trace::PerfCounters::current().read(sample);
+    return sample;
+}
+
+/**
+ * @brief 将 before 以来的硬件计数按迭代平均写入 state.counters，并给出 IPC 与 MPKI
+ *
+ * @details 计数器不可用（无 PMU 或权限不足）时不输出，基准本身照常运行
+ */
+inline void reportPerfCounters(benchmark::State& state, const utils::trace::PerfSample& before) {
+    if (!utils::trace::PerfCounters::current().available()) {
+        return;
+    }
+    const utils::trace::PerfSample delta = perfSnapshot() - before;
+    state.counters["cycles"] = benchmark::Counter(static_cast<double>(delta.cycles), benchmark::Counter::kAvgIterations);
+    state.counters["instructions"] =
+        benchmark::Counter(static_cast<double>(delta.instructions), benchmark::Counter::kAvgIterations);
+    state.counters["IPC"] = delta.ipc();
+    state.counters["cache_MPKI"] = delta.cache_mpki();
+    state.counters["branch_MPKI"] = delta.branch_mpki();
+}
+
+} // namespace sequoia::benchmarks
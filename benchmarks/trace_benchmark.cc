@@ -0,0 +1,92 @@
+#include <benchmark/benchmark.h>
+#include <sequoia/utils/trace/category.h>
+#include <sequoia/utils/trace/chrome_trace.h>
+#include <sequoia/utils/trace/profiler.h>
+
+using namespace sequoia::utils::trace;
+
+namespace {
+
+constexpr ZoneSite kProfilerSite{"benchmark::profiler", std::source_location::current()};
+constexpr ZoneSite kChromeSite{"benchmark::chrome", std::source_location::current()};
+
+// 基线：只读两次 TSC
+void BM_Zone_ReadTicks(benchmark::State& state) {
+    for (auto _ : state) {
+        const uint64_t start = detail::read_ticks();
+        benchmark::DoNotOptimize(detail::read_ticks() - start);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// 进程内分析器的一个 zone；缓冲接近写满前汇总一次（不计时）
+void BM_Zone_Profiler(benchmark::State& state) {
+    auto& profiler = Profiler::instance();
+    size_t recorded = 0;
+    for (auto _ : state) {
+        {
+            const ScopedZone zone(&kProfilerSite);
+        }
+        if (++recorded == detail::ThreadBuffer::kCapacity / 2) {
+            state.PauseTiming();
+            profiler.collect();
+            recorded = 0;
+            state.ResumeTiming();
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    profiler.reset();
+}
+
+// Chrome trace 的一个 zone：环写满后覆盖，无需汇总
+void BM_Zone_Chrome(benchmark::State& state) {
+    for (auto _ : state) {
+        const ChromeScopedZone zone(&kChromeSite);
+    }
+    state.SetItemsProcessed(state.iterations());
+    (void)ChromeTrace::instance().flush();
+}
+
+void BM_Zone_ChromeDisabled(benchmark::State& state) {
+    ChromeTrace::set_enabled(false);
+    for (auto _ : state) {
+        const ChromeScopedZone zone(&kChromeSite);
+    }
+    ChromeTrace::set_enabled(true);
+    state.SetItemsProcessed(state.iterations());
+}
+
+// 类别关闭时的按类别 zone：一次掩码读取
+void BM_Zone_CategoryDisabled(benchmark::State& state) {
+    const uint64_t bit = category_bit("benchmark");
+    disable_category("benchmark");
+    for (auto _ : state) {
+        const ChromeScopedZone zone(&kChromeSite, category_enabled(bit));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// 导出一个写满的事件环
+void BM_Chrome_Flush(benchmark::State& state) {
+    auto& trace = ChromeTrace::instance();
+    for (auto _ : state) {
+        state.PauseTiming();
+        for (size_t i = 0; i < detail::EventRing::kCapacity; ++i) {
+            ChromeTrace::record(&kChromeSite, origin_ticks() + i, origin_ticks() + i + 10);
+        }
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(trace.flush());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(detail::EventRing::kCapacity - 1));
+}
+
+} // namespace
+
+BENCHMARK(BM_Zone_ReadTicks);
+BENCHMARK(BM_Zone_Profiler);
+BENCHMARK(BM_Zone_Chrome);
+BENCHMARK(BM_Zone_ChromeDisabled);
+BENCHMARK(BM_Zone_CategoryDisabled);
+BENCHMARK(BM_Chrome_Flush);
+
+BENCHMARK_MAIN();
@@ -18,6 +18,7 @@ class Project(ConanFile):
         self.requires("doctest/2.4.11")
         self.requires("odb/2.5.0")
         self.requires("tracy/0.11.1")
+        self.requires("benchmark/1.8.3")
 
     def build_requirements(self):
         super().build_requirements()
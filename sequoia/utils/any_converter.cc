@@ -0,0 +1,103 @@
+#include "any_converter.h"
+#include "params.h"
+
+namespace sequoia::utils {
+
+ConverterRegistry::ConverterRegistry() {
+    // Params 支持的类型由 detail::find_param_converter 提供，这里只注册其余数值类型
+    register_type<int8_t>("int8");
+    register_type<uint8_t>("uint8");
+    register_type<int16_t>("int16");
+    register_type<uint16_t>("uint16");
+    register_type<uint32_t>("uint32");
+    register_type<uint64_t>("uint64");
+    register_type<float>("float");
+    register_type<long double>("long double");
+}
+
+ConverterRegistry& ConverterRegistry::instance() {
+    static ConverterRegistry registry;
+    return registry;
+}
+
+bool ConverterRegistry::insert(std::type_index type, const AnyConverter& converter) {
+    // Params 支持的类型名称与格式需与 Params 保持一致，不可覆盖
+    if (detail::find_param_converter(type) != nullptr) {
+        return false;
+    }
+    const std::unique_lock<std::shared_mutex> guard(mutex_);
+    auto it = converters_.find(type);
+    const AnyConverter* stored = &storage_.emplace_back(converter);
+    if (it == converters_.end()) {
+        converters_.emplace(type, stored);
+    } else {
+        it->second = stored;
+    }
+    return true;
+}
+
+const AnyConverter* ConverterRegistry::find(std::type_index type) const noexcept {
+    if (const AnyConverter* converter = detail::find_param_converter(type); converter != nullptr) {
+        return converter;
+    }
+    const std::shared_lock<std::shared_mutex> guard(mutex_);
+    auto it = converters_.find(type);
+    return it == converters_.end() ? nullptr : it->second;
+}
+
+std::optional<std::string> ConverterRegistry::to_string(const std::any& value) const {
+    const AnyConverter* converter = find(value);
+    if (converter == nullptr) {
+        return std::nullopt;
+    }
+    std::string result;
+    converter->append(result, value);
+    return result;
+}
+
+std::any ConverterRegistry::from_string(std::type_index type, std::string_view str) const {
+    const AnyConverter* converter = find(type);
+    if (converter == nullptr) {
+        return {};
+    }
+    return converter->parse(str);
+}
+
+size_t ConverterRegistry::to_strings(std::span<const std::any> values, std::span<std::string> out) const {
+    if (out.size() < values.size()) {
+        return 0;
+    }
+    size_t converted = 0;
+    const std::type_info* last_type = nullptr;
+    const AnyConverter* converter = nullptr;
+    for (size_t i = 0; i < values.size(); ++i) {
+        // 同一类型的 type_info 通常是同一个对象，地址相同即可跳过哈希查找
+        const std::type_info& type = values[i].type();
+        if (&type != last_type) {
+            last_type = &type;
+            converter = find(type);
+        }
+        out[i].clear();
+        if (converter != nullptr) {
+            converter->append(out[i], values[i]);
+            ++converted;
+        }
+    }
+    return converted;
+}
+
+size_t ConverterRegistry::from_strings(std::type_index type, std::span<const std::string_view> texts,
+                                       std::span<std::any> out) const {
+    const AnyConverter* converter = find(type);
+    if (converter == nullptr || out.size() < texts.size()) {
+        return 0;
+    }
+    size_t converted = 0;
+    for (size_t i = 0; i < texts.size(); ++i) {
+        out[i] = converter->parse(texts[i]);
+        converted += out[i].has_value() ? 1 : 0;
+    }
+    return converted;
+}
+
+} // namespace sequoia::utils
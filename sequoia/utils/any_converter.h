@@ -0,0 +1,107 @@
+#pragma once
+
+#include <any>
+#include <deque>
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <sequoia/utils/any_to_string.h>
+
+namespace sequoia::utils {
+
+/**
+ * @brief 按 std::type_index 查找转换函数的注册表
+ *
+ * @details
+ * 1. 一次哈希查找即可得到 std::any 的转换函数，无需调用方知道静态类型，也不会在 any_cast 失败时抛异常
+ * 2. Params 支持的类型直接读取 Params 的内置类型表（不可变，查找无需加锁），不可覆盖；
+ *    另内置其余整数与浮点类型
+ * 3. 自定义类型的查找与注册由读写锁保护，可并发调用；返回的转换函数指针在进程生命周期内有效
+ *
+ * @code
+ * auto& registry = ConverterRegistry::instance();
+ * registry.register_type<Price>("price");             // Price 提供 to_string() 与 from_string()
+ * auto text = registry.to_string(std::any(Price{}));  // std::optional<std::string>
+ * @endcode
+ */
+class ConverterRegistry {
+public:
+    [[nodiscard]] static ConverterRegistry& instance();
+
+    ConverterRegistry(const ConverterRegistry&) = delete;
+    ConverterRegistry& operator=(const ConverterRegistry&) = delete;
+
+    /**
+     * @brief 注册类型，转换规则同 any_to_string<ValueType> / string_to_any<ValueType>
+     *
+     * @param name 类型名称，需为静态存储期的字符串
+     * @details 已注册的自定义类型会被覆盖
+     * @return bool ValueType 为 Params 支持的类型（bool、int、double 等）时不覆盖，返回 false
+     */
+    template <typename ValueType>
+    bool register_type(std::string_view name) {
+        return insert(typeid(ValueType), make_any_converter<ValueType>(name));
+    }
+
+    [[nodiscard]] const AnyConverter* find(std::type_index type) const noexcept;
+
+    [[nodiscard]] const AnyConverter* find(const std::any& value) const noexcept {
+        return find(value.type());
+    }
+
+    template <typename ValueType>
+    [[nodiscard]] const AnyConverter* find() const noexcept {
+        return find(typeid(ValueType));
+    }
+
+    /**
+     * @brief 转换为文本
+     *
+     * @return std::optional<std::string> 值为空或类型未注册时返回 std::nullopt
+     */
+    [[nodiscard]] std::optional<std::string> to_string(const std::any& value) const;
+
+    /**
+     * @brief 解析为 type 类型的值
+     *
+     * @return std::any 类型未注册或格式错误时返回空值
+     */
+    [[nodiscard]] std::any from_string(std::type_index type, std::string_view str) const;
+
+    /**
+     * @brief 批量转换为文本，相邻元素类型相同时复用上一次查找的结果
+     *
+     * @param values 待转换的值
+     * @param out 输出，长度至少为 values.size()，无法转换的元素输出空字符串
+     * @return size_t 成功转换的个数，输出不足时返回 0 且不写入
+     */
+    size_t to_strings(std::span<const std::any> values, std::span<std::string> out) const;
+
+    /**
+     * @brief 批量解析为同一类型的值（只查找一次转换函数）
+     *
+     * @param out 输出，长度至少为 texts.size()，解析失败的元素输出空值
+     * @return size_t 成功解析的个数，类型未注册或输出不足时返回 0 且不写入
+     */
+    size_t from_strings(std::type_index type, std::span<const std::string_view> texts,
+                        std::span<std::any> out) const;
+
+private:
+    ConverterRegistry();
+
+    bool insert(std::type_index type, const AnyConverter& converter);
+
+private:
+    mutable std::shared_mutex mutex_;
+    // 仅保存非 Params 内置的类型，Params 支持的类型由 detail::find_param_converter 查找
+    std::unordered_map<std::type_index, const AnyConverter*> converters_;
+    // 转换函数只追加不释放：覆盖注册后，其他线程此前取得的指针仍然有效
+    std::deque<AnyConverter> storage_;
+};
+
+} // namespace sequoia::utils
@@ -1,53 +1,187 @@
 #pragma once
 
+#include <algorithm>
 #include <any>
+#include <array>
+#include <charconv>
+#include <concepts>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
 #include <type_traits>
 
 namespace sequoia::utils {
 
+namespace detail {
+
+template <typename T>
+struct is_arithmetic_vector : std::false_type {};
+
+template <typename T, typename Alloc>
+struct is_arithmetic_vector<std::vector<T, Alloc>> : std::is_arithmetic<T> {};
+
+template <typename T>
+inline constexpr bool is_arithmetic_vector_v = is_arithmetic_vector<T>::value;
+
+// std::to_chars 输出一个数值所需的缓冲区大小（long double 最短往返表示也不超过该长度）
+inline constexpr size_t kMaxNumberChars = 64;
+
+// 去除首尾 ASCII 空白
+[[nodiscard]] constexpr std::string_view trim_number(std::string_view str) noexcept {
+    constexpr std::string_view whitespace = " \t\n\r";
+    const size_t begin = str.find_first_not_of(whitespace);
+    if (begin == std::string_view::npos) {
+        return {};
+    }
+    return str.substr(begin, str.find_last_not_of(whitespace) + 1 - begin);
+}
+
+template <typename T>
+concept HasFromString = requires(const std::string& str) {
+    { T::from_string(str) } -> std::convertible_to<T>;
+};
+
+} // namespace detail
+
 /**
- * 针对数值类型的转换：使用 std::to_string
+ * @brief 数值格式化到调用方缓冲区（不分配内存，与 locale 无关）
+ * 
+ * @param value 数值
+ * @param out 输出缓冲区，kMaxNumberChars 字节总是足够
+ * @return size_t 写入的字符数，缓冲区不足时返回 0
+ * 
+ * @details
+ * 1. 整数按十进制输出，bool 输出 "1"/"0"
+ * 2. 浮点数使用 std::to_chars 的最短往返表示：3.14 输出 "3.14"，解析回来与原值逐位相同
+ */
+template <typename ValueType>
+    requires std::is_arithmetic_v<ValueType>
+[[nodiscard]] size_t format_number(ValueType value, std::span<char> out) noexcept {
+    char* const first = out.data();
+    char* const last = out.data() + out.size();
+    std::to_chars_result result;
+    if constexpr (std::is_same_v<ValueType, bool>) {
+        result = std::to_chars(first, last, static_cast<int>(value));
+    } else {
+        result = std::to_chars(first, last, value);
+    }
+    if (result.ec != std::errc{}) {
+        return 0;
+    }
+    return static_cast<size_t>(result.ptr - first);
+}
+
+/**
+ * @brief 数值格式化为字符串，格式同 format_number(value, out)
+ */
+template <typename ValueType>
+    requires std::is_arithmetic_v<ValueType>
+[[nodiscard]] std::string format_number(ValueType value) {
+    std::array<char, detail::kMaxNumberChars> buffer;
+    return std::string(buffer.data(), format_number(value, std::span<char>(buffer)));
+}
+
+/**
+ * @brief 解析数值（不抛异常，不要求以 '\0' 结尾）
+ * 
+ * @param str 待解析文本，允许首尾空白和前导 '+'
+ * @return std::optional<ValueType> 格式错误、存在多余字符或超出类型范围时返回 std::nullopt
+ * 
+ * @details
+ * 1. 整数只接受十进制，无符号类型不接受负号
+ * 2. 浮点数接受定点、科学计数法以及 inf/nan，结果为最接近的可表示值
+ * 3. bool 接受 "true"/"false"/"1"/"0"
+ */
+template <typename ValueType>
+    requires std::is_arithmetic_v<ValueType>
+[[nodiscard]] std::optional<ValueType> parse_number(std::string_view str) noexcept {
+    str = detail::trim_number(str);
+    if constexpr (std::is_same_v<ValueType, bool>) {
+        if (str == "true" || str == "1") {
+            return true;
+        }
+        if (str == "false" || str == "0") {
+            return false;
+        }
+        return std::nullopt;
+    } else {
+        // std::from_chars 不接受前导 '+'，"+-1" 之类仍会被拒绝
+        if (str.size() > 1 && str.front() == '+' && str[1] != '-') {
+            str.remove_prefix(1);
+        }
+        if (str.empty()) {
+            return std::nullopt;
+        }
+        ValueType value{};
+        const char* const last = str.data() + str.size();
+        const auto [ptr, ec] = std::from_chars(str.data(), last, value);
+        if (ec != std::errc{} || ptr != last) {
+            return std::nullopt;
+        }
+        return value;
+    }
+}
+
+/**
+ * 针对数值类型的转换：使用 format_number（浮点数为最短往返表示）
  */
 template <typename ValueType>
 std::enable_if_t<std::is_arithmetic_v<ValueType>, std::string>
 any_to_string(const std::any& data) {
-    return std::to_string(std::any_cast<ValueType>(data));
+    return format_number(std::any_cast<ValueType>(data));
 }
 
 /**
- * 针对其他类型的转换：调用对象的 to_string() 方法
+ * 针对 std::string：直接返回
  */
 template <typename ValueType>
-std::enable_if_t<!std::is_arithmetic_v<ValueType>, std::string>
+std::enable_if_t<std::is_same_v<ValueType, std::string>, std::string>
 any_to_string(const std::any& data) {
-    return std::any_cast<ValueType>(data).to_string();
+    return std::any_cast<const std::string&>(data);
 }
+
 /**
- * 针对数值类型的转换：使用 std::stoX
+ * 针对数值数组：输出为 [v1, v2, ...]
  */
 template <typename ValueType>
-std::enable_if_t<std::is_integral_v<ValueType>, std::any>
-string_to_any(const std::string& str) {
-    if constexpr (std::is_same_v<ValueType, bool>) {
-        return std::any(str == "true" || str == "1");
-    } else if constexpr (std::is_signed_v<ValueType>) {
-        return std::any(static_cast<ValueType>(std::stoll(str)));
-    } else {
-        return std::any(static_cast<ValueType>(std::stoull(str)));
+std::enable_if_t<detail::is_arithmetic_vector_v<ValueType>, std::string>
+any_to_string(const std::any& data) {
+    const auto& values = std::any_cast<const ValueType&>(data);
+    std::array<char, detail::kMaxNumberChars> buffer;
+    std::string result = "[";
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (i > 0) {
+            result += ", ";
+        }
+        result.append(buffer.data(), format_number(values[i], std::span<char>(buffer)));
     }
+    result += "]";
+    return result;
 }
 
+/**
+ * 针对其他类型的转换：调用对象的 to_string() 方法
+ */
 template <typename ValueType>
-std::enable_if_t<std::is_floating_point_v<ValueType>, std::any>
-string_to_any(const std::string& str) {
-    if constexpr (std::is_same_v<ValueType, float>) {
-        return std::any(std::stof(str));
-    } else if constexpr (std::is_same_v<ValueType, double>) {
-        return std::any(std::stod(str));
-    } else {
-        return std::any(std::stold(str));
+std::enable_if_t<!std::is_arithmetic_v<ValueType> && 
+                 !std::is_same_v<ValueType, std::string> &&
+                 !detail::is_arithmetic_vector_v<ValueType>, std::string>
+any_to_string(const std::any& data) {
+    return std::any_cast<const ValueType&>(data).to_string();
+}
+/**
+ * 针对数值类型的转换：使用 parse_number，格式错误或越界时返回空的 std::any（不抛异常）
+ */
+template <typename ValueType>
+std::enable_if_t<std::is_arithmetic_v<ValueType>, std::any>
+string_to_any(std::string_view str) {
+    if (const auto value = parse_number<ValueType>(str)) {
+        return std::any(*value);
     }
+    return {};
 }
 
 /**
@@ -55,17 +189,108 @@ string_to_any(const std::string& str) {
  */
 template <typename ValueType>
 std::enable_if_t<std::is_same_v<ValueType, std::string>, std::any>
-string_to_any(const std::string& str) {
-    return std::any(str);
+string_to_any(std::string_view str) {
+    return std::any(std::string(str));
+}
+
+/**
+ * 针对数值数组：解析 [v1, v2, ...]（方括号可省略），任一元素非法时返回空的 std::any
+ */
+template <typename ValueType>
+std::enable_if_t<detail::is_arithmetic_vector_v<ValueType>, std::any>
+string_to_any(std::string_view str) {
+    using ElementType = typename ValueType::value_type;
+    constexpr std::string_view whitespace = " \t\n\r";
+
+    std::string_view body = str;
+    body.remove_prefix(std::min(body.find_first_not_of(whitespace), body.size()));
+    body.remove_suffix(body.size() - std::min(body.find_last_not_of(whitespace) + 1, body.size()));
+    if (body.size() >= 2 && body.front() == '[' && body.back() == ']') {
+        body = body.substr(1, body.size() - 2);
+    }
+
+    ValueType result;
+    if (body.find_first_not_of(whitespace) == std::string_view::npos) {
+        return std::any(std::move(result));
+    }
+    size_t begin = 0;
+    while (begin <= body.size()) {
+        const size_t end = std::min(body.find(',', begin), body.size());
+        const auto item = parse_number<ElementType>(body.substr(begin, end - begin));
+        if (!item) {
+            return {};
+        }
+        result.push_back(*item);
+        begin = end + 1;
+    }
+    return std::any(std::move(result));
+}
+
+/**
+ * 针对其它类型：优先使用 static from_string(const std::string&) 方法，否则使用构造函数
+ */
+template <typename ValueType>
+std::enable_if_t<!std::is_arithmetic_v<ValueType> && 
+                 !std::is_same_v<ValueType, std::string> &&
+                 !detail::is_arithmetic_vector_v<ValueType>, std::any>
+string_to_any(std::string_view str) {
+    if constexpr (detail::HasFromString<ValueType>) {
+        return std::any(ValueType::from_string(std::string(str)));
+    } else {
+        return std::any(ValueType(std::string(str)));
+    }
 }
 
 /**
- * 针对其它类型：假设具有 static from_string(const std::string&) 方法
+ * @brief 单个类型的文本转换函数（类型擦除，由 make_any_converter 实例化）
+ */
+struct AnyConverter {
+    std::string_view name;
+    // 追加 payload 的文本表示，调用方保证 payload 的类型与注册类型一致
+    void (*append)(std::string& out, const std::any& payload);
+    // 解析文本，格式错误时返回空的 std::any（不抛异常）
+    std::any (*parse)(std::string_view str);
+};
+
+namespace detail {
+
+template <typename ValueType>
+void append_any_value(std::string& out, const std::any& payload) {
+    const ValueType& value = *std::any_cast<ValueType>(&payload);
+    if constexpr (std::is_arithmetic_v<ValueType>) {
+        std::array<char, kMaxNumberChars> buffer;
+        out.append(buffer.data(), format_number(value, std::span<char>(buffer)));
+    } else if constexpr (std::is_same_v<ValueType, std::string>) {
+        out += value;
+    } else {
+        out += any_to_string<ValueType>(payload);
+    }
+}
+
+template <typename ValueType>
+std::any parse_any_value(std::string_view str) noexcept {
+    try {
+        return string_to_any<ValueType>(str);
+    } catch (...) {
+        // 自定义类型的构造函数或 from_string 可能抛异常，统一视为格式错误
+        return {};
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief 生成 ValueType 的转换函数，转换规则同 any_to_string<ValueType> / string_to_any<ValueType>
+ *
+ * @param name 类型名称，需为静态存储期的字符串
  */
 template <typename ValueType>
-std::enable_if_t<!std::is_arithmetic_v<ValueType> && !std::is_same_v<ValueType, std::string>, std::any>
-string_to_any(const std::string& str) {
-    return std::any(ValueType(str));
+[[nodiscard]] constexpr AnyConverter make_any_converter(std::string_view name) noexcept {
+    return AnyConverter{
+        .name = name,
+        .append = &detail::append_any_value<ValueType>,
+        .parse = &detail::parse_any_value<ValueType>,
+    };
 }
 
 }  // namespace sequoia::utils
\ No newline at end of file
@@ -0,0 +1,317 @@
+#pragma once
+
+#include <concepts>
+#include <map>
+#include <memory_resource>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <variant>
+#include <vector>
+#include <sequoia/utils/params.h>
+
+namespace sequoia::utils {
+
+/**
+ * @brief 竞技场参数值
+ *
+ * @note 备选类型顺序与 ParamValue 一致，字符串和数组从竞技场分配，
+ * 嵌套 Params 仍为堆上的不可变共享对象
+ */
+using ArenaParamValue = std::variant<bool, int, int64_t, double, std::pmr::string,
+                                     std::pmr::vector<double>, std::pmr::vector<int64_t>,
+                                     std::shared_ptr<const Params>>;
+
+namespace detail {
+
+// 对外类型 -> 竞技场存储类型
+template <typename T>
+struct ArenaStorage {
+    using type = T;
+};
+
+template <>
+struct ArenaStorage<std::string> {
+    using type = std::pmr::string;
+};
+
+template <>
+struct ArenaStorage<std::vector<double>> {
+    using type = std::pmr::vector<double>;
+};
+
+template <>
+struct ArenaStorage<std::vector<int64_t>> {
+    using type = std::pmr::vector<int64_t>;
+};
+
+template <>
+struct ArenaStorage<Params> {
+    using type = std::shared_ptr<const Params>;
+};
+
+template <typename T>
+using ArenaStorageT = typename ArenaStorage<T>::type;
+
+// variant 不感知分配器，字符串和数组必须显式传入竞技场
+template <typename T>
+[[nodiscard]] ArenaParamValue to_arena_value(const T& value, std::pmr::memory_resource* resource) {
+    using StorageType = ArenaStorageT<T>;
+    if constexpr (std::same_as<T, std::string> || kIsParamVector<T>) {
+        return ArenaParamValue(std::in_place_type<StorageType>, value.begin(), value.end(), resource);
+    } else if constexpr (std::same_as<T, Params>) {
+        return ArenaParamValue(std::in_place_type<StorageType>, std::make_shared<const T>(value));
+    } else {
+        return ArenaParamValue(std::in_place_type<StorageType>, value);
+    }
+}
+
+template <typename T>
+[[nodiscard]] T from_arena_value(const ArenaStorageT<T>& value) {
+    if constexpr (std::same_as<T, std::string> || kIsParamVector<T>) {
+        return T(value.begin(), value.end());
+    } else if constexpr (std::same_as<T, Params>) {
+        return *value;
+    } else {
+        return value;
+    }
+}
+
+// ParamValue -> ArenaParamValue（备选类型下标一致）
+[[nodiscard]] inline ArenaParamValue to_arena_value(const ParamValue& value,
+                                                    std::pmr::memory_resource* resource) {
+    return std::visit([resource](const auto& item) -> ArenaParamValue {
+        using ItemType = std::decay_t<decltype(item)>;
+        if constexpr (std::same_as<ItemType, std::string>) {
+            return ArenaParamValue(std::in_place_type<std::pmr::string>,
+                                   item.begin(), item.end(), resource);
+        } else if constexpr (std::same_as<ItemType, DoubleVec>) {
+            return ArenaParamValue(std::in_place_type<std::pmr::vector<double>>,
+                                   item.begin(), item.end(), resource);
+        } else if constexpr (std::same_as<ItemType, Int64Vec>) {
+            return ArenaParamValue(std::in_place_type<std::pmr::vector<int64_t>>,
+                                   item.begin(), item.end(), resource);
+        } else {
+            return ArenaParamValue(std::in_place_type<ItemType>, item);
+        }
+    }, value);
+}
+
+// ArenaParamValue -> ParamValue（备选类型下标一致）
+[[nodiscard]] inline ParamValue to_param_value(const ArenaParamValue& value) {
+    return std::visit([](const auto& item) -> ParamValue {
+        using ItemType = std::decay_t<decltype(item)>;
+        if constexpr (std::same_as<ItemType, std::pmr::string>) {
+            return ParamValue(std::in_place_type<std::string>, item.begin(), item.end());
+        } else if constexpr (std::same_as<ItemType, std::pmr::vector<double>>) {
+            return ParamValue(std::in_place_type<DoubleVec>, std::span<const double>(item));
+        } else if constexpr (std::same_as<ItemType, std::pmr::vector<int64_t>>) {
+            return ParamValue(std::in_place_type<Int64Vec>, std::span<const int64_t>(item));
+        } else {
+            return ParamValue(std::in_place_type<ItemType>, item);
+        }
+    }, value);
+}
+
+} // namespace detail
+
+/**
+ * @brief 基于 std::pmr 内存资源的参数集，适用于短生命周期（如单次请求）的参数
+ *
+ * @tparam Resource 内存资源类型，默认使用单调缓冲区（竞技场）
+ *
+ * @details
+ * 1. 键、map 节点、字符串和数组均从 Resource 分配，使用单调缓冲区时整体一次性释放
+ * 2. 对外接口与 Params 保持一致，可通过 to_params() / assign() 与 Params 互相转换
+ * 3. map 持有内部资源的指针，因此不可拷贝、不可移动
+ *
+ * @code
+ * std::array<std::byte, 4096> buffer;
+ * ArenaParams params(buffer.data(), buffer.size());
+ * params.set("user", "alice");
+ * Params heap_params = params.to_params();
+ * @endcode
+ */
+template <typename Resource = std::pmr::monotonic_buffer_resource>
+class BasicArenaParams {
+    static_assert(std::derived_from<Resource, std::pmr::memory_resource>,
+                  "Resource must derive from std::pmr::memory_resource");
+
+public:
+    using ParamMap = std::pmr::map<std::pmr::string, ArenaParamValue, std::less<>>;
+    using const_iterator = typename ParamMap::const_iterator;
+
+    // 参数直接转发给 Resource 的构造函数
+    template <typename... Args>
+        requires std::constructible_from<Resource, Args...>
+    explicit BasicArenaParams(Args&&... args)
+        : resource_(std::forward<Args>(args)...), params_(&resource_) {}
+
+    BasicArenaParams(const BasicArenaParams&) = delete;
+    BasicArenaParams& operator=(const BasicArenaParams&) = delete;
+    BasicArenaParams(BasicArenaParams&&) = delete;
+    BasicArenaParams& operator=(BasicArenaParams&&) = delete;
+
+    [[nodiscard]] Resource& resource() noexcept {
+        return resource_;
+    }
+
+    [[nodiscard]] bool have(std::string_view key) const noexcept {
+        return params_.contains(key);
+    }
+
+    [[nodiscard]] size_t size() const noexcept {
+        return params_.size();
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return params_.empty();
+    }
+
+    [[nodiscard]] std::string type(std::string_view key) const {
+        return std::string(detail::param_type_name(find(key)->second.index()));
+    }
+
+    template <typename ValueType>
+        requires SupportedParamType<ValueType>
+    [[nodiscard]] ValueType get(std::string_view key) const;
+
+    template <typename ValueType>
+        requires SupportedParamType<ValueType>
+    [[nodiscard]] ValueType try_get(std::string_view key, const ValueType& default_value) const noexcept {
+        try {
+            return get<ValueType>(key);
+        } catch (...) {
+            return default_value;
+        }
+    }
+
+    template <typename ValueType>
+        requires SupportedParamType<ValueType>
+    void set(std::string_view key, const ValueType& value);
+
+    // 字符串字面量按 std::string 存储
+    void set(std::string_view key, const char* value) {
+        set<std::string>(key, value);
+    }
+
+    bool remove(std::string_view key) noexcept {
+        auto it = params_.find(key);
+        if (it == params_.end()) {
+            return false;
+        }
+        params_.erase(it);
+        return true;
+    }
+
+    // 清空参数，资源支持 release() 时一并归还全部内存
+    void clear() noexcept {
+        params_.clear();
+        if constexpr (requires(Resource& r) { r.release(); }) {
+            resource_.release();
+        }
+    }
+
+    // 用 Params 的内容替换当前参数
+    void assign(const Params& params) {
+        clear();
+        for (const auto& [key, value] : params.params_) {
+            params_.emplace_hint(params_.end(), std::piecewise_construct,
+                                 std::forward_as_tuple(key.data(), key.size()),
+                                 std::forward_as_tuple(detail::to_arena_value(value, &resource_)));
+        }
+    }
+
+    // 转换为堆分配的 Params（键已有序，逐个追加到末尾）
+    [[nodiscard]] Params to_params() const {
+        Params result;
+        for (const auto& [key, value] : params_) {
+            result.params_.emplace_hint(result.params_.end(), std::piecewise_construct,
+                                        std::forward_as_tuple(key.data(), key.size()),
+                                        std::forward_as_tuple(detail::to_param_value(value)));
+        }
+        return result;
+    }
+
+    [[nodiscard]] const_iterator begin() const noexcept {
+        return params_.begin();
+    }
+
+    [[nodiscard]] const_iterator end() const noexcept {
+        return params_.end();
+    }
+
+private:
+    [[nodiscard]] const_iterator find(std::string_view key) const {
+        auto it = params_.find(key);
+        if (it == params_.end()) {
+            throw std::out_of_range(fmt::format("Param not found: {}", key));
+        }
+        return it;
+    }
+
+private:
+    // 声明顺序保证 params_ 先于 resource_ 析构
+    Resource resource_;
+    ParamMap params_;
+};
+
+using ArenaParams = BasicArenaParams<>;
+
+template <typename Resource>
+template <typename ValueType>
+    requires SupportedParamType<ValueType>
+ValueType BasicArenaParams<Resource>::get(std::string_view key) const {
+    auto it = find(key);
+
+    if (const auto* value = std::get_if<detail::ArenaStorageT<ValueType>>(&it->second)) {
+        return detail::from_arena_value<ValueType>(*value);
+    }
+
+    // 尝试整数类型之间的转换（int <-> int64_t）
+    if constexpr (IntegerParamType<ValueType>) {
+        if (const auto* value = std::get_if<int>(&it->second)) {
+            return static_cast<ValueType>(*value);
+        }
+        if (const auto* value = std::get_if<int64_t>(&it->second)) {
+            return static_cast<ValueType>(*value);
+        }
+    }
+
+    throw std::runtime_error(fmt::format(
+        "Failed convert param {} from {} to {}",
+        key, detail::param_type_name(it->second.index()), detail::kParamTypeName<ValueType>));
+}
+
+template <typename Resource>
+template <typename ValueType>
+    requires SupportedParamType<ValueType>
+void BasicArenaParams<Resource>::set(std::string_view key, const ValueType& value) {
+    using StorageType = detail::ArenaStorageT<ValueType>;
+
+    auto it = params_.find(key);
+    if (it == params_.end()) {
+        params_.emplace(std::piecewise_construct,
+                        std::forward_as_tuple(key.data(), key.size()),
+                        std::forward_as_tuple(detail::to_arena_value(value, &resource_)));
+        return;
+    }
+
+    // 检查类型兼容性，允许 int 和 int64_t 之间的转换
+    bool compatible = std::holds_alternative<StorageType>(it->second);
+    if constexpr (IntegerParamType<ValueType>) {
+        compatible = compatible || std::holds_alternative<int>(it->second) ||
+                     std::holds_alternative<int64_t>(it->second);
+    }
+
+    if (!compatible) {
+        throw std::logic_error(fmt::format(
+            "Param {} type mismatch: {} != {}",
+            key, detail::param_type_name(it->second.index()), detail::kParamTypeName<ValueType>));
+    }
+
+    it->second = detail::to_arena_value(value, &resource_);
+}
+
+} // namespace sequoia::utils
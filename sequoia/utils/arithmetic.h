@@ -4,6 +4,7 @@
 #include <string_view>
 #include <vector>
 #include <algorithm>
+#include <array>
 #include <concepts>
 #include <ranges>
 #include <cmath>
@@ -11,33 +12,48 @@
 #include <cstddef>
 #include <cstdint>
 #include <cctype>
+#include <optional>
+#include <span>
+#include <sequoia/utils/encoding.h>
+#include <sequoia/utils/split.h>
 
 namespace sequoia::utils {
 
-std::string utf8_to_gbk(const std::string& str);
-std::string gbk_to_utf8(const std::string& str);
+namespace detail {
+
+// 查表覆盖的最大指数，超出部分在表尾继续逐次乘 10
+inline constexpr int32_t kMaxTabulatedPower = 22;
+
+// 编译期生成的 10 的幂表，与逐次乘 10 的结果逐位一致
+template <std::floating_point ValueType>
+inline constexpr auto kPowersOfTen = [] {
+    std::array<ValueType, kMaxTabulatedPower + 1> table{};
+    ValueType scale = 1;
+    for (auto& entry : table) {
+        entry = scale;
+        scale *= 10;
+    }
+    return table;
+}();
 
 /**
- * @brief 对数值进行四舍五入，支持四舍六入五成双规则
- * 
- * @tparam ValueType 数值类型（必须是浮点类型）
- * @param value 要四舍五入的数值
- * @param ndigits 保留小数位数
- * @return ValueType 四舍五入后的结果
- * 
- * @details 使用银行家舍入法（四舍六入五成双）
+ * @brief 10 的 ndigits_abs 次幂（等价于逐次乘 10，批量接口与逐个计算共用以保证结果一致）
  */
 template <std::floating_point ValueType>
-[[nodiscard]] constexpr ValueType roundEx(ValueType value, int32_t ndigits = 0) noexcept {
-    ValueType scale = 1;
-    const int32_t ndigits_abs = std::abs(ndigits);
-    
-    for (int32_t i = 0; i < ndigits_abs; ++i) {
+[[nodiscard]] constexpr ValueType power_of_ten(int32_t ndigits_abs) noexcept {
+    if (ndigits_abs <= kMaxTabulatedPower) {
+        return kPowersOfTen<ValueType>[static_cast<size_t>(ndigits_abs < 0 ? 0 : ndigits_abs)];
+    }
+    ValueType scale = kPowersOfTen<ValueType>[kMaxTabulatedPower];
+    for (int32_t i = kMaxTabulatedPower; i < ndigits_abs; ++i) {
         scale *= 10;
     }
+    return scale;
+}
 
-    const ValueType scaled_value = (ndigits >= 0) ? (value * scale) : (value / scale);
-    
+// 对已缩放的值做银行家舍入
+template <std::floating_point ValueType>
+[[nodiscard]] constexpr ValueType round_half_even(ValueType scaled_value) noexcept {
     // 四舍五入
     ValueType rounded_value = std::round(scaled_value);
     
@@ -47,7 +63,42 @@ template <std::floating_point ValueType>
         std::numeric_limits<ValueType>::epsilon()) {
         rounded_value = static_cast<ValueType>(2) * std::round(scaled_value / static_cast<ValueType>(2));
     }
+    return rounded_value;
+}
 
+// 对已缩放的值向上取整（远离 0，整数也强制进位）
+template <std::floating_point ValueType>
+[[nodiscard]] constexpr ValueType ceil_away(ValueType scaled_value) noexcept {
+    return (scaled_value >= 0.0) 
+        ? std::floor(scaled_value + 1.0)
+        : std::ceil(scaled_value - 1.0);
+}
+
+// 对已缩放的值向下取整（趋向 0）
+template <std::floating_point ValueType>
+[[nodiscard]] constexpr ValueType floor_toward_zero(ValueType scaled_value) noexcept {
+    return (scaled_value >= 0.0) 
+        ? std::floor(scaled_value)
+        : std::ceil(scaled_value);
+}
+
+} // namespace detail
+
+/**
+ * @brief 对数值进行四舍五入，支持四舍六入五成双规则
+ * 
+ * @tparam ValueType 数值类型（必须是浮点类型）
+ * @param value 要四舍五入的数值
+ * @param ndigits 保留小数位数
+ * @return ValueType 四舍五入后的结果
+ * 
+ * @details 使用银行家舍入法（四舍六入五成双）
+ */
+template <std::floating_point ValueType>
+[[nodiscard]] constexpr ValueType roundEx(ValueType value, int32_t ndigits = 0) noexcept {
+    const ValueType scale = detail::power_of_ten<ValueType>(std::abs(ndigits));
+    const ValueType scaled_value = (ndigits >= 0) ? (value * scale) : (value / scale);
+    const ValueType rounded_value = detail::round_half_even(scaled_value);
     return (ndigits >= 0) ? (rounded_value / scale) : (rounded_value * scale);
 }
 
@@ -65,19 +116,8 @@ template <std::floating_point ValueType>
  */
 template <std::floating_point ValueType>
 [[nodiscard]] constexpr ValueType ceilEx(ValueType value, int32_t ndigits = 0) noexcept {
-    ValueType scale = 1;
-    const int32_t ndigits_abs = std::abs(ndigits);
-    
-    for (int32_t i = 0; i < ndigits_abs; ++i) {
-        scale *= 10;
-    }
-
-    ValueType scaled_value = (ndigits >= 0) ? (value * scale) : (value / scale);
-    
-    scaled_value = (scaled_value >= 0.0) 
-        ? std::floor(scaled_value + 1.0)
-        : std::ceil(scaled_value - 1.0);
-
+    const ValueType scale = detail::power_of_ten<ValueType>(std::abs(ndigits));
+    const ValueType scaled_value = detail::ceil_away<ValueType>((ndigits >= 0) ? (value * scale) : (value / scale));
     return (ndigits >= 0) ? (scaled_value / scale) : (scaled_value * scale);
 }
 
@@ -95,72 +135,211 @@ template <std::floating_point ValueType>
  */
 template <std::floating_point ValueType>
 [[nodiscard]] constexpr ValueType floorEx(ValueType value, int32_t ndigits = 0) noexcept {
-    ValueType scale = 1;
-    const int32_t ndigits_abs = std::abs(ndigits);
-    
-    for (int32_t i = 0; i < ndigits_abs; ++i) {
-        scale *= 10;
+    const ValueType scale = detail::power_of_ten<ValueType>(std::abs(ndigits));
+    const ValueType scaled_value = detail::floor_toward_zero<ValueType>((ndigits >= 0) ? (value * scale) : (value / scale));
+    return (ndigits >= 0) ? (scaled_value / scale) : (scaled_value * scale);
+}
+
+/**
+ * @brief 编译期确定小数位数的四舍五入，结果与 roundEx(value, NDigits) 逐位一致
+ * 
+ * @tparam NDigits 保留小数位数，可为负数
+ * 
+ * @details scale 与正负分支在编译期确定，roundEx<2>(price) 只剩乘法、舍入和除法
+ */
+template <int32_t NDigits, std::floating_point ValueType>
+[[nodiscard]] constexpr ValueType roundEx(ValueType value) noexcept {
+    constexpr ValueType scale = detail::power_of_ten<ValueType>(NDigits >= 0 ? NDigits : -NDigits);
+    if constexpr (NDigits >= 0) {
+        return detail::round_half_even(value * scale) / scale;
+    } else {
+        return detail::round_half_even(value / scale) * scale;
+    }
+}
+
+/**
+ * @brief 编译期确定小数位数的向上取整，结果与 ceilEx(value, NDigits) 逐位一致
+ */
+template <int32_t NDigits, std::floating_point ValueType>
+[[nodiscard]] constexpr ValueType ceilEx(ValueType value) noexcept {
+    constexpr ValueType scale = detail::power_of_ten<ValueType>(NDigits >= 0 ? NDigits : -NDigits);
+    if constexpr (NDigits >= 0) {
+        return detail::ceil_away(value * scale) / scale;
+    } else {
+        return detail::ceil_away(value / scale) * scale;
     }
+}
 
-    ValueType scaled_value = (ndigits >= 0) ? (value * scale) : (value / scale);
+/**
+ * @brief 编译期确定小数位数的向下取整，结果与 floorEx(value, NDigits) 逐位一致
+ */
+template <int32_t NDigits, std::floating_point ValueType>
+[[nodiscard]] constexpr ValueType floorEx(ValueType value) noexcept {
+    constexpr ValueType scale = detail::power_of_ten<ValueType>(NDigits >= 0 ? NDigits : -NDigits);
+    if constexpr (NDigits >= 0) {
+        return detail::floor_toward_zero(value * scale) / scale;
+    } else {
+        return detail::floor_toward_zero(value / scale) * scale;
+    }
+}
 
-    scaled_value = (scaled_value >= 0.0) 
-        ? std::floor(scaled_value)
-        : std::ceil(scaled_value);
+/**
+ * @brief 批量四舍五入（银行家舍入），结果与逐个调用 roundEx(value, ndigits) 逐位一致
+ * 
+ * @param values 输入数组
+ * @param out 输出数组，长度至少为 values.size()，可与 values 为同一块内存
+ * @param ndigits 保留小数位数
+ * @return size_t 写入的元素个数，输出不足时返回 0 且不写入
+ * 
+ * @details scale 只计算一次；double 运行时按 CPU 分派到 AVX-512 / AVX2 / 标量实现，float 使用标量实现
+ */
+size_t roundEx(std::span<const double> values, std::span<double> out, int32_t ndigits = 0) noexcept;
+size_t roundEx(std::span<const float> values, std::span<float> out, int32_t ndigits = 0) noexcept;
 
-    return (ndigits >= 0) ? (scaled_value / scale) : (scaled_value * scale);
+/**
+ * @brief 批量向上取整，结果与逐个调用 ceilEx(value, ndigits) 逐位一致
+ * 
+ * @return size_t 写入的元素个数，输出不足时返回 0 且不写入
+ */
+size_t ceilEx(std::span<const double> values, std::span<double> out, int32_t ndigits = 0) noexcept;
+size_t ceilEx(std::span<const float> values, std::span<float> out, int32_t ndigits = 0) noexcept;
+
+/**
+ * @brief 批量向下取整，结果与逐个调用 floorEx(value, ndigits) 逐位一致
+ * 
+ * @return size_t 写入的元素个数，输出不足时返回 0 且不写入
+ */
+size_t floorEx(std::span<const double> values, std::span<double> out, int32_t ndigits = 0) noexcept;
+size_t floorEx(std::span<const float> values, std::span<float> out, int32_t ndigits = 0) noexcept;
+
+// 原地批量四舍五入
+inline void roundEx(std::span<double> values, int32_t ndigits = 0) noexcept {
+    (void)roundEx(values, values, ndigits);
+}
+
+inline void roundEx(std::span<float> values, int32_t ndigits = 0) noexcept {
+    (void)roundEx(values, values, ndigits);
+}
+
+// 原地批量向上取整
+inline void ceilEx(std::span<double> values, int32_t ndigits = 0) noexcept {
+    (void)ceilEx(values, values, ndigits);
+}
+
+inline void ceilEx(std::span<float> values, int32_t ndigits = 0) noexcept {
+    (void)ceilEx(values, values, ndigits);
+}
+
+// 原地批量向下取整
+inline void floorEx(std::span<double> values, int32_t ndigits = 0) noexcept {
+    (void)floorEx(values, values, ndigits);
+}
+
+inline void floorEx(std::span<float> values, int32_t ndigits = 0) noexcept {
+    (void)floorEx(values, values, ndigits);
 }
 
 /**
- * @brief 将字符串转换为小写（使用 C++20 ranges）
+ * @brief 将 ASCII 字母转换为小写，写入调用方提供的缓冲区（不分配内存）
  * 
  * @param str 要转换的字符串
+ * @param out 输出缓冲区，长度至少为 str.size()，可与 str 为同一块内存
+ * @return size_t 写入的字符数，缓冲区不足时返回 0 且不写入
+ * 
+ * @details 只转换 'A'~'Z'，其余字节（包括 UTF-8/GBK 多字节字符）原样保留，
+ * 与 "C" locale 下的 std::tolower 结果一致；运行时按 CPU 分派到 AVX2 / SSE2 / 标量实现
  */
-inline void toLower(std::string& str) {
-    std::ranges::transform(str, str.begin(), [](unsigned char c) {
-        return std::tolower(c);
-    });
+[[nodiscard]] size_t toLower(std::string_view str, std::span<char> out) noexcept;
+
+/**
+ * @brief 将 ASCII 字母转换为大写，写入调用方提供的缓冲区（不分配内存）
+ * 
+ * @param str 要转换的字符串
+ * @param out 输出缓冲区，长度至少为 str.size()，可与 str 为同一块内存
+ * @return size_t 写入的字符数，缓冲区不足时返回 0 且不写入
+ */
+[[nodiscard]] size_t toUpper(std::string_view str, std::span<char> out) noexcept;
+
+/**
+ * @brief 将字符串转换为小写（原地转换，仅 ASCII 字母）
+ * 
+ * @param str 要转换的字符串
+ */
+inline void toLower(std::string& str) noexcept {
+    (void)toLower(str, str);
 }
 
 /**
- * @brief 将字符串转换为大写（使用 C++20 ranges）
+ * @brief 将字符串转换为大写（原地转换，仅 ASCII 字母）
  * 
  * @param str 要转换的字符串
  */
-inline void toUpper(std::string& str) {
-    std::ranges::transform(str, str.begin(), [](unsigned char c) {
-        return std::toupper(c);
-    });
+inline void toUpper(std::string& str) noexcept {
+    (void)toUpper(str, str);
+}
+
+// 批量转换
+inline void toLower(std::span<std::string> strs) noexcept {
+    for (auto& str : strs) {
+        toLower(str);
+    }
+}
+
+inline void toUpper(std::span<std::string> strs) noexcept {
+    for (auto& str : strs) {
+        toUpper(str);
+    }
+}
+
+namespace detail {
+
+[[nodiscard]] constexpr bool is_trim_space(char c) noexcept {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
 }
 
+} // namespace detail
+
 /**
- * @brief 删除字符串两端的空格（使用 C++20 ranges）
+ * @brief 返回去除两端空白（空格、\t、\n、\r）后的视图，不分配内存
  * 
- * @param str 要处理的字符串
+ * @param str_view 要处理的字符串视图
+ * @return std::string_view 指向输入字符串的子视图
  */
-inline void trim(std::string& str) {
-    if (str.empty()) {
-        return;
+[[nodiscard]] constexpr std::string_view trim_view(std::string_view str_view) noexcept {
+    size_t first = 0;
+    while (first < str_view.size() && detail::is_trim_space(str_view[first])) {
+        ++first;
     }
-    
-    constexpr std::string_view whitespace = " \t\n\r";
-    
-    auto first = std::ranges::find_if(str, [&](char c) {
-        return whitespace.find(c) == std::string_view::npos;
-    });
-    
-    if (first == str.end()) {
-        str.clear();
-        return;
+    size_t last = str_view.size();
+    while (last > first && detail::is_trim_space(str_view[last - 1])) {
+        --last;
     }
-    
-    auto last = std::ranges::find_if(str | std::views::reverse, [&](char c) {
-        return whitespace.find(c) == std::string_view::npos;
-    }).base();
-    
-    str = std::string(first, last);
+    return str_view.substr(first, last - first);
 }
 
+/**
+ * @brief 删除字符串两端的空白（原地 erase，不重新分配）
+ * 
+ * @param str 要处理的字符串
+ */
+inline void trim(std::string& str) noexcept {
+    const std::string_view trimmed = trim_view(str);
+    str.erase(static_cast<size_t>(trimmed.data() - str.data()) + trimmed.size());
+    str.erase(0, static_cast<size_t>(trimmed.data() - str.data()));
+}
+
+// 批量去除两端空白
+inline void trim(std::span<std::string> strs) noexcept {
+    for (auto& str : strs) {
+        trim(str);
+    }
+}
+
+inline void trim_view(std::span<std::string_view> views) noexcept {
+    for (auto& view : views) {
+        view = trim_view(view);
+    }
+}
 
 /**
  * @brief 将字符串按指定分隔符分割为多个子字符串
@@ -168,20 +347,13 @@ inline void trim(std::string& str) {
  * @param str_view 要分割的字符串视图（支持 std::string 隐式转换）
  * @param delimiter 分隔符
  * @return std::vector<std::string_view> 分割后的子字符串
- * @note 注意返回结果的生命周期应与输入的字符串相同！
+ * @note 注意返回结果的生命周期应与输入的字符串相同！只需遍历或取前几个字段时使用 split_view()
  */
 [[nodiscard]] inline std::vector<std::string_view> split(std::string_view str_view, char delimiter) {
     std::vector<std::string_view> result;
-    size_t prepos = 0;
-    size_t pos = str_view.find_first_of(delimiter, prepos);
-    
-    while (pos != std::string_view::npos) {
-        result.emplace_back(str_view.substr(prepos, pos - prepos));
-        prepos = pos + 1;
-        pos = str_view.find_first_of(delimiter, prepos);
+    for (std::string_view field : split_view(str_view, delimiter)) {
+        result.emplace_back(field);
     }
-    
-    result.emplace_back(str_view.substr(prepos));
     return result;
 }
 
@@ -191,90 +363,96 @@ inline void trim(std::string& str) {
  * @param str_view 要分割的字符串视图
  * @param split_str 分隔符字符串
  * @return std::vector<std::string_view> 分割后的子字符串
- * @note 注意返回结果的生命周期应与输入的字符串相同！
+ * @note 注意返回结果的生命周期应与输入的字符串相同！只需遍历或取前几个字段时使用 split_view()
  */
 [[nodiscard]] inline std::vector<std::string_view> split(std::string_view str_view, std::string_view split_str) {
     std::vector<std::string_view> result;
-    
-    if (split_str.empty()) {
-        result.emplace_back(str_view);
-        return result;
-    }
-    
-    size_t prepos = 0;
-    size_t pos = str_view.find(split_str, prepos);
-    
-    while (pos != std::string_view::npos) {
-        result.emplace_back(str_view.substr(prepos, pos - prepos));
-        prepos = pos + split_str.size();
-        pos = str_view.find(split_str, prepos);
+    for (std::string_view field : split_view(str_view, split_str)) {
+        result.emplace_back(field);
     }
-    
-    result.emplace_back(str_view.substr(prepos));
     return result;
 }
 
+/**
+ * @brief 十六进制字母的大小写
+ */
+enum class HexCase : uint8_t {
+    Upper,
+    Lower,
+};
+
+/**
+ * @brief 将字节数组转换为十六进制字符串，写入调用方提供的缓冲区（不分配内存）
+ * 
+ * @param bytes 字节数组
+ * @param out 输出缓冲区，长度至少为 bytes.size() * 2
+ * @param hex_case 字母大小写
+ * @return size_t 写入的字符数，缓冲区不足时返回 0 且不写入
+ * 
+ * @details 运行时按 CPU 分派到 AVX2 / SSE2 / 标量实现
+ */
+[[nodiscard]] size_t byteToHex(std::string_view bytes, std::span<char> out,
+                               HexCase hex_case = HexCase::Upper) noexcept;
+
 /**
  * @brief 将字节数组转换为十六进制字符串 如："abcd" -> "61626364"
  * 
  * @param bytes 字节数组
  * @param len 字节数组长度
+ * @param hex_case 字母大小写
  * @return std::string 十六进制字符串
  */
-[[nodiscard]] inline std::string byteToHex(const char* bytes, size_t len) {
-    if (bytes == nullptr) {
-        return {};
-    }
-    
-    std::string result;
-    result.reserve(len * 2);
-    
-    const auto* p = reinterpret_cast<const unsigned char*>(bytes);
-    for (size_t i = 0; i < len; ++i) {
-        const unsigned char high = p[i] >> 4;
-        const unsigned char low = p[i] & 0x0F;
-        result.push_back(high < 10 ? '0' + high : 'A' + high - 10);
-        result.push_back(low < 10 ? '0' + low : 'A' + low - 10);
-    }
-    
-    return result;
-}
+[[nodiscard]] std::string byteToHex(const char* bytes, size_t len,
+                                    HexCase hex_case = HexCase::Upper);
 
-[[nodiscard]] inline std::string byteToHex(std::string_view bytes) {
-    return byteToHex(bytes.data(), bytes.size());
+[[nodiscard]] inline std::string byteToHex(std::string_view bytes,
+                                           HexCase hex_case = HexCase::Upper) {
+    return byteToHex(bytes.data(), bytes.size(), hex_case);
 }
 
+/**
+ * @brief 将字节数组转换为带前缀的十六进制字符串，写入调用方提供的缓冲区（不分配内存）
+ * 
+ * @param bytes 字节数组
+ * @param out 输出缓冲区，长度至少为 bytes.size() * 5
+ * @param hex_case 字母大小写
+ * @return size_t 写入的字符数，缓冲区不足时返回 0 且不写入
+ */
+[[nodiscard]] size_t byteToHexWithPrefix(std::string_view bytes, std::span<char> out,
+                                         HexCase hex_case = HexCase::Upper) noexcept;
+
 /**
  * @brief 将字节数组转换为十六进制字符串 如："abcd" -> "0x61 0x62 0x63 0x64"
  * 
  * @param bytes 字节数组
  * @param len 字节数组长度
+ * @param hex_case 字母大小写
  * @return std::string 十六进制字符串
  */
-[[nodiscard]] inline std::string byteToHexWithPrefix(const char* bytes, size_t len) {
-    if (bytes == nullptr) {
-        return {};
-    }
-    
-    std::string result;
-    result.reserve(len * 5);
-    
-    const auto* p = reinterpret_cast<const unsigned char*>(bytes);
-    for (size_t i = 0; i < len; ++i) {
-        const unsigned char high = p[i] >> 4;
-        const unsigned char low = p[i] & 0x0F;
-        
-        result.append("0x");
-        result.push_back(high < 10 ? '0' + high : 'A' + high - 10);
-        result.push_back(low < 10 ? '0' + low : 'A' + low - 10);
-        result.push_back(' ');
-    }
-    
-    return result;
-}
+[[nodiscard]] std::string byteToHexWithPrefix(const char* bytes, size_t len,
+                                              HexCase hex_case = HexCase::Upper);
 
-[[nodiscard]] inline std::string byteToHexWithPrefix(std::string_view bytes) {
-    return byteToHexWithPrefix(bytes.data(), bytes.size());
+[[nodiscard]] inline std::string byteToHexWithPrefix(std::string_view bytes,
+                                                     HexCase hex_case = HexCase::Upper) {
+    return byteToHexWithPrefix(bytes.data(), bytes.size(), hex_case);
 }
 
+/**
+ * @brief 将十六进制字符串解码为字节数组，写入调用方提供的缓冲区（不分配内存）
+ * 
+ * @param hex 十六进制字符串（大小写均可，不含前缀和分隔符）
+ * @param out 输出缓冲区，长度至少为 hex.size() / 2
+ * @return std::optional<size_t> 写入的字节数；长度为奇数、含非法字符或缓冲区不足时返回 std::nullopt
+ * @note 返回 std::nullopt 时 out 的内容未定义
+ */
+[[nodiscard]] std::optional<size_t> hexToByte(std::string_view hex, std::span<char> out) noexcept;
+
+/**
+ * @brief 将十六进制字符串解码为字节数组 如："61626364" -> "abcd"
+ * 
+ * @param hex 十六进制字符串（大小写均可，不含前缀和分隔符）
+ * @return std::optional<std::string> 解码结果，格式非法时返回 std::nullopt
+ */
+[[nodiscard]] std::optional<std::string> hexToByte(std::string_view hex);
+
 } // namespace sequoia::utils
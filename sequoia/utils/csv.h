@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sequoia::utils {
+
+/**
+ * @brief 分隔文本格式
+ *
+ * @details
+ * 1. quote 为 '\0' 时不识别引号（如 TSV）
+ * 2. escape 为 '\0' 时引号内使用 RFC 4180 的双引号转义（""），否则使用 escape 字符转义下一个字符
+ * 3. 转义只在引号内生效，引号只在字段开头生效
+ */
+struct CsvDialect {
+    char delimiter{','};
+    char quote{'"'};
+    char escape{'\0'};
+    bool skip_empty_lines{true};
+
+    [[nodiscard]] static constexpr CsvDialect csv() noexcept {
+        return {};
+    }
+
+    [[nodiscard]] static constexpr CsvDialect tsv() noexcept {
+        return {.delimiter = '\t', .quote = '\0'};
+    }
+};
+
+/**
+ * @brief 字段在缓冲区中的位置
+ *
+ * @note 引号字段的 offset/size 不含首尾引号；escaped 为 true 时内容含转义序列，需用 CsvTokenizer::unescape() 还原
+ */
+struct CsvField {
+    uint32_t offset{0};
+    uint32_t size{0};
+    bool quoted{false};
+    bool escaped{false};
+
+    [[nodiscard]] std::string_view view(std::string_view buffer) const noexcept {
+        return buffer.substr(offset, size);
+    }
+};
+
+/**
+ * @brief 可复用的字段索引，clear() 后保留容量，批量解析时不再分配内存
+ */
+class CsvIndex {
+public:
+    void clear() noexcept {
+        fields_.clear();
+        record_ends_.clear();
+    }
+
+    void reserve(size_t records, size_t fields) {
+        record_ends_.reserve(records);
+        fields_.reserve(fields);
+    }
+
+    [[nodiscard]] size_t record_count() const noexcept {
+        return record_ends_.size();
+    }
+
+    [[nodiscard]] size_t field_count() const noexcept {
+        return fields_.size();
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return record_ends_.empty();
+    }
+
+    // 第 index 条记录的全部字段
+    [[nodiscard]] std::span<const CsvField> record(size_t index) const noexcept {
+        const size_t begin = index == 0 ? 0 : record_ends_[index - 1];
+        return std::span<const CsvField>(fields_).subspan(begin, record_ends_[index] - begin);
+    }
+
+    // 所有记录的字段（按记录顺序连续存放）
+    [[nodiscard]] std::span<const CsvField> fields() const noexcept {
+        return fields_;
+    }
+
+private:
+    friend class CsvTokenizer;
+
+    std::vector<CsvField> fields_;
+    /// @brief 每条记录结束时 fields_ 的下标
+    std::vector<uint32_t> record_ends_;
+};
+
+/**
+ * @brief 批量分隔文本解析器
+ *
+ * @details
+ * 1. 一次处理整块缓冲区中的多条记录，结构字符（分隔符、引号、转义符、换行）由 SIMD 一次检测 64 字节，
+ *    只在结构字符处进入状态机
+ * 2. 结果写入可复用的 CsvIndex（字段偏移量），不为每行创建 std::string_view 数组
+ * 3. 支持流式解析：非最后一块时只解析完整记录，返回已消费的字节数，剩余部分与下一块拼接后继续
+ * 4. 记录以 "\n" 或 "\r\n" 结尾，引号内的换行属于字段内容
+ *
+ * @code
+ * CsvTokenizer tokenizer(CsvDialect::csv());
+ * CsvIndex index;
+ * size_t consumed = tokenizer.tokenize(buffer, index, false);
+ * for (size_t i = 0; i < index.record_count(); ++i) {
+ *     for (const CsvField& field : index.record(i)) { use(field.view(buffer)); }
+ * }
+ * // buffer.substr(consumed) 与下一块数据拼接
+ * @endcode
+ */
+class CsvTokenizer {
+public:
+    /// @brief 单次调用可处理的最大字节数（字段偏移量为 32 位）
+    static constexpr size_t kMaxBufferSize = UINT32_MAX;
+
+    explicit CsvTokenizer(CsvDialect dialect = CsvDialect::csv()) noexcept;
+
+    [[nodiscard]] const CsvDialect& dialect() const noexcept {
+        return dialect_;
+    }
+
+    /**
+     * @brief 解析缓冲区中的记录，结果覆盖写入 index
+     *
+     * @param buffer 数据缓冲区
+     * @param index 字段索引（先清空，保留容量）
+     * @param final 是否为最后一块数据，为 true 时末尾没有换行的记录也会输出
+     * @return size_t 已消费的字节数，非最后一块时为最后一条完整记录之后的位置
+     *
+     * @note 最后一块中未闭合的引号字段延伸到缓冲区末尾
+     */
+    size_t tokenize(std::string_view buffer, CsvIndex& index, bool final = true) const;
+
+    /**
+     * @brief 还原字段内容（去除转义），未转义的字段直接复制
+     *
+     * @param buffer 解析时使用的缓冲区
+     * @param field 字段
+     * @param out 输出字符串（覆盖写入）
+     */
+    void unescape(std::string_view buffer, const CsvField& field, std::string& out) const;
+
+    [[nodiscard]] std::string unescape(std::string_view buffer, const CsvField& field) const {
+        std::string result;
+        unescape(buffer, field, result);
+        return result;
+    }
+
+private:
+    CsvDialect dialect_;
+};
+
+} // namespace sequoia::utils
@@ -0,0 +1,377 @@
+#include "decimal.h"
+#include "arithmetic.h"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <limits>
+
+namespace sequoia::utils {
+
+namespace {
+
+// 中间结果使用 128 位整数，int64 尾数相乘或对齐小数位时不会溢出
+using Int128 = __int128;
+
+constexpr std::array<Int128, 39> kPow10 = [] {
+    std::array<Int128, 39> table{};
+    table[0] = 1;
+    for (size_t i = 1; i < table.size(); ++i) {
+        table[i] = table[i - 1] * 10;
+    }
+    return table;
+}();
+
+// 10^0 ~ 10^22 均可用 double 精确表示
+constexpr std::array<double, 23> kPow10Double = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+constexpr Int128 kInt128Max = static_cast<Int128>((static_cast<unsigned __int128>(1) << 127) - 1);
+
+[[nodiscard]] bool fitsInt64(Int128 value) noexcept {
+    return value >= std::numeric_limits<int64_t>::min() && value <= std::numeric_limits<int64_t>::max();
+}
+
+[[nodiscard]] bool validScale(int32_t scale) noexcept {
+    return Decimal::valid_scale(scale);
+}
+
+[[nodiscard]] Int128 abs128(Int128 value) noexcept {
+    return value < 0 ? -value : value;
+}
+
+// n / d 按 mode 舍入（d > 0），所有舍入方式都关于 0 对称
+[[nodiscard]] Int128 divideRounded(Int128 numerator, Int128 denominator, RoundingMode mode) noexcept {
+    Int128 quotient = 0;
+    Int128 remainder = 0;
+    if (fitsInt64(numerator) && fitsInt64(denominator)) {
+        // 常见情况走 64 位除法，比 128 位除法快一个数量级
+        const auto n = static_cast<int64_t>(numerator);
+        const auto d = static_cast<int64_t>(denominator);
+        quotient = n / d;
+        remainder = n % d;
+    } else {
+        quotient = numerator / denominator;
+        remainder = numerator % denominator;
+    }
+    remainder = abs128(remainder);
+    if (remainder == 0) {
+        return quotient;
+    }
+
+    bool carry = false;
+    switch (mode) {
+        case RoundingMode::HalfEven: {
+            const Int128 twice = remainder * 2;
+            carry = twice > denominator || (twice == denominator && (quotient & 1) != 0);
+            break;
+        }
+        case RoundingMode::HalfAwayFromZero:
+            carry = remainder * 2 >= denominator;
+            break;
+        case RoundingMode::TowardZero:
+            carry = false;
+            break;
+        case RoundingMode::AwayFromZero:
+            carry = true;
+            break;
+    }
+    if (!carry) {
+        return quotient;
+    }
+    return numerator < 0 ? quotient - 1 : quotient + 1;
+}
+
+// 把 value / 10^from_scale 舍入为 10^-to_scale 的整数倍
+[[nodiscard]] std::optional<Decimal> fromWide(Int128 value, int32_t from_scale, int32_t to_scale,
+                                              RoundingMode mode) noexcept {
+    if (!validScale(to_scale)) {
+        return std::nullopt;
+    }
+    if (to_scale >= from_scale) {
+        if (!fitsInt64(value)) {
+            return std::nullopt;
+        }
+        value *= kPow10[static_cast<size_t>(to_scale - from_scale)];
+    } else {
+        value = divideRounded(value, kPow10[static_cast<size_t>(from_scale - to_scale)], mode);
+    }
+    if (!fitsInt64(value)) {
+        return std::nullopt;
+    }
+    return Decimal(static_cast<int64_t>(value), to_scale);
+}
+
+// |value| = digits * 10^exponent，digits 为最短往返表示的全部有效数字（不超过 17 位）
+struct DecimalDigits {
+    int64_t digits{0};
+    int32_t exponent{0};
+    bool negative{false};
+};
+
+[[nodiscard]] bool shortestDigits(double value, DecimalDigits& out) noexcept {
+    if (!std::isfinite(value)) {
+        return false;
+    }
+    // 形如 "-d.ddddde+XX"
+    char buffer[32];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::scientific);
+    if (result.ec != std::errc{}) {
+        return false;
+    }
+
+    const char* p = buffer;
+    out.negative = *p == '-';
+    if (out.negative) {
+        ++p;
+    }
+    int32_t fraction_digits = 0;
+    bool in_fraction = false;
+    out.digits = 0;
+    for (; p < result.ptr && *p != 'e'; ++p) {
+        if (*p == '.') {
+            in_fraction = true;
+            continue;
+        }
+        out.digits = out.digits * 10 + (*p - '0');
+        fraction_digits += in_fraction ? 1 : 0;
+    }
+
+    int32_t exponent = 0;
+    if (p < result.ptr) {
+        ++p;  // 'e'
+        const bool negative_exponent = *p == '-';
+        for (++p; p < result.ptr; ++p) {
+            exponent = exponent * 10 + (*p - '0');
+        }
+        exponent = negative_exponent ? -exponent : exponent;
+    }
+    out.exponent = exponent - fraction_digits;
+    return true;
+}
+
+// digits * 10^exponent 按 mode 舍入为 10^-scale 的整数倍（scale 可为负），返回带符号的倍数
+[[nodiscard]] std::optional<Int128> scaleDigits(const DecimalDigits& value, int32_t scale,
+                                                RoundingMode mode) noexcept {
+    Int128 magnitude = 0;
+    const int32_t shift = value.exponent + scale;
+    if (value.digits == 0) {
+        magnitude = 0;
+    } else if (shift >= 0) {
+        // digits < 10^17，放大超过 10^20 时必然超出 int64
+        if (shift > 20) {
+            return std::nullopt;
+        }
+        magnitude = value.digits * kPow10[static_cast<size_t>(shift)];
+    } else if (-shift <= 20) {
+        magnitude = divideRounded(value.digits, kPow10[static_cast<size_t>(-shift)], mode);
+    } else {
+        // 远小于舍入单位的一半：只有 AwayFromZero 会进位
+        magnitude = mode == RoundingMode::AwayFromZero ? 1 : 0;
+    }
+    return value.negative ? -magnitude : magnitude;
+}
+
+// 符号 + 19 位数字 + "0." + 18 位小数
+constexpr size_t kMaxFormattedSize = 48;
+
+// 定点格式写入 out，返回长度
+size_t formatDecimal(int64_t mantissa, int32_t scale_value, char* out) noexcept {
+    const uint64_t magnitude = mantissa < 0 ? 0 - static_cast<uint64_t>(mantissa) : static_cast<uint64_t>(mantissa);
+    char digits[24];
+    const auto end = std::to_chars(digits, digits + sizeof(digits), magnitude).ptr;
+    const auto length = static_cast<size_t>(end - digits);
+    const auto scale = static_cast<size_t>(scale_value);
+
+    char* p = out;
+    if (mantissa < 0) {
+        *p++ = '-';
+    }
+    if (length <= scale) {
+        // 整数部分为 0，小数部分左侧补 0
+        *p++ = '0';
+        *p++ = '.';
+        p = std::fill_n(p, scale - length, '0');
+        p = std::copy(digits, end, p);
+    } else {
+        p = std::copy(digits, end - scale, p);
+        if (scale > 0) {
+            *p++ = '.';
+            p = std::copy(end - scale, end, p);
+        }
+    }
+    return static_cast<size_t>(p - out);
+}
+
+} // namespace
+
+std::optional<Decimal> Decimal::from_double(double value, int32_t scale, RoundingMode mode) noexcept {
+    DecimalDigits digits;
+    if (!validScale(scale) || !shortestDigits(value, digits)) {
+        return std::nullopt;
+    }
+    const auto mantissa = scaleDigits(digits, scale, mode);
+    if (!mantissa || !fitsInt64(*mantissa)) {
+        return std::nullopt;
+    }
+    return Decimal(static_cast<int64_t>(*mantissa), scale);
+}
+
+std::optional<Decimal> Decimal::from_string(std::string_view str) noexcept {
+    size_t pos = 0;
+    const bool negative = !str.empty() && str[0] == '-';
+    if (!str.empty() && (str[0] == '-' || str[0] == '+')) {
+        ++pos;
+    }
+
+    Int128 mantissa = 0;
+    int32_t scale = 0;
+    size_t integer_digits = 0;
+    for (; pos < str.size() && str[pos] >= '0' && str[pos] <= '9'; ++pos, ++integer_digits) {
+        mantissa = mantissa * 10 + (str[pos] - '0');
+        if (mantissa > std::numeric_limits<int64_t>::max() + Int128{1}) {
+            return std::nullopt;
+        }
+    }
+    if (integer_digits == 0) {
+        return std::nullopt;
+    }
+    if (pos < str.size() && str[pos] == '.') {
+        ++pos;
+        for (; pos < str.size() && str[pos] >= '0' && str[pos] <= '9'; ++pos) {
+            if (++scale > kMaxScale) {
+                return std::nullopt;
+            }
+            mantissa = mantissa * 10 + (str[pos] - '0');
+            if (mantissa > std::numeric_limits<int64_t>::max() + Int128{1}) {
+                return std::nullopt;
+            }
+        }
+        if (scale == 0) {
+            return std::nullopt;
+        }
+    }
+    if (pos != str.size()) {
+        return std::nullopt;
+    }
+
+    mantissa = negative ? -mantissa : mantissa;
+    if (!fitsInt64(mantissa)) {
+        return std::nullopt;
+    }
+    return Decimal(static_cast<int64_t>(mantissa), scale);
+}
+
+double Decimal::to_double() const noexcept {
+    constexpr int64_t kExactLimit = int64_t{1} << 53;
+    if (mantissa_ >= -kExactLimit && mantissa_ <= kExactLimit) {
+        // 两个操作数都可精确表示，IEEE 除法保证结果正确舍入
+        return static_cast<double>(mantissa_) / kPow10Double[static_cast<size_t>(scale_)];
+    }
+
+    // 尾数超过 2^53 时经十进制字符串解析，避免两次舍入
+    char buffer[kMaxFormattedSize];
+    const size_t length = formatDecimal(mantissa_, scale_, buffer);
+    double result = 0;
+    std::from_chars(buffer, buffer + length, result);
+    return result;
+}
+
+std::string Decimal::to_string() const {
+    char buffer[kMaxFormattedSize];
+    return std::string(buffer, formatDecimal(mantissa_, scale_, buffer));
+}
+
+std::optional<Decimal> Decimal::rescale(int32_t scale, RoundingMode mode) const noexcept {
+    return fromWide(mantissa_, scale_, scale, mode);
+}
+
+std::optional<Decimal> Decimal::add(const Decimal& other) const noexcept {
+    const int32_t scale = std::max(scale_, other.scale_);
+    const Int128 sum = Int128{mantissa_} * kPow10[static_cast<size_t>(scale - scale_)] +
+                       Int128{other.mantissa_} * kPow10[static_cast<size_t>(scale - other.scale_)];
+    if (!fitsInt64(sum)) {
+        return std::nullopt;
+    }
+    return Decimal(static_cast<int64_t>(sum), scale);
+}
+
+std::optional<Decimal> Decimal::sub(const Decimal& other) const noexcept {
+    const int32_t scale = std::max(scale_, other.scale_);
+    const Int128 difference = Int128{mantissa_} * kPow10[static_cast<size_t>(scale - scale_)] -
+                              Int128{other.mantissa_} * kPow10[static_cast<size_t>(scale - other.scale_)];
+    if (!fitsInt64(difference)) {
+        return std::nullopt;
+    }
+    return Decimal(static_cast<int64_t>(difference), scale);
+}
+
+std::optional<Decimal> Decimal::mul(const Decimal& other, int32_t result_scale, RoundingMode mode) const noexcept {
+    // 两个 int64 的乘积不超过 2^126，128 位中精确
+    return fromWide(Int128{mantissa_} * other.mantissa_, scale_ + other.scale_, result_scale, mode);
+}
+
+std::optional<Decimal> Decimal::div(const Decimal& other, int32_t result_scale, RoundingMode mode) const noexcept {
+    if (other.mantissa_ == 0 || !validScale(result_scale)) {
+        return std::nullopt;
+    }
+
+    // 商的尾数 = (m1 / 10^s1) / (m2 / 10^s2) * 10^rs = m1 * 10^(rs + s2 - s1) / m2
+    Int128 numerator = mantissa_;
+    Int128 denominator = other.mantissa_;
+    const int32_t shift = result_scale + other.scale_ - scale_;
+    if (shift >= 0) {
+        const Int128 factor = kPow10[static_cast<size_t>(shift)];
+        // 被除数溢出 128 位时商必然超出 int64
+        if (abs128(numerator) > kInt128Max / factor) {
+            return std::nullopt;
+        }
+        numerator *= factor;
+    } else {
+        denominator *= kPow10[static_cast<size_t>(-shift)];
+    }
+    if (denominator < 0) {
+        numerator = -numerator;
+        denominator = -denominator;
+    }
+
+    const Int128 quotient = divideRounded(numerator, denominator, mode);
+    if (!fitsInt64(quotient)) {
+        return std::nullopt;
+    }
+    return Decimal(static_cast<int64_t>(quotient), result_scale);
+}
+
+std::strong_ordering Decimal::operator<=>(const Decimal& other) const noexcept {
+    const int32_t scale = std::max(scale_, other.scale_);
+    const Int128 lhs = Int128{mantissa_} * kPow10[static_cast<size_t>(scale - scale_)];
+    const Int128 rhs = Int128{other.mantissa_} * kPow10[static_cast<size_t>(scale - other.scale_)];
+    return lhs <=> rhs;
+}
+
+double roundExact(double value, int32_t ndigits, RoundingMode mode) noexcept {
+    DecimalDigits digits;
+    if (ndigits < -Decimal::kMaxScale || ndigits > Decimal::kMaxScale || !shortestDigits(value, digits)) {
+        return std::isfinite(value) ? roundEx(value, ndigits) : value;
+    }
+
+    const auto multiple = scaleDigits(digits, ndigits, mode);
+    if (!multiple || !fitsInt64(*multiple)) {
+        // 超出 int64 说明有效数字（最多 17 位）都在保留位数之内，舍入不改变数值
+        return value;
+    }
+
+    double result = 0;
+    if (ndigits >= 0) {
+        result = Decimal(static_cast<int64_t>(*multiple), ndigits).to_double();
+    } else {
+        result = static_cast<double>(*multiple) * kPow10Double[static_cast<size_t>(-ndigits)];
+    }
+    // 与 roundEx 一致，舍入为 0 时保留符号
+    return result == 0 ? std::copysign(0.0, value) : result;
+}
+
+} // namespace sequoia::utils
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <cassert>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace sequoia::utils {
+
+/**
+ * @brief 十进制舍入方式
+ */
+enum class RoundingMode : uint8_t {
+    HalfEven,          // 四舍六入五成双（银行家舍入）
+    HalfAwayFromZero,  // 四舍五入
+    TowardZero,        // 截断
+    AwayFromZero,      // 有余数即进位
+};
+
+/**
+ * @brief 定点十进制数：value = mantissa / 10^scale
+ *
+ * @details
+ * 1. 尾数为 int64，scale 取值 [0, kMaxScale]；乘除和对齐小数位在 128 位整数中精确计算
+ *    （scale 来自外部输入时使用 make 校验）
+ * 2. 舍入在十进制下精确进行，不存在 2.675 * 100 = 267.49999999999997 这类二进制误差
+ * 3. from_double 使用最短往返表示（std::to_chars）得到 double 的十进制数字后再舍入，
+ *    to_double 在尾数不超过 2^53 时一次除法得到正确舍入的结果
+ * 4. 运算溢出或参数非法时返回 std::nullopt，不抛异常
+ *
+ * @code
+ * auto price = Decimal::from_double(2.675, 3);        // 2.675
+ * auto rounded = price->rescale(2);                   // 2.68（五成双：7 为奇数，进位）
+ * auto total = price->mul(Decimal(3, 0), 2);          // 8.02
+ * @endcode
+ */
+class Decimal {
+public:
+    static constexpr int32_t kMaxScale = 18;
+
+    constexpr Decimal() noexcept = default;
+
+    /**
+     * @param mantissa 尾数
+     * @param scale 小数位数，必须在 [0, kMaxScale] 内（调试构建中断言）
+     */
+    constexpr Decimal(int64_t mantissa, int32_t scale) noexcept : mantissa_(mantissa), scale_(scale) {
+        assert(valid_scale(scale));
+    }
+
+    /**
+     * @brief 校验 scale 后构造
+     *
+     * @return std::optional<Decimal> scale 不在 [0, kMaxScale] 内时返回 std::nullopt
+     */
+    [[nodiscard]] static constexpr std::optional<Decimal> make(int64_t mantissa, int32_t scale) noexcept {
+        if (!valid_scale(scale)) {
+            return std::nullopt;
+        }
+        return Decimal(mantissa, scale);
+    }
+
+    [[nodiscard]] static constexpr bool valid_scale(int32_t scale) noexcept {
+        return scale >= 0 && scale <= kMaxScale;
+    }
+
+    /**
+     * @brief 由 double 构造，保留 scale 位小数
+     *
+     * @details 取 double 的最短往返十进制表示（即 printf 最短输出的那串数字），再按 mode 精确舍入，
+     * 因此 from_double(2.675, 2) 得到 2.68 而不是 2.67
+     * @return std::optional<Decimal> NaN、无穷、scale 越界或尾数溢出时返回 std::nullopt
+     */
+    [[nodiscard]] static std::optional<Decimal> from_double(double value, int32_t scale,
+                                                            RoundingMode mode = RoundingMode::HalfEven) noexcept;
+
+    /**
+     * @brief 解析 "[+-]digits[.digits]"，小数位数即为 scale
+     *
+     * @return std::optional<Decimal> 格式错误、小数位超过 kMaxScale 或溢出时返回 std::nullopt
+     */
+    [[nodiscard]] static std::optional<Decimal> from_string(std::string_view str) noexcept;
+
+    [[nodiscard]] constexpr int64_t mantissa() const noexcept {
+        return mantissa_;
+    }
+
+    [[nodiscard]] constexpr int32_t scale() const noexcept {
+        return scale_;
+    }
+
+    /**
+     * @brief 转为最接近的 double
+     */
+    [[nodiscard]] double to_double() const noexcept;
+
+    /**
+     * @brief 定点格式输出，保留全部 scale 位小数，如 Decimal(-1050, 3) 输出 "-1.050"
+     */
+    [[nodiscard]] std::string to_string() const;
+
+    /**
+     * @brief 调整小数位数，缩小时按 mode 精确舍入
+     *
+     * @return std::optional<Decimal> scale 越界或放大后溢出时返回 std::nullopt
+     */
+    [[nodiscard]] std::optional<Decimal> rescale(int32_t scale,
+                                                 RoundingMode mode = RoundingMode::HalfEven) const noexcept;
+
+    // 加减结果的小数位数取两者较大值，溢出时返回 std::nullopt
+    [[nodiscard]] std::optional<Decimal> add(const Decimal& other) const noexcept;
+    [[nodiscard]] std::optional<Decimal> sub(const Decimal& other) const noexcept;
+
+    /**
+     * @brief 乘法，精确乘积按 mode 舍入到 result_scale 位小数
+     */
+    [[nodiscard]] std::optional<Decimal> mul(const Decimal& other, int32_t result_scale,
+                                             RoundingMode mode = RoundingMode::HalfEven) const noexcept;
+
+    /**
+     * @brief 除法，商按 mode 舍入到 result_scale 位小数
+     *
+     * @return std::optional<Decimal> 除数为 0 或溢出时返回 std::nullopt
+     */
+    [[nodiscard]] std::optional<Decimal> div(const Decimal& other, int32_t result_scale,
+                                             RoundingMode mode = RoundingMode::HalfEven) const noexcept;
+
+    // 取反，尾数为 INT64_MIN 时溢出返回 std::nullopt
+    [[nodiscard]] constexpr std::optional<Decimal> neg() const noexcept {
+        if (mantissa_ == std::numeric_limits<int64_t>::min()) {
+            return std::nullopt;
+        }
+        return Decimal(-mantissa_, scale_);
+    }
+
+    // 按数值比较，与小数位数无关：Decimal(150, 2) == Decimal(15, 1)
+    [[nodiscard]] std::strong_ordering operator<=>(const Decimal& other) const noexcept;
+
+    [[nodiscard]] bool operator==(const Decimal& other) const noexcept {
+        return (*this <=> other) == std::strong_ordering::equal;
+    }
+
+private:
+    int64_t mantissa_{0};
+    int32_t scale_{0};
+};
+
+/**
+ * @brief 按十进制精确舍入 double，保留 ndigits 位小数（默认银行家舍入）
+ *
+ * @details 与 roundEx 不同，舍入作用于 double 的最短往返十进制表示：roundExact(2.675, 2) == 2.68；
+ * ndigits 超出 [0, Decimal::kMaxScale] 或数值超出 int64 尾数范围时退化为 roundEx 的结果
+ */
+[[nodiscard]] double roundExact(double value, int32_t ndigits = 0,
+                                RoundingMode mode = RoundingMode::HalfEven) noexcept;
+
+} // namespace sequoia::utils
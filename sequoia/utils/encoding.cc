@@ -0,0 +1,489 @@
+#include "encoding.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iconv.h>
+#include <vector>
+
+namespace sequoia::utils {
+
+namespace detail {
+
+const iconv_t kInvalidDescriptor = reinterpret_cast<iconv_t>(-1);
+
+// RAII 包装器：自动管理 iconv 资源生命周期
+class IconvConverter {
+public:
+    IconvConverter(const char* to_code, const char* from_code) noexcept
+        : cd_(iconv_open(to_code, from_code)) {}
+
+    ~IconvConverter() noexcept {
+        if (is_valid()) {
+            iconv_close(cd_);
+        }
+    }
+
+    // 禁用拷贝，允许移动（C++20 移动语义优化）
+    IconvConverter(const IconvConverter&) = delete;
+    IconvConverter& operator=(const IconvConverter&) = delete;
+
+    IconvConverter(IconvConverter&& other) noexcept : cd_(other.cd_) {
+        other.cd_ = kInvalidDescriptor;
+    }
+
+    IconvConverter& operator=(IconvConverter&& other) noexcept {
+        if (this != &other) {
+            if (is_valid()) {
+                iconv_close(cd_);
+            }
+            cd_ = other.cd_;
+            other.cd_ = kInvalidDescriptor;
+        }
+        return *this;
+    }
+
+    [[nodiscard]] bool is_valid() const noexcept {
+        return cd_ != kInvalidDescriptor;
+    }
+
+    [[nodiscard]] iconv_t get() const noexcept {
+        return cd_;
+    }
+
+    // 重置为初始移位状态，复用描述符前调用
+    void reset() noexcept {
+        iconv(cd_, nullptr, nullptr, nullptr, nullptr);
+    }
+
+private:
+    iconv_t cd_;
+};
+
+// 线程局部的 iconv 描述符缓存，按 (to, from) 查找，超出容量时淘汰最早创建的项
+class IconvCache {
+public:
+    static constexpr size_t kMaxEntries = 8;
+
+    // 返回已重置的描述符，编码不支持时返回 nullptr
+    [[nodiscard]] IconvConverter* get(const char* to_code, const char* from_code) {
+        for (auto& entry : entries_) {
+            if (entry.to == to_code && entry.from == from_code) {
+                entry.converter.reset();
+                return &entry.converter;
+            }
+        }
+
+        IconvConverter converter(to_code, from_code);
+        if (!converter.is_valid()) {
+            return nullptr;
+        }
+        if (entries_.size() == kMaxEntries) {
+            entries_.erase(entries_.begin());
+        }
+        return &entries_.emplace_back(Entry{to_code, from_code, std::move(converter)}).converter;
+    }
+
+private:
+    struct Entry {
+        std::string to;
+        std::string from;
+        IconvConverter converter;
+    };
+
+    std::vector<Entry> entries_;
+};
+
+[[nodiscard]] IconvConverter* cached_converter(const char* to_code, const char* from_code) {
+    thread_local IconvCache cache;
+    return cache.get(to_code, from_code);
+}
+
+enum class ConvertStatus {
+    Ok,
+    Incomplete,  // 输入末尾是不完整的多字节序列
+    Invalid,     // 非法序列
+};
+
+/**
+ * @brief 转换 input 并追加到 out，输出空间不足（E2BIG）时扩容后继续
+ *
+ * @param consumed 已转换的输入字节数
+ */
+ConvertStatus convert_append(iconv_t cd, std::string_view input, std::string& out, size_t& consumed) {
+    // iconv 需要非 const 指针，但不会修改输入数据
+    char* in_buf = const_cast<char*>(input.data());
+    size_t in_left = input.size();
+    ConvertStatus status = ConvertStatus::Ok;
+
+    while (in_left > 0) {
+        // 按剩余输入的 2 倍预留输出空间，GBK/UTF-8 之间通常一次即可完成
+        const size_t old_size = out.size();
+        out.resize(old_size + std::max<size_t>(in_left * 2, 16));
+        char* out_buf = out.data() + old_size;
+        size_t out_left = out.size() - old_size;
+
+        const size_t ret = iconv(cd, &in_buf, &in_left, &out_buf, &out_left);
+        out.resize(out.size() - out_left);
+        if (ret != static_cast<size_t>(-1)) {
+            break;
+        }
+        if (errno == E2BIG) {
+            continue;
+        }
+        status = errno == EINVAL ? ConvertStatus::Incomplete : ConvertStatus::Invalid;
+        break;
+    }
+
+    consumed = input.size() - in_left;
+    return status;
+}
+
+} // namespace detail
+
+std::optional<size_t> convert_encoding(std::string_view input, std::span<char> out,
+                                       const char* to_encoding, const char* from_encoding) noexcept {
+    if (input.empty()) {
+        return 0;
+    }
+
+    detail::IconvConverter* converter = nullptr;
+    try {
+        converter = detail::cached_converter(to_encoding, from_encoding);
+    } catch (...) {
+        return std::nullopt;
+    }
+    if (converter == nullptr) {
+        return std::nullopt;
+    }
+
+    char* in_buf = const_cast<char*>(input.data());
+    size_t in_left = input.size();
+    char* out_buf = out.data();
+    size_t out_left = out.size();
+
+    if (iconv(converter->get(), &in_buf, &in_left, &out_buf, &out_left) == static_cast<size_t>(-1)) {
+        return std::nullopt;
+    }
+    return out.size() - out_left;
+}
+
+std::optional<std::string> convert_encoding(std::string_view input, const char* to_encoding,
+                                            const char* from_encoding) {
+    if (input.empty()) {
+        return std::string{};
+    }
+
+    detail::IconvConverter* converter = detail::cached_converter(to_encoding, from_encoding);
+    if (converter == nullptr) {
+        return std::nullopt;
+    }
+
+    std::string result;
+    size_t consumed = 0;
+    if (detail::convert_append(converter->get(), input, result, consumed) != detail::ConvertStatus::Ok) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+namespace {
+
+using NativeTranscoder = detail::TranscodeResult (*)(std::string_view, std::span<char>) noexcept;
+
+// 输出空间不足时按 1.5 倍扩容，从中断处继续转换
+std::optional<std::string> transcode(std::string_view input, size_t initial_size, NativeTranscoder transcoder) {
+    std::string result(initial_size, '\0');
+    size_t read = 0;
+    size_t written = 0;
+    while (true) {
+        const auto status = transcoder(input.substr(read), std::span<char>(result).subspan(written));
+        read += status.read;
+        written += status.written;
+        if (status.status == detail::TranscodeStatus::Ok) {
+            break;
+        }
+        if (status.status != detail::TranscodeStatus::OutputFull) {
+            return std::nullopt;
+        }
+        result.resize(result.size() + result.size() / 2 + 16);
+    }
+    result.resize(written);
+    return result;
+}
+
+} // namespace
+
+std::string utf8_to_gbk(std::string_view str) {
+    // GBK 编码长度不超过 UTF-8，一次分配即可
+    auto result = transcode(str, str.size(), detail::utf8_to_gbk_native);
+    return result ? std::move(*result) : std::string{str};  // 转换失败，返回原字符串
+}
+
+std::string gbk_to_utf8(std::string_view str) {
+    // 双字节字符转为 3 字节，按 1.5 倍预分配
+    auto result = transcode(str, str.size() + str.size() / 2, detail::gbk_to_utf8_native);
+    return result ? std::move(*result) : std::string{str};  // 转换失败，返回原字符串
+}
+
+std::optional<size_t> utf8_to_gbk(std::string_view str, std::span<char> out) noexcept {
+    const auto result = detail::utf8_to_gbk_native(str, out);
+    if (result.status != detail::TranscodeStatus::Ok) {
+        return std::nullopt;
+    }
+    return result.written;
+}
+
+std::optional<size_t> gbk_to_utf8(std::string_view str, std::span<char> out) noexcept {
+    const auto result = detail::gbk_to_utf8_native(str, out);
+    if (result.status != detail::TranscodeStatus::Ok) {
+        return std::nullopt;
+    }
+    return result.written;
+}
+
+namespace {
+
+std::string transcode_with_policy(std::string_view str, TranscodeDirection direction, InvalidPolicy policy,
+                                  std::vector<TranscodeError>* errors) {
+    Transcoder transcoder(direction, policy);
+    std::string result;
+    result.reserve(direction == TranscodeDirection::GbkToUtf8 ? str.size() + str.size() / 2 : str.size());
+    if (transcoder.feed(str, result)) {
+        transcoder.finish(result);
+    }
+    if (errors != nullptr) {
+        *errors = transcoder.errors();
+    }
+    return result;
+}
+
+} // namespace
+
+std::string utf8_to_gbk(std::string_view str, InvalidPolicy policy, std::vector<TranscodeError>* errors) {
+    return transcode_with_policy(str, TranscodeDirection::Utf8ToGbk, policy, errors);
+}
+
+std::string gbk_to_utf8(std::string_view str, InvalidPolicy policy, std::vector<TranscodeError>* errors) {
+    return transcode_with_policy(str, TranscodeDirection::GbkToUtf8, policy, errors);
+}
+
+// ==================== Transcoder ====================
+
+Transcoder::Transcoder(TranscodeDirection direction, InvalidPolicy policy, std::string_view replacement)
+    : direction_(direction), policy_(policy), replacement_(replacement) {
+    if (replacement_.empty()) {
+        replacement_ = direction == TranscodeDirection::GbkToUtf8 ? "\xEF\xBF\xBD" : "?";
+    }
+}
+
+bool Transcoder::on_invalid(size_t offset, size_t length, std::string& out) {
+    if (errors_.size() < kMaxRecordedErrors) {
+        errors_.push_back({offset, length});
+    }
+    ++error_count_;
+
+    switch (policy_) {
+        case InvalidPolicy::Fail:
+            failed_ = true;
+            return false;
+        case InvalidPolicy::Replace:
+            out += replacement_;
+            break;
+        case InvalidPolicy::Skip:
+            break;
+    }
+    return true;
+}
+
+size_t Transcoder::process(std::string_view input, size_t base, std::string& out, bool final) {
+    const NativeTranscoder transcoder = direction_ == TranscodeDirection::GbkToUtf8 ? detail::gbk_to_utf8_native
+                                                                                    : detail::utf8_to_gbk_native;
+    size_t pos = 0;
+    while (pos < input.size()) {
+        // 按剩余输入的 1.5 倍预留输出空间，不足时扩容后继续
+        const size_t left = input.size() - pos;
+        const size_t old_size = out.size();
+        out.resize(old_size + left + left / 2 + 16);
+        const auto result = transcoder(input.substr(pos), std::span<char>(out).subspan(old_size));
+        out.resize(old_size + result.written);
+        pos += result.read;
+
+        switch (result.status) {
+            case detail::TranscodeStatus::Ok:
+            case detail::TranscodeStatus::OutputFull:
+                break;
+            case detail::TranscodeStatus::Incomplete:
+                if (!final) {
+                    return pos;
+                }
+                [[fallthrough]];
+            case detail::TranscodeStatus::Invalid:
+                if (!on_invalid(base + pos, result.error_length, out)) {
+                    return pos;
+                }
+                pos += result.error_length;
+                break;
+        }
+    }
+    return pos;
+}
+
+bool Transcoder::feed(std::string_view chunk, std::string& out) {
+    if (failed_) {
+        return false;
+    }
+
+    // 先用下一块的开头补全上次暂存的不完整序列
+    if (pending_size_ > 0) {
+        char buffer[kMaxPendingSize * 2];
+        const size_t old_pending = pending_size_;
+        const size_t take = std::min(chunk.size(), sizeof(buffer) - old_pending);
+        std::memcpy(buffer, pending_, old_pending);
+        std::memcpy(buffer + old_pending, chunk.data(), take);
+
+        const size_t consumed = process(std::string_view(buffer, old_pending + take), offset_, out, false);
+        if (failed_) {
+            return false;
+        }
+        if (consumed < old_pending) {
+            // 补全后仍不完整：只有本块输入不足时才可能发生
+            std::memcpy(pending_, buffer + consumed, old_pending + take - consumed);
+            pending_size_ = old_pending + take - consumed;
+            offset_ += consumed;
+            return true;
+        }
+        pending_size_ = 0;
+        offset_ += consumed;
+        chunk.remove_prefix(consumed - old_pending);
+    }
+
+    const size_t consumed = process(chunk, offset_, out, false);
+    if (failed_) {
+        return false;
+    }
+
+    // 剩余部分是不完整的序列，暂存到下一块
+    pending_size_ = chunk.size() - consumed;
+    std::memcpy(pending_, chunk.data() + consumed, pending_size_);
+    offset_ += consumed;
+    return true;
+}
+
+bool Transcoder::finish(std::string& out) {
+    if (failed_) {
+        return false;
+    }
+    if (pending_size_ > 0) {
+        process(std::string_view(pending_, pending_size_), offset_, out, true);
+        if (failed_) {
+            return false;
+        }
+        offset_ += pending_size_;
+        pending_size_ = 0;
+    }
+    return true;
+}
+
+void Transcoder::reset() noexcept {
+    errors_.clear();
+    error_count_ = 0;
+    offset_ = 0;
+    pending_size_ = 0;
+    failed_ = false;
+}
+
+// ==================== StreamingConverter ====================
+
+StreamingConverter::StreamingConverter(const char* to_encoding, const char* from_encoding) noexcept
+    : cd_(iconv_open(to_encoding, from_encoding)) {}
+
+StreamingConverter::~StreamingConverter() noexcept {
+    if (is_valid()) {
+        iconv_close(static_cast<iconv_t>(cd_));
+    }
+}
+
+bool StreamingConverter::is_valid() const noexcept {
+    return static_cast<iconv_t>(cd_) != detail::kInvalidDescriptor;
+}
+
+bool StreamingConverter::convert_block(std::string_view input, std::string& out, size_t& consumed) {
+    const auto status = detail::convert_append(static_cast<iconv_t>(cd_), input, out, consumed);
+    if (status == detail::ConvertStatus::Invalid) {
+        failed_ = true;
+        return false;
+    }
+    return true;
+}
+
+bool StreamingConverter::convert(std::string_view chunk, std::string& out) {
+    if (!is_valid() || failed_) {
+        return false;
+    }
+
+    // 先用下一块的开头补全上次暂存的不完整序列
+    if (pending_size_ > 0) {
+        const size_t old_pending = pending_size_;
+        const size_t take = std::min(chunk.size(), kMaxPendingSize - old_pending);
+        std::memcpy(pending_ + old_pending, chunk.data(), take);
+
+        size_t consumed = 0;
+        if (!convert_block(std::string_view(pending_, old_pending + take), out, consumed)) {
+            return false;
+        }
+        if (consumed < old_pending) {
+            // 补全后仍不完整：只有输入不足时才可能发生
+            if (take < chunk.size()) {
+                failed_ = true;
+                return false;
+            }
+            std::memmove(pending_, pending_ + consumed, old_pending + take - consumed);
+            pending_size_ = old_pending + take - consumed;
+            return true;
+        }
+        pending_size_ = 0;
+        chunk.remove_prefix(consumed - old_pending);
+    }
+
+    size_t consumed = 0;
+    if (!convert_block(chunk, out, consumed)) {
+        return false;
+    }
+
+    // 剩余部分是不完整的序列，暂存到下一块
+    const size_t rest = chunk.size() - consumed;
+    if (rest > kMaxPendingSize) {
+        failed_ = true;
+        return false;
+    }
+    std::memcpy(pending_, chunk.data() + consumed, rest);
+    pending_size_ = rest;
+    return true;
+}
+
+bool StreamingConverter::finish(std::string& out) {
+    if (!is_valid() || failed_ || pending_size_ > 0) {
+        return false;
+    }
+
+    // 有状态编码需要输出复位序列
+    char buffer[16];
+    char* out_buf = buffer;
+    size_t out_left = sizeof(buffer);
+    if (iconv(static_cast<iconv_t>(cd_), nullptr, nullptr, &out_buf, &out_left) == static_cast<size_t>(-1)) {
+        return false;
+    }
+    out.append(buffer, sizeof(buffer) - out_left);
+    return true;
+}
+
+void StreamingConverter::reset() noexcept {
+    if (is_valid()) {
+        iconv(static_cast<iconv_t>(cd_), nullptr, nullptr, nullptr, nullptr);
+    }
+    pending_size_ = 0;
+    failed_ = false;
+}
+
+} // namespace sequoia::utils
@@ -0,0 +1,379 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sequoia::utils {
+
+namespace detail {
+
+enum class TranscodeStatus {
+    Ok,
+    OutputFull,  // 输出缓冲区不足
+    Incomplete,  // 输入末尾是不完整的多字节序列
+    Invalid,     // 非法或无法映射的序列
+};
+
+struct TranscodeResult {
+    TranscodeStatus status;
+    size_t read;     // 已转换的输入字节数（停止时指向出错或不完整序列的起点）
+    size_t written;  // 写入的输出字节数
+    size_t error_length{0};  // Invalid 时为需要跳过的字节数，Incomplete 时为剩余的字节数
+};
+
+/**
+ * @brief 内置的 GBK -> UTF-8 转换（查表实现，ASCII 连续段由 SIMD 批量复制）
+ *
+ * @note 映射表由 gbk_table.py 离线生成（与 glibc iconv 的 GBK 一致：0x80 为欧元符号，用户自定义区视为非法）
+ */
+[[nodiscard]] TranscodeResult gbk_to_utf8_native(std::string_view input, std::span<char> out) noexcept;
+
+/**
+ * @brief 内置的 UTF-8 -> GBK 转换（查表实现，ASCII 连续段由 SIMD 批量复制）
+ */
+[[nodiscard]] TranscodeResult utf8_to_gbk_native(std::string_view input, std::span<char> out) noexcept;
+
+/**
+ * @brief 解码一个非 ASCII 的 UTF-8 序列（RFC 3629：拒绝过长编码、代理项和超出 U+10FFFF 的码位）
+ *
+ * @param available in 中可读的字节数，序列超出时返回 Incomplete
+ * @param length 合法时为序列的完整长度，非法时为需要跳过的字节数（最长合法前缀，至少为 1）
+ */
+inline TranscodeStatus decode_utf8(const unsigned char* in, size_t available, uint32_t& code_point, size_t& length) noexcept {
+    const unsigned char lead = in[0];
+    uint32_t min_code_point = 0;
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        length = 2;
+        code_point = lead & 0x1F;
+        min_code_point = 0x80;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        length = 3;
+        code_point = lead & 0x0F;
+        min_code_point = 0x800;
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        length = 4;
+        code_point = lead & 0x07;
+        min_code_point = 0x10000;
+    } else {
+        length = 1;
+        return TranscodeStatus::Invalid;
+    }
+
+    for (size_t i = 1; i < length; ++i) {
+        if (i >= available) {
+            return TranscodeStatus::Incomplete;
+        }
+        if ((in[i] & 0xC0) != 0x80) {
+            length = i;
+            return TranscodeStatus::Invalid;
+        }
+        code_point = (code_point << 6) | (in[i] & 0x3F);
+        // 尽早拒绝过长编码、代理项和超范围码位，使截断的非法前缀不会被当作不完整序列
+        if (i == 1) {
+            const uint32_t shift = 6 * static_cast<uint32_t>(length - 2);
+            const uint32_t prefix_max = 0x10FFFF >> shift;
+            const uint32_t prefix_min = min_code_point >> shift;
+            const bool surrogate = length == 3 && code_point >= (0xD800 >> 6) && code_point <= (0xDFFF >> 6);
+            if (code_point < prefix_min || code_point > prefix_max || surrogate) {
+                length = 1;
+                return TranscodeStatus::Invalid;
+            }
+        }
+    }
+    return TranscodeStatus::Ok;
+}
+
+/**
+ * @brief 返回开头连续 ASCII 字节的长度
+ */
+[[nodiscard]] size_t ascii_prefix(std::string_view input) noexcept;
+
+/**
+ * @brief 复制开头连续的 ASCII 字节，返回复制的字节数（不超过 out.size()）
+ *
+ * @note 可能写入 out 中超出返回值的部分
+ */
+[[nodiscard]] size_t copy_ascii(std::string_view input, std::span<char> out) noexcept;
+
+/**
+ * @brief 返回开头连续 ASCII 字节的长度，并把其中可打印字符（0x20~0x7E）的个数累加到 width
+ */
+[[nodiscard]] size_t ascii_width_prefix(std::string_view input, size_t& width) noexcept;
+
+} // namespace detail
+
+/**
+ * @brief UTF-8 转 GBK，转换失败时返回原字符串
+ */
+std::string utf8_to_gbk(std::string_view str);
+
+/**
+ * @brief GBK 转 UTF-8，转换失败时返回原字符串
+ */
+std::string gbk_to_utf8(std::string_view str);
+
+/**
+ * @brief UTF-8 转 GBK，写入调用方提供的缓冲区（不分配内存）
+ *
+ * @param str 输入字符串
+ * @param out 输出缓冲区，长度为 str.size() 时一定足够
+ * @return std::optional<size_t> 写入的字节数，含非法序列或缓冲区不足时返回 std::nullopt
+ */
+[[nodiscard]] std::optional<size_t> utf8_to_gbk(std::string_view str, std::span<char> out) noexcept;
+
+/**
+ * @brief GBK 转 UTF-8，写入调用方提供的缓冲区（不分配内存）
+ *
+ * @param str 输入字符串
+ * @param out 输出缓冲区，长度为 str.size() * 3 时一定足够（双字节字符最多转为 3 字节，单字节 0x80 转为 3 字节的 €）
+ * @return std::optional<size_t> 写入的字节数，含非法序列或缓冲区不足时返回 std::nullopt
+ */
+[[nodiscard]] std::optional<size_t> gbk_to_utf8(std::string_view str, std::span<char> out) noexcept;
+
+/**
+ * @brief 检查是否为合法的 UTF-8（RFC 3629：拒绝过长编码、代理项、超出 U+10FFFF 的码位和被截断的序列）
+ *
+ * @note AVX2 下使用 simdutf 的查表算法每次校验 32 字节，无需 iconv 也不复制数据
+ */
+[[nodiscard]] bool is_valid_utf8(std::string_view str) noexcept;
+
+/**
+ * @brief 查找第一个非法或被截断的 UTF-8 序列
+ *
+ * @return std::optional<size_t> 非法序列的起始偏移，合法时返回 std::nullopt
+ */
+[[nodiscard]] std::optional<size_t> find_invalid_utf8(std::string_view str) noexcept;
+
+/**
+ * @brief 统计 UTF-8 字符串的码位个数
+ *
+ * @note 按非后续字节（10xxxxxx 以外）计数，不做校验；非法输入的结果与逐字节替换后的字符数不一定相同
+ */
+[[nodiscard]] size_t utf8_length(std::string_view str) noexcept;
+
+/**
+ * @brief UTF-8 文本在等宽终端中的显示宽度
+ *
+ * @details
+ * 1. 东亚宽字符（East Asian Width 为 W/F，如汉字、全角符号、大部分 emoji）计为 2
+ * 2. 组合字符、零宽字符和控制字符计为 0
+ * 3. 非法序列按替换字符计为 1
+ */
+[[nodiscard]] size_t utf8_display_width(std::string_view str) noexcept;
+
+/**
+ * @brief 非法序列（含输入末尾被截断的序列）的处理方式
+ */
+enum class InvalidPolicy : uint8_t {
+    Fail,     // 停止转换，保留此前已转换的输出
+    Replace,  // 替换为替换字符（UTF-8 目标为 U+FFFD，GBK 目标为 '?'）
+    Skip,     // 丢弃非法字节
+};
+
+/**
+ * @brief 非法序列的位置
+ */
+struct TranscodeError {
+    size_t offset;  // 在输入中的起始偏移（流式转换时为整个流中的偏移）
+    size_t length;  // 字节数（UTF-8 按最长合法前缀计，一个非法序列对应一个替换字符）
+};
+
+enum class TranscodeDirection : uint8_t {
+    Utf8ToGbk,
+    GbkToUtf8,
+};
+
+/**
+ * @brief UTF-8 转 GBK，按 policy 处理非法序列
+ *
+ * @param errors 非空时写入非法序列的位置（最多记录 Transcoder::kMaxRecordedErrors 个）
+ * @return std::string 转换结果；InvalidPolicy::Fail 时为第一个非法序列之前的转换结果
+ */
+std::string utf8_to_gbk(std::string_view str, InvalidPolicy policy, std::vector<TranscodeError>* errors = nullptr);
+
+/**
+ * @brief GBK 转 UTF-8，按 policy 处理非法序列
+ *
+ * @param errors 非空时写入非法序列的位置（最多记录 Transcoder::kMaxRecordedErrors 个）
+ * @return std::string 转换结果；InvalidPolicy::Fail 时为第一个非法序列之前的转换结果
+ */
+std::string gbk_to_utf8(std::string_view str, InvalidPolicy policy, std::vector<TranscodeError>* errors = nullptr);
+
+/**
+ * @brief 通用编码转换，写入调用方提供的缓冲区（不分配内存）
+ *
+ * @param input 输入字符串
+ * @param out 输出缓冲区
+ * @param to_encoding 目标编码（iconv 名称）
+ * @param from_encoding 源编码（iconv 名称）
+ * @return std::optional<size_t> 写入的字节数，编码不支持、含非法序列或缓冲区不足时返回 std::nullopt
+ *
+ * @note iconv 描述符按 (to, from) 缓存在线程局部存储中，每次使用前重置状态
+ */
+[[nodiscard]] std::optional<size_t> convert_encoding(std::string_view input, std::span<char> out,
+                                                     const char* to_encoding,
+                                                     const char* from_encoding) noexcept;
+
+/**
+ * @brief 通用编码转换，输出缓冲区不足时自动扩容
+ *
+ * @return std::optional<std::string> 转换结果，编码不支持或含非法序列时返回 std::nullopt
+ */
+[[nodiscard]] std::optional<std::string> convert_encoding(std::string_view input,
+                                                          const char* to_encoding,
+                                                          const char* from_encoding);
+
+/**
+ * @brief 流式编码转换器，适用于分块读取的大文件或网络数据
+ *
+ * @details
+ * 1. 每块输入的转换结果追加到输出字符串，输出空间不足（E2BIG）时扩容后继续
+ * 2. 块末尾不完整的多字节序列暂存，与下一块拼接后再转换
+ * 3. 独占一个 iconv 描述符，不使用线程局部缓存，不可跨线程共享
+ *
+ * @code
+ * StreamingConverter converter("UTF-8", "GBK");
+ * std::string out;
+ * while (read(chunk)) {
+ *     if (!converter.convert(chunk, out)) { ... }
+ * }
+ * converter.finish(out);
+ * @endcode
+ */
+class StreamingConverter {
+public:
+    StreamingConverter(const char* to_encoding, const char* from_encoding) noexcept;
+    ~StreamingConverter() noexcept;
+
+    StreamingConverter(const StreamingConverter&) = delete;
+    StreamingConverter& operator=(const StreamingConverter&) = delete;
+
+    // 编码是否受支持
+    [[nodiscard]] bool is_valid() const noexcept;
+
+    /**
+     * @brief 转换一块输入，结果追加到 out
+     *
+     * @return false 表示遇到非法序列，此后需 reset() 才能继续使用
+     */
+    bool convert(std::string_view chunk, std::string& out);
+
+    /**
+     * @brief 结束转换，输出移位状态的复位序列
+     *
+     * @return false 表示仍有未完成的多字节序列（输入被截断）
+     */
+    bool finish(std::string& out);
+
+    // 清空暂存数据并重置转换状态
+    void reset() noexcept;
+
+    // 暂存的不完整序列的字节数
+    [[nodiscard]] size_t pending_size() const noexcept {
+        return pending_size_;
+    }
+
+private:
+    // 多字节序列最长 4 字节（GB18030 / UTF-8），暂存区留出余量
+    static constexpr size_t kMaxPendingSize = 8;
+
+    bool convert_block(std::string_view input, std::string& out, size_t& consumed);
+
+    void* cd_;
+    char pending_[kMaxPendingSize]{};
+    size_t pending_size_{0};
+    bool failed_{false};
+};
+
+/**
+ * @brief GBK/UTF-8 增量转换器，按 InvalidPolicy 容错处理非法序列
+ *
+ * @details
+ * 1. 基于内置查表转换，块末尾不完整的多字节序列暂存，与下一块拼接后再转换
+ * 2. 非法序列按 policy 替换或跳过，并记录其在整个流中的偏移
+ * 3. finish() 时仍未补全的序列视为非法序列
+ *
+ * @code
+ * Transcoder transcoder(TranscodeDirection::GbkToUtf8);
+ * std::string out;
+ * while (read(chunk)) {
+ *     transcoder.feed(chunk, out);
+ * }
+ * transcoder.finish(out);
+ * for (const auto& error : transcoder.errors()) { ... }
+ * @endcode
+ */
+class Transcoder {
+public:
+    // errors() 最多记录的非法序列个数，超出部分只计数
+    static constexpr size_t kMaxRecordedErrors = 1024;
+
+    /**
+     * @param replacement InvalidPolicy::Replace 时的替换内容（目标编码），为空时使用默认替换字符
+     */
+    explicit Transcoder(TranscodeDirection direction, InvalidPolicy policy = InvalidPolicy::Replace,
+                        std::string_view replacement = {});
+
+    /**
+     * @brief 转换一块输入，结果追加到 out
+     *
+     * @return false 表示 InvalidPolicy::Fail 下遇到非法序列，此后需 reset() 才能继续使用
+     */
+    bool feed(std::string_view chunk, std::string& out);
+
+    /**
+     * @brief 结束转换，按 policy 处理暂存的不完整序列
+     *
+     * @return false 表示 InvalidPolicy::Fail 下遇到非法序列或输入被截断
+     */
+    bool finish(std::string& out);
+
+    // 清空暂存数据、错误记录和偏移，开始新的流
+    void reset() noexcept;
+
+    [[nodiscard]] const std::vector<TranscodeError>& errors() const noexcept {
+        return errors_;
+    }
+
+    // 非法序列总数（包括超出记录上限的部分）
+    [[nodiscard]] size_t error_count() const noexcept {
+        return error_count_;
+    }
+
+    // 暂存的不完整序列的字节数
+    [[nodiscard]] size_t pending_size() const noexcept {
+        return pending_size_;
+    }
+
+private:
+    // UTF-8 不完整序列最长 3 字节，GBK 为 1 字节
+    static constexpr size_t kMaxPendingSize = 3;
+
+    /**
+     * @brief 转换 input（起始于流中的 base 偏移）并追加到 out
+     *
+     * @param final 为 true 时末尾不完整的序列按非法序列处理
+     * @return size_t 已处理的字节数，剩余部分为不完整序列（或 Fail 时的非法序列）
+     */
+    size_t process(std::string_view input, size_t base, std::string& out, bool final);
+
+    // 记录非法序列并按 policy 输出，Fail 时返回 false
+    bool on_invalid(size_t offset, size_t length, std::string& out);
+
+    TranscodeDirection direction_;
+    InvalidPolicy policy_;
+    std::string replacement_;
+    std::vector<TranscodeError> errors_;
+    size_t error_count_{0};
+    size_t offset_{0};  // pending_ 第一个字节在流中的偏移
+    char pending_[kMaxPendingSize]{};
+    size_t pending_size_{0};
+    bool failed_{false};
+};
+
+} // namespace sequoia::utils
@@ -0,0 +1,167 @@
+#include "encoding.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+namespace sequoia::utils::detail {
+
+namespace {
+
+constexpr uint8_t kLeadFirst = 0x81;
+constexpr uint8_t kLeadLast = 0xFE;
+constexpr uint8_t kTrailFirst = 0x40;
+constexpr uint8_t kTrailLast = 0xFE;
+constexpr size_t kLeadCount = kLeadLast - kLeadFirst + 1;
+constexpr size_t kTrailCount = kTrailLast - kTrailFirst + 1;
+
+// kGbkSingle、kGbkDouble、kGbkEncodePageIndex、kGbkEncodePages，由 gbk_table.py 离线生成
+#include "gbk_table.inc"
+
+// 单字节 0x80~0xFF -> Unicode，0 表示非法
+inline uint16_t decodeSingle(uint8_t byte) noexcept {
+    return kGbkSingle[byte - 0x80];
+}
+
+// 双字节 -> Unicode，0 表示非法
+inline uint16_t decodeDouble(uint8_t lead, uint8_t trail) noexcept {
+    if (trail < kTrailFirst || trail > kTrailLast) {
+        return 0;
+    }
+    return kGbkDouble[(lead - kLeadFirst) * kTrailCount + (trail - kTrailFirst)];
+}
+
+// Unicode -> GBK 码（< 0x100 为单字节），0 表示无法映射
+inline uint16_t encodeGbk(uint32_t code_point) noexcept {
+    if (code_point > 0xFFFF) {
+        return 0;
+    }
+    return kGbkEncodePages[kGbkEncodePageIndex[code_point >> 8] * 256 + (code_point & 0xFF)];
+}
+
+static_assert(kGbkDouble.size() == kLeadCount * kTrailCount);
+static_assert(kGbkEncodePages.size() % 256 == 0);
+
+// 中英文混排时 ASCII 段通常很短，先逐字节复制，段较长时再交给 SIMD
+inline size_t copyAsciiRun(std::string_view input, std::span<char> out) noexcept {
+    constexpr size_t kScalarLimit = 16;
+    const size_t limit = std::min({input.size(), out.size(), kScalarLimit});
+    size_t i = 0;
+    while (i < limit && static_cast<unsigned char>(input[i]) < 0x80) {
+        out[i] = input[i];
+        ++i;
+    }
+    if (i < kScalarLimit) {
+        return i;
+    }
+    return i + copy_ascii(input.substr(i), out.subspan(i));
+}
+
+size_t utf8Length(uint32_t code_point) noexcept {
+    return code_point < 0x80 ? 1 : (code_point < 0x800 ? 2 : 3);
+}
+
+void writeUtf8(uint32_t code_point, char* out) noexcept {
+    if (code_point < 0x80) {
+        out[0] = static_cast<char>(code_point);
+    } else if (code_point < 0x800) {
+        out[0] = static_cast<char>(0xC0 | (code_point >> 6));
+        out[1] = static_cast<char>(0x80 | (code_point & 0x3F));
+    } else {
+        out[0] = static_cast<char>(0xE0 | (code_point >> 12));
+        out[1] = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+        out[2] = static_cast<char>(0x80 | (code_point & 0x3F));
+    }
+}
+
+} // namespace
+
+TranscodeResult gbk_to_utf8_native(std::string_view input, std::span<char> out) noexcept {
+    const auto* in = reinterpret_cast<const unsigned char*>(input.data());
+    size_t read = 0;
+    size_t written = 0;
+    while (read < input.size()) {
+        const unsigned char lead = in[read];
+        if (lead < 0x80) {
+            const size_t ascii = copyAsciiRun(input.substr(read), out.subspan(written));
+            if (ascii == 0) {
+                return {TranscodeStatus::OutputFull, read, written};
+            }
+            read += ascii;
+            written += ascii;
+            continue;
+        }
+
+        uint32_t code_point = 0;
+        size_t consumed = 1;
+        if (lead >= kLeadFirst && lead <= kLeadLast) {
+            if (read + 1 == input.size()) {
+                return {TranscodeStatus::Incomplete, read, written, 1};
+            }
+            code_point = decodeDouble(lead, in[read + 1]);
+            consumed = 2;
+        } else {
+            code_point = decodeSingle(lead);
+        }
+        if (code_point == 0) {
+            // 尾字节不在 GBK 范围内（如 ASCII）时只跳过首字节，使尾字节重新参与转换
+            const unsigned char trail = consumed == 2 ? in[read + 1] : 0;
+            const bool valid_trail = trail >= kTrailFirst && trail <= kTrailLast && trail != 0x7F;
+            return {TranscodeStatus::Invalid, read, written, valid_trail ? size_t{2} : size_t{1}};
+        }
+
+        const size_t length = utf8Length(code_point);
+        if (out.size() - written < length) {
+            return {TranscodeStatus::OutputFull, read, written};
+        }
+        writeUtf8(code_point, out.data() + written);
+        read += consumed;
+        written += length;
+    }
+    return {TranscodeStatus::Ok, read, written};
+}
+
+TranscodeResult utf8_to_gbk_native(std::string_view input, std::span<char> out) noexcept {
+    const auto* in = reinterpret_cast<const unsigned char*>(input.data());
+    size_t read = 0;
+    size_t written = 0;
+    while (read < input.size()) {
+        if (in[read] < 0x80) {
+            const size_t ascii = copyAsciiRun(input.substr(read), out.subspan(written));
+            if (ascii == 0) {
+                return {TranscodeStatus::OutputFull, read, written};
+            }
+            read += ascii;
+            written += ascii;
+            continue;
+        }
+
+        uint32_t code_point = 0;
+        size_t length = 0;
+        const TranscodeStatus status = decode_utf8(in + read, input.size() - read, code_point, length);
+        if (status != TranscodeStatus::Ok) {
+            return {status, read, written, status == TranscodeStatus::Invalid ? length : input.size() - read};
+        }
+
+        const uint16_t gbk = encodeGbk(code_point);
+        if (gbk == 0) {
+            return {TranscodeStatus::Invalid, read, written, length};
+        }
+        if (gbk < 0x100) {
+            if (out.size() == written) {
+                return {TranscodeStatus::OutputFull, read, written};
+            }
+            out[written++] = static_cast<char>(gbk);
+        } else {
+            if (out.size() - written < 2) {
+                return {TranscodeStatus::OutputFull, read, written};
+            }
+            out[written++] = static_cast<char>(gbk >> 8);
+            out[written++] = static_cast<char>(gbk & 0xFF);
+        }
+        read += length;
+    }
+    return {TranscodeStatus::Ok, read, written};
+}
+
+} // namespace sequoia::utils::detail
@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+"""生成 gbk.cc 使用的 GBK <-> Unicode 映射表 gbk_table.inc。
+
+用法：
+    gbk_table.py [OUTPUT]     # 默认写到脚本所在目录的 gbk_table.inc
+
+映射以 Python 的 gbk 编解码器为准，另加单字节 0x80 <-> U+20AC（欧元符号），
+与 glibc iconv 的 "GBK" 转换逐码位一致：用户自定义区（AAA1~AFFE、F8A1~FEFE、
+A140~A7A0）不映射到私用区，视为非法。
+"""
+
+import sys
+from pathlib import Path
+
+LEAD_FIRST, LEAD_LAST = 0x81, 0xFE
+TRAIL_FIRST, TRAIL_LAST = 0x40, 0xFE
+# Python 的 gbk 编解码器不含 0x80，glibc 映射为欧元符号
+EXTRA_SINGLE = {0x80: 0x20AC}
+
+
+def decode(data):
+    """解码一个 GBK 字符，非法或不在 BMP 内时返回 0。"""
+    try:
+        text = data.decode("gbk")
+    except UnicodeDecodeError:
+        return 0
+    if len(text) != 1 or ord(text) > 0xFFFF:
+        return 0
+    return ord(text)
+
+
+def build_decode_tables():
+    single = [EXTRA_SINGLE.get(byte, decode(bytes([byte]))) for byte in range(0x80, 0x100)]
+    double = [decode(bytes([lead, trail]))
+              for lead in range(LEAD_FIRST, LEAD_LAST + 1)
+              for trail in range(TRAIL_FIRST, TRAIL_LAST + 1)]
+    return single, double
+
+
+def build_encode_tables():
+    """按 Unicode 高字节分页；第 0 页全为 0，供无映射的页共用。"""
+    extra = {code_point: byte for byte, code_point in EXTRA_SINGLE.items()}
+    pages = {}
+    for code_point in range(0x80, 0x10000):
+        if 0xD800 <= code_point <= 0xDFFF:
+            continue
+        if code_point in extra:
+            gbk = extra[code_point]
+        else:
+            try:
+                gbk = int.from_bytes(chr(code_point).encode("gbk"), "big")
+            except UnicodeEncodeError:
+                continue
+        pages.setdefault(code_point >> 8, [0] * 256)[code_point & 0xFF] = gbk
+
+    index = [0] * 256
+    packed = [0] * 256
+    for high in sorted(pages):
+        index[high] = len(packed) // 256
+        packed.extend(pages[high])
+    return index, packed
+
+
+def format_array(ctype, name, values, per_line=16):
+    width = 2 if ctype == "uint8_t" else 4
+    lines = []
+    for i in range(0, len(values), per_line):
+        chunk = values[i:i + per_line]
+        lines.append("    " + ", ".join(f"0x{v:0{width}X}" for v in chunk) + ",")
+    return (f"constexpr std::array<{ctype}, {len(values)}> {name} = {{\n"
+            + "\n".join(lines) + "\n};\n")
+
+
+def main():
+    output = Path(sys.argv[1]) if len(sys.argv) > 1 else Path(__file__).with_name("gbk_table.inc")
+    single, double = build_decode_tables()
+    index, packed = build_encode_tables()
+
+    parts = [
+        "// 由 gbk_table.py 生成，请勿手工修改\n",
+        "// 单字节 0x80~0xFF -> Unicode，0 表示非法\n",
+        format_array("uint16_t", "kGbkSingle", single),
+        "\n// 双字节 [lead - 0x81][trail - 0x40] -> Unicode，0 表示非法\n",
+        format_array("uint16_t", "kGbkDouble", double),
+        "\n// Unicode 高字节 -> kGbkEncodePages 中的页号，0 为全 0 的空页\n",
+        format_array("uint8_t", "kGbkEncodePageIndex", index),
+        "\n// 每页 256 项：Unicode 低字节 -> GBK 码（< 0x100 为单字节，0 表示无法映射）\n",
+        format_array("uint16_t", "kGbkEncodePages", packed),
+    ]
+    output.write_text("".join(parts), encoding="utf-8")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,264 @@
+#include "latency_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace sequoia::utils {
+
+namespace {
+
+constexpr std::string_view kMagic = "SQLH";
+constexpr uint8_t kVersion = 1;
+
+void appendVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+[[nodiscard]] bool readVarint(std::string_view& in, uint64_t& value) noexcept {
+    value = 0;
+    for (uint32_t shift = 0; shift < 64; shift += 7) {
+        if (in.empty()) {
+            return false;
+        }
+        const auto byte = static_cast<uint8_t>(in.front());
+        in.remove_prefix(1);
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+LatencyHistogram::LatencyHistogram(uint64_t highest_trackable, uint32_t significant_digits)
+    : highest_trackable_(highest_trackable),
+      significant_digits_(std::clamp<uint32_t>(significant_digits, 1, kMaxSignificantDigits)) {
+    // 每段的线性桶数至少为 2 * 10^digits，保证段内步长不超过数值的 10^-digits
+    uint64_t largest_single_unit = 2;
+    for (uint32_t i = 0; i < significant_digits_; ++i) {
+        largest_single_unit *= 10;
+    }
+    sub_bucket_bits_ = static_cast<uint32_t>(std::bit_width(largest_single_unit - 1));
+    sub_bucket_half_bits_ = sub_bucket_bits_ - 1;
+    sub_bucket_half_count_ = 1u << sub_bucket_half_bits_;
+    sub_bucket_mask_ = (uint64_t{1} << sub_bucket_bits_) - 1;
+
+    const uint32_t value_bits = std::max(static_cast<uint32_t>(std::bit_width(highest_trackable_)), sub_bucket_bits_);
+    const uint32_t bucket_count = value_bits - sub_bucket_bits_ + 1;
+    counts_length_ = (bucket_count + 1) << sub_bucket_half_bits_;
+    counts_ = std::make_unique<std::atomic<uint64_t>[]>(counts_length_);
+}
+
+LatencyHistogram::LatencyHistogram(LatencyHistogram&& other) noexcept
+    : highest_trackable_(other.highest_trackable_),
+      significant_digits_(other.significant_digits_),
+      sub_bucket_bits_(other.sub_bucket_bits_),
+      sub_bucket_half_bits_(other.sub_bucket_half_bits_),
+      sub_bucket_half_count_(other.sub_bucket_half_count_),
+      sub_bucket_mask_(other.sub_bucket_mask_),
+      counts_length_(other.counts_length_),
+      counts_(std::move(other.counts_)),
+      count_(other.count_.load(std::memory_order_relaxed)),
+      total_(other.total_.load(std::memory_order_relaxed)),
+      min_(other.min_.load(std::memory_order_relaxed)),
+      max_(other.max_.load(std::memory_order_relaxed)),
+      overflow_(other.overflow_.load(std::memory_order_relaxed)) {
+    other.counts_length_ = 0;
+    other.count_.store(0, std::memory_order_relaxed);
+}
+
+LatencyHistogram& LatencyHistogram::operator=(LatencyHistogram&& other) noexcept {
+    if (this != &other) {
+        highest_trackable_ = other.highest_trackable_;
+        significant_digits_ = other.significant_digits_;
+        sub_bucket_bits_ = other.sub_bucket_bits_;
+        sub_bucket_half_bits_ = other.sub_bucket_half_bits_;
+        sub_bucket_half_count_ = other.sub_bucket_half_count_;
+        sub_bucket_mask_ = other.sub_bucket_mask_;
+        counts_length_ = other.counts_length_;
+        counts_ = std::move(other.counts_);
+        count_.store(other.count_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        total_.store(other.total_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        min_.store(other.min_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        max_.store(other.max_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        overflow_.store(other.overflow_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        other.counts_length_ = 0;
+        other.count_.store(0, std::memory_order_relaxed);
+    }
+    return *this;
+}
+
+uint64_t LatencyHistogram::value_at_index(uint32_t index) const noexcept {
+    auto bucket = static_cast<int32_t>(index >> sub_bucket_half_bits_) - 1;
+    uint64_t sub = (index & (sub_bucket_half_count_ - 1)) + sub_bucket_half_count_;
+    if (bucket < 0) {
+        sub -= sub_bucket_half_count_;
+        bucket = 0;
+    }
+    return sub << bucket;
+}
+
+uint64_t LatencyHistogram::bucket_width(uint32_t index) const noexcept {
+    const auto bucket = static_cast<int32_t>(index >> sub_bucket_half_bits_) - 1;
+    return uint64_t{1} << std::max(bucket, 0);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) noexcept {
+    if (other.count() == 0 && other.overflow() == 0) {
+        return;
+    }
+    overflow_.fetch_add(other.overflow(), std::memory_order_relaxed);
+
+    // 桶数相同时 other 的范围仍可能更大（如 1023 与 1000），超出 highest_trackable_ 的样本须走逐桶路径计入 overflow
+    const bool same_layout = other.sub_bucket_bits_ == sub_bucket_bits_ && other.counts_length_ <= counts_length_ &&
+                             other.highest_trackable_ <= highest_trackable_;
+    if (same_layout) {
+        for (uint32_t i = 0; i < other.counts_length_; ++i) {
+            if (const uint64_t n = other.counts_[i].load(std::memory_order_relaxed); n != 0) {
+                counts_[i].fetch_add(n, std::memory_order_relaxed);
+            }
+        }
+        count_.fetch_add(other.count(), std::memory_order_relaxed);
+        total_.fetch_add(other.total(), std::memory_order_relaxed);
+        update_min(other.min());
+        update_max(other.max());
+        return;
+    }
+
+    // 配置不同时按桶的最小等价值重新记录，total 为近似值；min / max 在范围内时取精确值
+    uint64_t lowest = UINT64_MAX;
+    uint64_t highest = 0;
+    for (uint32_t i = 0; i < other.counts_length_; ++i) {
+        const uint64_t n = other.counts_[i].load(std::memory_order_relaxed);
+        if (n == 0) {
+            continue;
+        }
+        const uint64_t value = other.value_at_index(i);
+        if (value > highest_trackable_) {
+            overflow_.fetch_add(n, std::memory_order_relaxed);
+            continue;
+        }
+        counts_[index_of(value)].fetch_add(n, std::memory_order_relaxed);
+        count_.fetch_add(n, std::memory_order_relaxed);
+        total_.fetch_add(value * n, std::memory_order_relaxed);
+        lowest = std::min(lowest, value);
+        highest = std::max(highest, value);
+    }
+    if (lowest == UINT64_MAX) {
+        return;
+    }
+    if (other.max() <= highest_trackable_) {
+        lowest = other.min();
+        highest = other.max();
+    }
+    update_min(lowest);
+    update_max(highest);
+}
+
+void LatencyHistogram::reset() noexcept {
+    for (uint32_t i = 0; i < counts_length_; ++i) {
+        counts_[i].store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    total_.store(0, std::memory_order_relaxed);
+    min_.store(UINT64_MAX, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+    overflow_.store(0, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::percentile(double quantile) const noexcept {
+    const uint64_t n = count();
+    if (n == 0) {
+        return 0;
+    }
+    quantile = std::clamp(quantile, 0.0, 1.0);
+    // 与 HDR 相同：第 ceil(q * n) 个样本（至少为第 1 个）
+    const uint64_t rank = std::max<uint64_t>(static_cast<uint64_t>(std::ceil(quantile * static_cast<double>(n))), 1);
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < counts_length_; ++i) {
+        seen += counts_[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            return std::min(value_at_index(i) + bucket_width(i) - 1, max());
+        }
+    }
+    return max();
+}
+
+std::string LatencyHistogram::serialize() const {
+    std::string out;
+    out.append(kMagic);
+    out.push_back(static_cast<char>(kVersion));
+    appendVarint(out, highest_trackable_);
+    appendVarint(out, significant_digits_);
+    appendVarint(out, count());
+    appendVarint(out, total());
+    appendVarint(out, min());
+    appendVarint(out, max());
+    appendVarint(out, overflow());
+
+    // 非空桶：与上一个非空桶的下标差 + 计数
+    uint32_t previous = 0;
+    for (uint32_t i = 0; i < counts_length_; ++i) {
+        if (const uint64_t n = counts_[i].load(std::memory_order_relaxed); n != 0) {
+            appendVarint(out, i - previous);
+            appendVarint(out, n);
+            previous = i;
+        }
+    }
+    return out;
+}
+
+std::optional<LatencyHistogram> LatencyHistogram::deserialize(std::string_view data) {
+    if (!data.starts_with(kMagic) || data.size() < kMagic.size() + 1 ||
+        static_cast<uint8_t>(data[kMagic.size()]) != kVersion) {
+        return std::nullopt;
+    }
+    data.remove_prefix(kMagic.size() + 1);
+
+    uint64_t highest = 0;
+    uint64_t digits = 0;
+    uint64_t count = 0;
+    uint64_t total = 0;
+    uint64_t min = 0;
+    uint64_t max = 0;
+    uint64_t overflow = 0;
+    if (!readVarint(data, highest) || !readVarint(data, digits) || !readVarint(data, count) ||
+        !readVarint(data, total) || !readVarint(data, min) || !readVarint(data, max) ||
+        !readVarint(data, overflow) || digits == 0 || digits > kMaxSignificantDigits) {
+        return std::nullopt;
+    }
+
+    LatencyHistogram histogram(highest, static_cast<uint32_t>(digits));
+    uint64_t index = 0;
+    uint64_t seen = 0;
+    while (!data.empty()) {
+        uint64_t delta = 0;
+        uint64_t n = 0;
+        if (!readVarint(data, delta) || !readVarint(data, n)) {
+            return std::nullopt;
+        }
+        index += delta;
+        if (index >= histogram.counts_length_) {
+            return std::nullopt;
+        }
+        histogram.counts_[index].store(n, std::memory_order_relaxed);
+        seen += n;
+    }
+    if (seen != count) {
+        return std::nullopt;
+    }
+    histogram.count_.store(count, std::memory_order_relaxed);
+    histogram.total_.store(total, std::memory_order_relaxed);
+    histogram.min_.store(count == 0 ? UINT64_MAX : min, std::memory_order_relaxed);
+    histogram.max_.store(max, std::memory_order_relaxed);
+    histogram.overflow_.store(overflow, std::memory_order_relaxed);
+    return histogram;
+}
+
+} // namespace sequoia::utils
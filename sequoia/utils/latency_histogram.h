@@ -0,0 +1,186 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace sequoia::utils {
+
+/**
+ * @brief HDR 风格的对数-线性直方图，用于记录耗时等非负整数的分布
+ *
+ * @details
+ * 1. 数值按 2 的幂分段，每段再线性等分；significant_digits 为保证的十进制有效位数，
+ *    任一记录值与其所在桶代表值的相对误差不超过 10^-significant_digits
+ * 2. 内存只与 highest_trackable 和精度有关，与样本数无关：默认配置（约 1 小时的纳秒数，2 位有效数字）约 37KB
+ * 3. record 为无锁的原子累加，多线程可同时记录同一实例；高频场景建议每线程一个实例，再用 merge 汇总
+ * 4. 查询与 record 并发时得到的是近似快照（各桶之间不保证一致）
+ * 5. 单位由调用方决定（纳秒、微秒、TSC 周期等），最小可分辨值为 1
+ *
+ * @code
+ * LatencyHistogram histogram;                       // 纳秒，最大约 1 小时
+ * histogram.record(elapsed_ns);
+ * logger->info("p99={}ns max={}ns", histogram.percentile(0.99), histogram.max());
+ *
+ * auto bytes = histogram.serialize();               // 跨进程汇总
+ * auto restored = LatencyHistogram::deserialize(bytes);
+ * @endcode
+ */
+class LatencyHistogram {
+public:
+    static constexpr uint64_t kDefaultHighestTrackable = 3'600'000'000'000;
+    static constexpr uint32_t kDefaultSignificantDigits = 2;
+    static constexpr uint32_t kMaxSignificantDigits = 5;
+
+    /**
+     * @param highest_trackable 可记录的最大值，超过的值不记录并计入 overflow()
+     * @param significant_digits 有效数字位数，取值 1 ~ 5，超出范围时取最近的合法值
+     */
+    explicit LatencyHistogram(uint64_t highest_trackable = kDefaultHighestTrackable,
+                              uint32_t significant_digits = kDefaultSignificantDigits);
+
+    // 移动不是线程安全的，调用方保证期间没有并发记录
+    LatencyHistogram(LatencyHistogram&& other) noexcept;
+    LatencyHistogram& operator=(LatencyHistogram&& other) noexcept;
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    /**
+     * @brief 记录 count 次 value
+     *
+     * @return bool value 超过 highest_trackable 时返回 false，只计入 overflow()
+     */
+    bool record(uint64_t value, uint64_t count = 1) noexcept {
+        if (value > highest_trackable_) [[unlikely]] {
+            overflow_.fetch_add(count, std::memory_order_relaxed);
+            return false;
+        }
+        counts_[index_of(value)].fetch_add(count, std::memory_order_relaxed);
+        count_.fetch_add(count, std::memory_order_relaxed);
+        total_.fetch_add(value * count, std::memory_order_relaxed);
+        update_min(value);
+        update_max(value);
+        return true;
+    }
+
+    /**
+     * @brief 合并另一个直方图（可为不同配置，按其桶代表值重新记录）
+     *
+     * @details other 中超过本实例 highest_trackable 的部分计入 overflow()
+     */
+    void merge(const LatencyHistogram& other) noexcept;
+
+    // 清空所有计数
+    void reset() noexcept;
+
+    [[nodiscard]] uint64_t count() const noexcept {
+        return count_.load(std::memory_order_relaxed);
+    }
+
+    // 所有记录值之和
+    [[nodiscard]] uint64_t total() const noexcept {
+        return total_.load(std::memory_order_relaxed);
+    }
+
+    // 未记录时返回 0
+    [[nodiscard]] uint64_t min() const noexcept {
+        return count() == 0 ? 0 : min_.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] uint64_t max() const noexcept {
+        return max_.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] double mean() const noexcept {
+        const uint64_t n = count();
+        return n == 0 ? 0.0 : static_cast<double>(total()) / static_cast<double>(n);
+    }
+
+    // 因超过 highest_trackable 未记录的次数
+    [[nodiscard]] uint64_t overflow() const noexcept {
+        return overflow_.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] uint64_t highest_trackable() const noexcept {
+        return highest_trackable_;
+    }
+
+    [[nodiscard]] uint32_t significant_digits() const noexcept {
+        return significant_digits_;
+    }
+
+    /**
+     * @brief 分位数，quantile 取值 0 ~ 1（如 0.99）
+     *
+     * @return uint64_t 对应桶内的最大等价值（不超过 max()），未记录时返回 0
+     */
+    [[nodiscard]] uint64_t percentile(double quantile) const noexcept;
+
+    /**
+     * @brief 序列化为紧凑的二进制格式（varint 编码，只写非空桶）
+     */
+    [[nodiscard]] std::string serialize() const;
+
+    /**
+     * @brief 从 serialize 的结果恢复
+     *
+     * @return std::optional<LatencyHistogram> 数据截断、格式或版本不符时返回 std::nullopt
+     */
+    [[nodiscard]] static std::optional<LatencyHistogram> deserialize(std::string_view data);
+
+    // value 所在桶的最小 / 最大等价值：两者之间的值记录后不可区分
+    [[nodiscard]] uint64_t lowest_equivalent(uint64_t value) const noexcept {
+        return value_at_index(index_of(value));
+    }
+
+    [[nodiscard]] uint64_t highest_equivalent(uint64_t value) const noexcept {
+        const uint32_t index = index_of(value);
+        return value_at_index(index) + bucket_width(index) - 1;
+    }
+
+private:
+    [[nodiscard]] uint32_t index_of(uint64_t value) const noexcept {
+        // 第 0 段覆盖 [0, sub_bucket_count)，之后每段覆盖 [2^k, 2^(k+1))，段内步长为 2^bucket
+        const auto bucket = static_cast<uint32_t>(std::bit_width(value | sub_bucket_mask_)) - sub_bucket_bits_;
+        const auto sub = static_cast<uint32_t>(value >> bucket);
+        return ((bucket + 1) << sub_bucket_half_bits_) + sub - sub_bucket_half_count_;
+    }
+
+    [[nodiscard]] uint64_t value_at_index(uint32_t index) const noexcept;
+    [[nodiscard]] uint64_t bucket_width(uint32_t index) const noexcept;
+
+    void update_min(uint64_t value) noexcept {
+        uint64_t current = min_.load(std::memory_order_relaxed);
+        while (value < current && !min_.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    void update_max(uint64_t value) noexcept {
+        uint64_t current = max_.load(std::memory_order_relaxed);
+        while (value > current && !max_.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+    }
+
+private:
+    uint64_t highest_trackable_;
+    uint32_t significant_digits_;
+    uint32_t sub_bucket_bits_{0};
+    uint32_t sub_bucket_half_bits_{0};
+    uint32_t sub_bucket_half_count_{0};
+    uint64_t sub_bucket_mask_{0};
+    uint32_t counts_length_{0};
+    std::unique_ptr<std::atomic<uint64_t>[]> counts_;
+
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> total_{0};
+    std::atomic<uint64_t> min_{UINT64_MAX};
+    std::atomic<uint64_t> max_{0};
+    std::atomic<uint64_t> overflow_{0};
+};
+
+} // namespace sequoia::utils
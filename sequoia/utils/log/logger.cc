@@ -123,13 +123,29 @@ std::shared_ptr<Logger> Logger::defaultLogger(std::string_view section) {
     }
     
     // 双重检查锁定模式
-    const std::lock_guard<std::mutex> guard(default_logger_mutex_);
+    const std::lock_guard<T_LOCKABLE_BASE(std::mutex)> guard(default_logger_mutex_);
     if (!ret) {
         ret = newLogger(section);
     }
     return ret;
 }
 
+void Logger::trace_message(const LogLevel level, std::string_view message) const {
+    // 颜色为 0xRRGGBB，0 表示使用 Tracy 默认颜色
+    constexpr std::array<uint32_t, 7> LOG_LEVEL_COLORS = {
+        0x808080, 0xA0A0A0, 0, 0xFFC000, 0xFF4040, 0xFF00FF, 0
+    };
+    const auto index = static_cast<size_t>(level);
+    fmt::memory_buffer text;
+    fmt::format_to(std::back_inserter(text), "[{}] [{}] {}", internal::LOG_LEVEL_NAMES[index], section_, message);
+    if (T_IS_CONNECTED) {
+        T_MESSAGE_COLOR(text.data(), text.size(), LOG_LEVEL_COLORS[index]);
+    }
+    if (const trace::MessageSink sink = trace::message_sink()) {
+        sink(std::string_view(text.data(), text.size()), LOG_LEVEL_COLORS[index]);
+    }
+}
+
 void Logger::shutdown() {
     // C++20: 使用显式原子操作和更清晰的逻辑
     const int32_t current_index = default_logger_index_.load(std::memory_order_acquire);
@@ -9,6 +9,8 @@
 #include <array>
 #include <source_location>
 #include <concepts>
+#include <sequoia/utils/trace/trace.h>
+#include <sequoia/utils/trace/message.h>
 
 namespace sequoia::utils::log {
 
@@ -220,12 +222,30 @@ private:
     template <typename Arg1, typename... Args>
     void log(const LogLevel level, std::string_view fmt, const Arg1 &arg1,
              const Args &... args) {
-        if (!fmt.empty()) {
-            internal_logger_->log(static_cast<spdlog::level::level_enum>(level),
-                                 fmt::runtime(std::string{fmt}), arg1, args...);
+        const auto spd_level = static_cast<spdlog::level::level_enum>(level);
+        if (fmt.empty() || !internal_logger_->should_log(spd_level)) {
+            return;
+        }
+        // 只格式化一次，同一份文本交给 spdlog 与 Tracy
+        fmt::memory_buffer buffer;
+        try {
+            fmt::format_to(std::back_inserter(buffer), fmt::runtime(fmt), arg1, args...);
+        } catch (const fmt::format_error&) {
+            // 格式串错误交由 spdlog 按其错误处理方式报告
+            internal_logger_->log(spd_level, fmt::runtime(fmt), arg1, args...);
+            return;
+        }
+        const std::string_view message(buffer.data(), buffer.size());
+        internal_logger_->log(spd_level, spdlog::string_view_t(message.data(), message.size()));
+        // Tracy 未连接且没有消息接收者时不再构造带级别前缀的文本
+        if (T_IS_CONNECTED || trace::message_sink() != nullptr) {
+            trace_message(level, message);
         }
     }
 
+    /// @brief 将日志消息发送到 Tracy 时间线（按级别着色）与 trace::message_sink()
+    void trace_message(LogLevel level, std::string_view message) const;
+
 private:
     /// @brief 用于区分不同模块
     std::string section_;
@@ -235,7 +255,7 @@ private:
     /// @brief 默认 Logger 实例池（用于多线程安全重启）
     static constexpr size_t DEFAULT_LOGGER_SIZE = 2;
     static inline std::atomic<int32_t> default_logger_index_{0};
-    static inline std::mutex default_logger_mutex_;
+    static inline T_LOCKABLE_NAME(std::mutex, default_logger_mutex_, "Logger::default_logger_mutex_");
     static inline std::array<std::shared_ptr<Logger>, DEFAULT_LOGGER_SIZE> default_logger_{nullptr, nullptr};
 };
 
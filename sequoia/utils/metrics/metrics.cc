@@ -0,0 +1,323 @@
+#include "metrics.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <type_traits>
+#include <variant>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace sequoia::utils::metrics {
+
+namespace detail {
+
+uint32_t shard_count() noexcept {
+    static const uint32_t count = [] {
+        const uint32_t cpus = std::max(std::thread::hardware_concurrency(), 1u);
+        return std::bit_ceil(std::min(cpus, 64u));
+    }();
+    return count;
+}
+
+uint32_t current_shard() noexcept {
+    // 线程迁移到其他 CPU 后仍使用原分片：计数依然正确，只是可能与其他线程共享缓存行
+    static std::atomic<uint32_t> next{0};
+    thread_local const uint32_t shard = [] {
+        int cpu = -1;
+#if defined(__linux__)
+        cpu = ::sched_getcpu();
+#endif
+        const uint32_t index = cpu >= 0 ? static_cast<uint32_t>(cpu) : next.fetch_add(1, std::memory_order_relaxed);
+        return index & (shard_count() - 1);
+    }();
+    return shard;
+}
+
+} // namespace detail
+
+namespace {
+
+[[nodiscard]] bool isNameChar(char c, bool first) noexcept {
+    const bool alpha = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == ':';
+    return alpha || (!first && c >= '0' && c <= '9');
+}
+
+// 标签名不允许 ':'
+[[nodiscard]] std::string sanitizeLabelName(std::string_view name) {
+    std::string result = sanitize_metric_name(name);
+    std::replace(result.begin(), result.end(), ':', '_');
+    return result;
+}
+
+void appendEscaped(std::string& out, std::string_view text, bool quote) {
+    for (const char c : text) {
+        if (c == '\\') {
+            out += "\\\\";
+        } else if (c == '\n') {
+            out += "\\n";
+        } else if (quote && c == '"') {
+            out += "\\\"";
+        } else {
+            out += c;
+        }
+    }
+}
+
+void appendNumber(std::string& out, double value) {
+    if (std::isnan(value)) {
+        out += "NaN";
+        return;
+    }
+    if (std::isinf(value)) {
+        out += value > 0 ? "+Inf" : "-Inf";
+        return;
+    }
+    std::array<char, 32> buffer{};
+    const auto [end, ec] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+    out.append(buffer.data(), end);
+}
+
+void appendNumber(std::string& out, uint64_t value) {
+    std::array<char, 24> buffer{};
+    const auto [end, ec] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+    out.append(buffer.data(), end);
+}
+
+// 标签值的文本，不适合作为标签的类型返回 false
+[[nodiscard]] bool labelValue(const ParamValue& value, std::string& out) {
+    return std::visit(
+        [&out](const auto& v) {
+            using T = std::decay_t<decltype(v)>;
+            if constexpr (std::is_same_v<T, std::string>) {
+                out = v;
+            } else if constexpr (std::is_same_v<T, bool>) {
+                out = v ? "true" : "false";
+            } else if constexpr (std::is_arithmetic_v<T>) {
+                out.clear();
+                if constexpr (std::is_floating_point_v<T>) {
+                    appendNumber(out, static_cast<double>(v));
+                } else {
+                    std::array<char, 24> buffer{};
+                    const auto [end, ec] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), v);
+                    out.assign(buffer.data(), end);
+                }
+            } else {
+                return false;
+            }
+            return true;
+        },
+        value);
+}
+
+// 在已渲染的标签集末尾追加一个标签
+[[nodiscard]] std::string withLabel(const std::string& labels, std::string_view name, std::string_view value) {
+    std::string result = labels.empty() ? std::string("{") : labels.substr(0, labels.size() - 1) + ",";
+    result += name;
+    result += "=\"";
+    appendEscaped(result, value, true);
+    result += "\"}";
+    return result;
+}
+
+void appendSample(std::string& out, std::string_view name, std::string_view labels, double value) {
+    out += name;
+    out += labels;
+    out += ' ';
+    appendNumber(out, value);
+    out += '\n';
+}
+
+void appendSample(std::string& out, std::string_view name, std::string_view labels, uint64_t value) {
+    out += name;
+    out += labels;
+    out += ' ';
+    appendNumber(out, value);
+    out += '\n';
+}
+
+[[nodiscard]] std::string_view typeName(MetricType type) noexcept {
+    switch (type) {
+        case MetricType::counter: return "counter";
+        case MetricType::gauge: return "gauge";
+        case MetricType::summary: return "summary";
+    }
+    return "untyped";
+}
+
+constexpr std::array<std::pair<double, std::string_view>, 3> kQuantiles = {{
+    {0.50, "0.5"},
+    {0.90, "0.9"},
+    {0.99, "0.99"},
+}};
+
+} // namespace
+
+std::string sanitize_metric_name(std::string_view name) {
+    std::string result;
+    result.reserve(name.size() + 1);
+    if (name.empty() || (name.front() >= '0' && name.front() <= '9')) {
+        result += '_';
+    }
+    for (size_t i = 0; i < name.size(); ++i) {
+        result += isNameChar(name[i], result.empty()) ? name[i] : '_';
+    }
+    return result;
+}
+
+std::string format_labels(const Params& labels) {
+    std::string result;
+    std::string value;
+    for (const auto& [key, param] : labels) {
+        if (!labelValue(param, value)) {
+            continue;
+        }
+        result += result.empty() ? "{" : ",";
+        result += sanitizeLabelName(key);
+        result += "=\"";
+        appendEscaped(result, value, true);
+        result += '"';
+    }
+    if (!result.empty()) {
+        result += '}';
+    }
+    return result;
+}
+
+Counter::Counter() : shards_(std::make_unique<detail::Shard[]>(detail::shard_count())) {}
+
+uint64_t Counter::value() const noexcept {
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < detail::shard_count(); ++i) {
+        total += shards_[i].value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+MetricsRegistry& MetricsRegistry::instance() {
+    // 有意不析构：进程退出时其他线程可能仍持有指标指针
+    static MetricsRegistry* registry = new MetricsRegistry();
+    return *registry;
+}
+
+MetricsRegistry::Family* MetricsRegistry::family(std::string_view name, MetricType type, std::string_view help) {
+    const std::string key = sanitize_metric_name(name);
+    auto [it, inserted] = families_.try_emplace(key);
+    if (inserted) {
+        it->second.type = type;
+        it->second.help = help;
+    }
+    return it->second.type == type ? &it->second : nullptr;
+}
+
+Counter* MetricsRegistry::counter(std::string_view name, const Params& labels, std::string_view help) {
+    const std::lock_guard<std::mutex> guard(mutex_);
+    Family* target = family(name, MetricType::counter, help);
+    if (target == nullptr) {
+        return nullptr;
+    }
+    auto& metric = target->counters[format_labels(labels)];
+    if (!metric) {
+        metric = std::make_unique<Counter>();
+    }
+    return metric.get();
+}
+
+Gauge* MetricsRegistry::gauge(std::string_view name, const Params& labels, std::string_view help) {
+    const std::lock_guard<std::mutex> guard(mutex_);
+    Family* target = family(name, MetricType::gauge, help);
+    if (target == nullptr) {
+        return nullptr;
+    }
+    auto& metric = target->gauges[format_labels(labels)];
+    if (!metric) {
+        metric = std::make_unique<Gauge>();
+    }
+    return metric.get();
+}
+
+Summary* MetricsRegistry::summary(std::string_view name, const Params& labels, std::string_view help,
+                                  uint64_t highest_trackable, uint32_t significant_digits) {
+    const std::lock_guard<std::mutex> guard(mutex_);
+    Family* target = family(name, MetricType::summary, help);
+    if (target == nullptr) {
+        return nullptr;
+    }
+    auto& metric = target->summaries[format_labels(labels)];
+    if (!metric) {
+        metric = std::make_unique<Summary>(highest_trackable, significant_digits);
+    }
+    return metric.get();
+}
+
+size_t MetricsRegistry::size() const {
+    const std::lock_guard<std::mutex> guard(mutex_);
+    size_t count = 0;
+    for (const auto& [name, family] : families_) {
+        count += family.counters.size() + family.gauges.size() + family.summaries.size();
+    }
+    return count;
+}
+
+std::string MetricsRegistry::expose(bool metadata) const {
+    const std::lock_guard<std::mutex> guard(mutex_);
+    std::string out;
+    for (const auto& [name, family] : families_) {
+        if (metadata) {
+            if (!family.help.empty()) {
+                out += "# HELP ";
+                out += name;
+                out += ' ';
+                appendEscaped(out, family.help, false);
+                out += '\n';
+            }
+            out += "# TYPE ";
+            out += name;
+            out += ' ';
+            out += typeName(family.type);
+            out += '\n';
+        }
+        for (const auto& [labels, counter] : family.counters) {
+            appendSample(out, name, labels, counter->value());
+        }
+        for (const auto& [labels, gauge] : family.gauges) {
+            appendSample(out, name, labels, gauge->value());
+        }
+        for (const auto& [labels, summary] : family.summaries) {
+            const LatencyHistogram& histogram = summary->histogram();
+            for (const auto& [quantile, text] : kQuantiles) {
+                appendSample(out, name, withLabel(labels, "quantile", text), histogram.percentile(quantile));
+            }
+            appendSample(out, name + "_sum", labels, histogram.total());
+            appendSample(out, name + "_count", labels, histogram.count());
+        }
+    }
+    return out;
+}
+
+bool MetricsRegistry::dump(const std::string& path) const {
+    const std::string text = expose();
+    const std::string temp_path = path + ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::out | std::ios::trunc);
+        if (!file || !(file << text).flush()) {
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec) {
+        std::filesystem::remove(temp_path, ec);
+        return false;
+    }
+    return true;
+}
+
+} // namespace sequoia::utils::metrics
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include <sequoia/utils/latency_histogram.h>
+#include <sequoia/utils/params.h>
+
+namespace sequoia::utils::metrics {
+
+namespace detail {
+
+// 分片数：不少于 CPU 数的 2 的幂，最多 64
+[[nodiscard]] uint32_t shard_count() noexcept;
+
+// 当前线程使用的分片（线程首次使用时按所在 CPU 选定），已按 shard_count() 取模
+[[nodiscard]] uint32_t current_shard() noexcept;
+
+struct alignas(64) Shard {
+    std::atomic<uint64_t> value{0};
+};
+
+} // namespace detail
+
+/**
+ * @brief 单调递增计数器
+ *
+ * @details 每个 CPU 一个独占缓存行的分片，inc 只做一次 relaxed 原子加，多线程之间没有伪共享；
+ *          value 汇总所有分片，读取开销与分片数成正比
+ */
+class Counter {
+public:
+    Counter();
+
+    Counter(const Counter&) = delete;
+    Counter& operator=(const Counter&) = delete;
+
+    void inc(uint64_t n = 1) noexcept {
+        shards_[detail::current_shard()].value.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] uint64_t value() const noexcept;
+
+private:
+    std::unique_ptr<detail::Shard[]> shards_;
+};
+
+/**
+ * @brief 可增可减的瞬时值
+ *
+ * @details 保存的是最后一次设置的值，无法像 Counter 那样分片累加；独占一个缓存行避免与其他指标伪共享
+ */
+class alignas(64) Gauge {
+public:
+    Gauge() = default;
+
+    Gauge(const Gauge&) = delete;
+    Gauge& operator=(const Gauge&) = delete;
+
+    void set(double value) noexcept {
+        value_.store(value, std::memory_order_relaxed);
+    }
+
+    void add(double delta) noexcept {
+        double current = value_.load(std::memory_order_relaxed);
+        while (!value_.compare_exchange_weak(current, current + delta, std::memory_order_relaxed)) {
+        }
+    }
+
+    void sub(double delta) noexcept {
+        add(-delta);
+    }
+
+    [[nodiscard]] double value() const noexcept {
+        return value_.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<double> value_{0.0};
+};
+
+/**
+ * @brief 分布统计（如耗时），以 Prometheus summary 导出 p50 / p90 / p99、_sum 与 _count
+ */
+class Summary {
+public:
+    explicit Summary(uint64_t highest_trackable = LatencyHistogram::kDefaultHighestTrackable,
+                     uint32_t significant_digits = LatencyHistogram::kDefaultSignificantDigits)
+        : histogram_(highest_trackable, significant_digits) {}
+
+    Summary(const Summary&) = delete;
+    Summary& operator=(const Summary&) = delete;
+
+    // 超过 highest_trackable 的值不计入
+    void observe(uint64_t value) noexcept {
+        (void)histogram_.record(value);
+    }
+
+    [[nodiscard]] const LatencyHistogram& histogram() const noexcept {
+        return histogram_;
+    }
+
+private:
+    LatencyHistogram histogram_;
+};
+
+enum class MetricType {
+    counter,
+    gauge,
+    summary,
+};
+
+/**
+ * @brief 指标注册表与 Prometheus 文本格式导出
+ *
+ * @details
+ * 1. 指标按名称 + 标签注册一次，返回的指针在注册表生命周期内有效，之后的更新不经过注册表、无锁
+ * 2. 标签来自 Params：按键排序，值取字符串 / 整数 / 浮点 / 布尔的文本，数组与嵌套 Params 忽略
+ * 3. 名称中 Prometheus 不允许的字符替换为 '_'；同名指标的类型必须一致
+ * 4. instance() 为进程级注册表，测试或独立模块也可以自行构造
+ *
+ * @code
+ * Params labels;
+ * labels.set("side", "buy");
+ * static auto* orders = MetricsRegistry::instance().counter("orders_total", labels, "Orders received");
+ * orders->inc();
+ * MetricsRegistry::instance().dump("/var/lib/node_exporter/sequoia.prom");
+ * @endcode
+ */
+class MetricsRegistry {
+public:
+    [[nodiscard]] static MetricsRegistry& instance();
+
+    MetricsRegistry() = default;
+
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    /**
+     * @brief 获取或注册指标，help 只在首次注册该名称时生效
+     *
+     * @return 名称已注册为其他类型时返回 nullptr
+     */
+    [[nodiscard]] Counter* counter(std::string_view name, const Params& labels = {}, std::string_view help = {});
+
+    [[nodiscard]] Gauge* gauge(std::string_view name, const Params& labels = {}, std::string_view help = {});
+
+    // highest_trackable / significant_digits 只在首次注册时生效
+    [[nodiscard]] Summary* summary(std::string_view name, const Params& labels = {}, std::string_view help = {},
+                                   uint64_t highest_trackable = LatencyHistogram::kDefaultHighestTrackable,
+                                   uint32_t significant_digits = LatencyHistogram::kDefaultSignificantDigits);
+
+    // 已注册的指标数（每组标签计一个）
+    [[nodiscard]] size_t size() const;
+
+    /**
+     * @brief 渲染为 Prometheus 文本格式（按名称排序）
+     *
+     * @param metadata 是否输出 # HELP / # TYPE 行，写日志时可关闭
+     */
+    [[nodiscard]] std::string expose(bool metadata = true) const;
+
+    /**
+     * @brief 写入文件：先写临时文件再重命名，采集方不会读到写了一半的内容
+     *
+     * @return bool 文件无法写入或重命名失败时返回 false
+     */
+    bool dump(const std::string& path) const;
+
+private:
+    struct Family {
+        MetricType type{MetricType::counter};
+        std::string help{};
+        // 键为渲染后的标签，如 {side="buy"}
+        std::map<std::string, std::unique_ptr<Counter>> counters{};
+        std::map<std::string, std::unique_ptr<Gauge>> gauges{};
+        std::map<std::string, std::unique_ptr<Summary>> summaries{};
+    };
+
+    [[nodiscard]] Family* family(std::string_view name, MetricType type, std::string_view help);
+
+private:
+    mutable std::mutex mutex_;
+    std::map<std::string, Family, std::less<>> families_;
+};
+
+/**
+ * @brief 指标名称：Prometheus 不允许的字符替换为 '_'，首字符为数字时加前缀 '_'
+ */
+[[nodiscard]] std::string sanitize_metric_name(std::string_view name);
+
+/**
+ * @brief 将 Params 渲染为标签集，如 {side="buy",venue="x"}，没有可用标签时返回空字符串
+ */
+[[nodiscard]] std::string format_labels(const Params& labels);
+
+} // namespace sequoia::utils::metrics
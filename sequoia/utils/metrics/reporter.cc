@@ -0,0 +1,70 @@
+#include "reporter.h"
+
+#include <string_view>
+
+namespace sequoia::utils::metrics {
+
+bool MetricsReporter::start(std::chrono::milliseconds interval, log::LoggerPtr logger, std::string path) {
+    const std::lock_guard<std::mutex> guard(mutex_);
+    if (thread_.joinable() || interval.count() <= 0 || (!logger && path.empty())) {
+        return false;
+    }
+    stop_ = false;
+    interval_ = interval;
+    logger_ = std::move(logger);
+    path_ = std::move(path);
+    thread_ = std::thread([this] { run(); });
+    return true;
+}
+
+void MetricsReporter::stop() {
+    std::thread thread;
+    {
+        const std::lock_guard<std::mutex> guard(mutex_);
+        stop_ = true;
+        thread = std::move(thread_);
+    }
+    cv_.notify_all();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+bool MetricsReporter::running() const {
+    const std::lock_guard<std::mutex> guard(mutex_);
+    return thread_.joinable();
+}
+
+bool MetricsReporter::report(const log::LoggerPtr& logger, const std::string& path) const {
+    if (logger) {
+        const std::string text = registry_.expose(false);
+        std::string_view rest = text;
+        while (!rest.empty()) {
+            const size_t end = rest.find('\n');
+            const std::string_view line = rest.substr(0, end);
+            if (!line.empty()) {
+                logger->info("metric {}", line);
+            }
+            rest.remove_prefix(end == std::string_view::npos ? rest.size() : end + 1);
+        }
+    }
+    return path.empty() || registry_.dump(path);
+}
+
+void MetricsReporter::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    const auto interval = interval_;
+    const auto logger = logger_;
+    const auto path = path_;
+    while (!stop_) {
+        cv_.wait_for(lock, interval, [this] { return stop_; });
+        // 报告期间不持锁，stop 可以随时置位
+        lock.unlock();
+        if (!report(logger, path) && logger) {
+            logger->warn("metrics dump to {} failed", path);
+        }
+        lock.lock();
+    }
+}
+
+} // namespace sequoia::utils::metrics
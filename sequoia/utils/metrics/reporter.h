@@ -0,0 +1,72 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <sequoia/utils/log/logger.h>
+#include <sequoia/utils/metrics/metrics.h>
+
+namespace sequoia::utils::metrics {
+
+/**
+ * @brief 定期将注册表中的指标写入日志和 / 或文件
+ *
+ * @details
+ * 1. 每个周期把每个样本写成一行 info 日志（`metric name{labels} value`），便于按名称 grep 后计算速率
+ * 2. 指定 path 时同时以 Prometheus 文本格式写入文件（可交给 node_exporter 的 textfile collector）
+ * 3. 后台线程在 stop 或析构时退出，退出前再报告一次
+ *
+ * @code
+ * MetricsReporter reporter;
+ * reporter.start(std::chrono::seconds(10), Logger::defaultLogger(), "/var/lib/node_exporter/sequoia.prom");
+ * @endcode
+ */
+class MetricsReporter {
+public:
+    explicit MetricsReporter(MetricsRegistry& registry = MetricsRegistry::instance()) : registry_(registry) {}
+
+    ~MetricsReporter() {
+        stop();
+    }
+
+    MetricsReporter(const MetricsReporter&) = delete;
+    MetricsReporter& operator=(const MetricsReporter&) = delete;
+
+    /**
+     * @brief 启动后台线程
+     *
+     * @param logger 为空时只写文件
+     * @param path 为空时只写日志
+     * @return bool 已在运行、interval 不为正或 logger 与 path 均为空时返回 false
+     */
+    bool start(std::chrono::milliseconds interval, log::LoggerPtr logger, std::string path = {});
+
+    void stop();
+
+    [[nodiscard]] bool running() const;
+
+    /**
+     * @brief 立即报告一次（可在未启动时调用）
+     *
+     * @return bool 写文件失败时返回 false
+     */
+    bool report(const log::LoggerPtr& logger, const std::string& path = {}) const;
+
+private:
+    void run();
+
+private:
+    MetricsRegistry& registry_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread thread_;
+    bool stop_{false};
+    std::chrono::milliseconds interval_{0};
+    log::LoggerPtr logger_;
+    std::string path_;
+};
+
+} // namespace sequoia::utils::metrics
@@ -3,6 +3,10 @@
 #include <concepts>
 #include <limits>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
 
 namespace sequoia::utils {
 
@@ -49,4 +53,58 @@ template<FloatingPoint T, FloatingPoint U>
     return std::isnan(value);
 }
 
+/**
+ * @brief 判断数值是否为 Null<T> 哨兵值（整数为最大值，浮点为任意 NaN）
+ */
+template<typename T>
+    requires Integral<T> || FloatingPoint<T>
+[[nodiscard]] constexpr bool is_null(T value) noexcept {
+    if constexpr (FloatingPoint<T>) {
+        return value != value;
+    } else {
+        return value == std::numeric_limits<T>::max();
+    }
+}
+
+// 提供向量化哨兵内核的数值类型
+template<typename T>
+concept SentinelValue = std::same_as<T, int32_t> || std::same_as<T, int64_t> ||
+                        std::same_as<T, uint32_t> || std::same_as<T, uint64_t> ||
+                        std::same_as<T, float> || std::same_as<T, double>;
+
+// 以下为 Null<T> 哨兵编码数组的批量操作，运行时按 CPU 分派到 AVX2 / 标量实现（simd/null.cc），
+// 整数与最大值做向量相等比较，浮点用自身无序比较检测 NaN，结果与逐个调用 is_null 一致；
+// 参数为 std::span，传入 std::vector 时需显式指定类型：count_null<double>(prices)
+
+/**
+ * @brief 第一个 null 的下标
+ *
+ * @return std::optional<size_t> 没有 null 时返回 std::nullopt
+ */
+template<SentinelValue T>
+[[nodiscard]] std::optional<size_t> find_first_null(std::span<const T> values) noexcept;
+
+/**
+ * @brief null 的个数
+ */
+template<SentinelValue T>
+[[nodiscard]] size_t count_null(std::span<const T> values) noexcept;
+
+/**
+ * @brief 按原顺序将非 null 值紧凑写入 out
+ *
+ * @param out 输出缓冲区，长度至少为 values.size()（向量实现整块写入），可与 values 为同一块内存
+ * @return size_t 写入的非 null 个数，缓冲区不足时返回 0 且不写入
+ */
+template<SentinelValue T>
+size_t compact_non_null(std::span<const T> values, std::span<T> out) noexcept;
+
+/**
+ * @brief 原地将 null 替换为 fill
+ *
+ * @return size_t 替换的个数
+ */
+template<SentinelValue T>
+size_t replace_null(std::span<T> values, T fill) noexcept;
+
 } // namespace sequoia::utils
\ No newline at end of file
@@ -0,0 +1,252 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <vector>
+#include <sequoia/utils/null.h>
+
+namespace sequoia::utils {
+
+// NullableColumn 支持的元素类型（SIMD 内核按这些类型显式实例化）
+template <typename T>
+concept NullableValue = SentinelValue<T>;
+
+namespace detail {
+
+[[nodiscard]] constexpr size_t bitmap_words(size_t size) noexcept {
+    return (size + 63) / 64;
+}
+
+// 求和结果类型：浮点累加为 double，整数累加为 64 位
+template <NullableValue T>
+using NullableSumType = std::conditional_t<std::is_floating_point_v<T>, double,
+                                           std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>>;
+
+// 以下内核在 simd/nullable.cc 中实现，运行时按 CPU 分派；bitmap 中超出 size 的位必须为 0
+
+// 将 values 转为有效位图，哨兵位置在 out 中写 T{}，返回有效元素个数
+template <NullableValue T>
+size_t sentinel_to_bitmap(const T* values, size_t size, T* out, uint64_t* bitmap) noexcept;
+
+// out[i] = 有效 ? values[i] : fill
+template <NullableValue T>
+void fill_null(const T* values, const uint64_t* bitmap, size_t size, T fill, T* out) noexcept;
+
+template <NullableValue T>
+[[nodiscard]] NullableSumType<T> sum_valid(const T* values, const uint64_t* bitmap, size_t size) noexcept;
+
+// 调用方保证至少有一个有效元素
+template <NullableValue T>
+[[nodiscard]] T min_valid(const T* values, const uint64_t* bitmap, size_t size) noexcept;
+
+template <NullableValue T>
+[[nodiscard]] T max_valid(const T* values, const uint64_t* bitmap, size_t size) noexcept;
+
+} // namespace detail
+
+/**
+ * @brief 带有效位图的列式数组（与 Apache Arrow 的 validity bitmap 布局兼容）
+ *
+ * @details
+ * 1. 第 i 个元素的有效位为位图第 i / 8 字节的第 i % 8 位（低位在前），1 表示有效；
+ *    位图按 64 位字存储，小端机器上其字节序列即 Arrow 布局，超出 size 的位恒为 0
+ * 2. null 位置的值恒为 T{}，values() 可直接交给不关心 null 的向量化代码
+ * 3. 与 Null<T> 哨兵编码的数组互转：from_sentinel / to_sentinel
+ * 4. 有效元素个数随写入维护，null_count 为 O(1)；from_sentinel 时对位图做 popcount；
+ *    fill_null、sum、min、max 按位图掩码跳过 null，
+ *    double / int64_t 运行时分派到 AVX-512 / AVX2 内核，其余类型逐字扫描位图
+ * 5. 浮点求和按 SIMD 通道分组累加，与顺序累加的结果在末位可能不同；有效位置不应为 NaN
+ *
+ * @code
+ * auto column = NullableColumn<double>::from_sentinel(prices);  // NaN -> null
+ * double total = column.sum();                                  // 跳过 null
+ * std::optional<double> low = column.min();                     // 全为 null 时为 std::nullopt
+ * @endcode
+ */
+template <NullableValue T>
+class NullableColumn {
+public:
+    using value_type = T;
+    using sum_type = detail::NullableSumType<T>;
+
+    NullableColumn() = default;
+
+    // 构造 size 个 null
+    explicit NullableColumn(size_t size) : values_(size), bitmap_(detail::bitmap_words(size)) {}
+
+    /**
+     * @brief 由 Null<T> 哨兵编码的数组构造，哨兵值（整数最大值 / NaN）视为 null
+     */
+    [[nodiscard]] static NullableColumn from_sentinel(std::span<const T> values) {
+        NullableColumn column;
+        column.values_.resize(values.size());
+        column.bitmap_.resize(detail::bitmap_words(values.size()));
+        column.valid_count_ = detail::sentinel_to_bitmap(values.data(), values.size(),
+                                                         column.values_.data(), column.bitmap_.data());
+        return column;
+    }
+
+    /**
+     * @brief 转为 Null<T> 哨兵编码，null 位置写入 Null<T>()
+     *
+     * @param out 输出缓冲区，长度至少为 size()
+     * @return size_t 写入的元素个数，缓冲区不足时返回 0 且不写入
+     */
+    size_t to_sentinel(std::span<T> out) const noexcept {
+        return fill_null(Null<T>(), out);
+    }
+
+    [[nodiscard]] std::vector<T> to_sentinel() const {
+        std::vector<T> result(size());
+        (void)to_sentinel(std::span<T>(result));
+        return result;
+    }
+
+    [[nodiscard]] size_t size() const noexcept {
+        return values_.size();
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return values_.empty();
+    }
+
+    [[nodiscard]] size_t valid_count() const noexcept {
+        return valid_count_;
+    }
+
+    [[nodiscard]] size_t null_count() const noexcept {
+        return size() - valid_count_;
+    }
+
+    [[nodiscard]] bool is_valid(size_t index) const noexcept {
+        return (bitmap_[index / 64] >> (index % 64)) & 1;
+    }
+
+    [[nodiscard]] bool is_null(size_t index) const noexcept {
+        return !is_valid(index);
+    }
+
+    // null 时返回 std::nullopt
+    [[nodiscard]] std::optional<T> get(size_t index) const noexcept {
+        if (is_null(index)) {
+            return std::nullopt;
+        }
+        return values_[index];
+    }
+
+    void push_back(T value) {
+        append(value, true);
+    }
+
+    void push_null() {
+        append(T{}, false);
+    }
+
+    void set(size_t index, T value) noexcept {
+        values_[index] = value;
+        set_valid(index, true);
+    }
+
+    void set_null(size_t index) noexcept {
+        values_[index] = T{};
+        set_valid(index, false);
+    }
+
+    void reserve(size_t capacity) {
+        values_.reserve(capacity);
+        bitmap_.reserve(detail::bitmap_words(capacity));
+    }
+
+    void clear() noexcept {
+        values_.clear();
+        bitmap_.clear();
+        valid_count_ = 0;
+    }
+
+    // 值数组，null 位置为 T{}
+    [[nodiscard]] std::span<const T> values() const noexcept {
+        return values_;
+    }
+
+    // Arrow 布局的有效位图，长度为 (size() + 7) / 8 字节
+    [[nodiscard]] std::span<const uint8_t> validity_bitmap() const noexcept {
+        return {reinterpret_cast<const uint8_t*>(bitmap_.data()), (size() + 7) / 8};
+    }
+
+    /**
+     * @brief 以 fill 替换 null 后写入 out
+     *
+     * @return size_t 写入的元素个数，缓冲区不足时返回 0 且不写入
+     */
+    size_t fill_null(T fill, std::span<T> out) const noexcept {
+        if (out.size() < size()) {
+            return 0;
+        }
+        detail::fill_null(values_.data(), bitmap_.data(), size(), fill, out.data());
+        return size();
+    }
+
+    [[nodiscard]] std::vector<T> fill_null(T fill) const {
+        std::vector<T> result(size());
+        (void)fill_null(fill, std::span<T>(result));
+        return result;
+    }
+
+    // 有效元素之和，全为 null 时为 0
+    [[nodiscard]] sum_type sum() const noexcept {
+        return detail::sum_valid(values_.data(), bitmap_.data(), size());
+    }
+
+    // 有效元素的最小值，全为 null 时返回 std::nullopt
+    [[nodiscard]] std::optional<T> min() const noexcept {
+        if (valid_count_ == 0) {
+            return std::nullopt;
+        }
+        return detail::min_valid(values_.data(), bitmap_.data(), size());
+    }
+
+    [[nodiscard]] std::optional<T> max() const noexcept {
+        if (valid_count_ == 0) {
+            return std::nullopt;
+        }
+        return detail::max_valid(values_.data(), bitmap_.data(), size());
+    }
+
+private:
+    void append(T value, bool valid) {
+        const size_t index = size();
+        values_.push_back(value);
+        if (index % 64 == 0) {
+            bitmap_.push_back(0);
+        }
+        if (valid) {
+            bitmap_.back() |= uint64_t{1} << (index % 64);
+            ++valid_count_;
+        }
+    }
+
+    void set_valid(size_t index, bool valid) noexcept {
+        const uint64_t bit = uint64_t{1} << (index % 64);
+        uint64_t& word = bitmap_[index / 64];
+        if (((word & bit) != 0) == valid) {
+            return;
+        }
+        word ^= bit;
+        if (valid) {
+            ++valid_count_;
+        } else {
+            --valid_count_;
+        }
+    }
+
+private:
+    std::vector<T> values_;
+    std::vector<uint64_t> bitmap_;
+    size_t valid_count_{0};
+};
+
+} // namespace sequoia::utils
@@ -1,118 +1,167 @@
 #include "params.h"
+#include "any_to_string.h"
 #include <sstream>
+#include <charconv>
+#include <cstdlib>
+#include <limits>
+#include <optional>
+#include <cctype>
+#include <typeindex>
+#include <unordered_map>
 
 namespace sequoia::utils {
 
 namespace detail {
 
-// C++20: 使用枚举类加强类型安全
+// C++20: 使用枚举类加强类型安全（顺序与 ParamValue 的备选类型一致）
 enum class ParamType : uint8_t {
     Unknown,
     Bool,
     Int,
     Int64,
     Double,
+    String,
+    DoubleVec,
+    Int64Vec,
+    Params,
 };
 
 // C++20: 使用结构化绑定和现代初始化
 struct TypeHandler {
-    std::string_view name;
-    void (*output)(std::ostream&, const std::any&);
-    void (*to_string)(std::ostream&, std::string_view, const std::any&);
-    bool (*equal)(const std::any&, const std::any&);
-    std::weak_ordering (*compare)(const std::any&, const std::any&);
+    const std::type_info* type;
+    AnyConverter converter;
+    void (*output)(std::ostream&, const ParamValue&);
+    void (*to_string)(std::ostream&, std::string_view, const ParamValue&);
+    bool (*equal)(const ParamValue&, const ParamValue&);
+    std::weak_ordering (*compare)(const ParamValue&, const ParamValue&);
+    std::any (*to_any)(const ParamValue&);
+    ParamValue (*from_any)(const std::any&);
 };
 
 // C++20: constexpr 字符串视图
 constexpr std::string_view kSplitStr = ", ";
 
-// C++20: 类型处理器的辅助函数
+// 单个值的文本格式，与 Params::from_string 的解析规则对应
+inline void write_value(std::ostream& os, bool value) {
+    os << std::boolalpha << value;
+}
+
 template<typename T>
-inline void output_value(std::ostream& os, const std::any& value, std::string_view type_name) {
-    if constexpr (std::is_same_v<T, bool>) {
-        os << "(" << type_name << "): " << std::boolalpha << std::any_cast<T>(value) << kSplitStr;
-    } else {
-        os << "(" << type_name << "): " << std::any_cast<T>(value) << kSplitStr;
+    requires std::is_integral_v<T>
+inline void write_value(std::ostream& os, T value) {
+    os << value;
+}
+
+// 最短往返表示；整数值补 ".0"，解析时不会被当作整数
+inline void write_value(std::ostream& os, double value) {
+    const std::string text = format_number(value);
+    os << text;
+    if (text.find_first_of(".eEn") == std::string::npos) {
+        os << ".0";
     }
 }
 
-template<typename T>
-inline void to_string_value(std::ostream& os, std::string_view key, const std::any& value) {
-    if constexpr (std::is_same_v<T, bool>) {
-        os << key << "=" << std::boolalpha << std::any_cast<T>(value) << kSplitStr;
-    } else {
-        os << key << "=" << std::any_cast<T>(value) << kSplitStr;
+inline void write_value(std::ostream& os, const std::string& value) {
+    os << '"';
+    for (const char c : value) {
+        if (c == '"' || c == '\\') {
+            os << '\\';
+        }
+        os << c;
+    }
+    os << '"';
+}
+
+// 空数组带类型前缀（int64[] / double[]），否则无法区分元素类型
+template<typename T, size_t N>
+inline void write_value(std::ostream& os, const SmallVector<T, N>& value) {
+    if (value.empty()) {
+        os << (std::is_integral_v<T> ? kParamTypeName<std::vector<int64_t>> : kParamTypeName<std::vector<double>>);
+        return;
+    }
+    os << "[";
+    for (size_t i = 0; i < value.size(); ++i) {
+        os << (i == 0 ? "" : kSplitStr);
+        write_value(os, value[i]);
     }
+    os << "]";
 }
 
+void write_value(std::ostream& os, const std::shared_ptr<const Params>& value);
+
 template<typename T>
-inline bool equal_value(const std::any& a, const std::any& b) {
-    return std::any_cast<T>(a) == std::any_cast<T>(b);
+inline void output_value(std::ostream& os, const ParamValue& value) {
+    os << "(" << kParamTypeName<T> << "): ";
+    write_value(os, std::get<ParamStorageT<T>>(value));
+    os << kSplitStr;
 }
 
 template<typename T>
-inline std::weak_ordering compare_value(const std::any& a, const std::any& b) {
-    auto val_a = std::any_cast<T>(a);
-    auto val_b = std::any_cast<T>(b);
-    
-    // 对于浮点数，使用标准比较
-    if constexpr (std::is_floating_point_v<T>) {
-        if (val_a < val_b) return std::weak_ordering::less;
-        if (val_a > val_b) return std::weak_ordering::greater;
-        return std::weak_ordering::equivalent;
+inline void to_string_value(std::ostream& os, std::string_view key, const ParamValue& value) {
+    os << key << "=";
+    write_value(os, std::get<ParamStorageT<T>>(value));
+    os << kSplitStr;
+}
+
+template<typename T>
+inline bool equal_value(const ParamValue& a, const ParamValue& b) {
+    if constexpr (std::same_as<T, Params>) {
+        return *std::get<ParamStorageT<T>>(a) == *std::get<ParamStorageT<T>>(b);
     } else {
-        // 对于整数和布尔值，可以直接使用 <=>
-        auto cmp = val_a <=> val_b;
+        return std::get<ParamStorageT<T>>(a) == std::get<ParamStorageT<T>>(b);
+    }
+}
+
+template<typename T>
+inline std::weak_ordering compare_value(const ParamValue& a, const ParamValue& b) {
+    if constexpr (std::same_as<T, Params>) {
+        return *std::get<ParamStorageT<T>>(a) <=> *std::get<ParamStorageT<T>>(b);
+    } else {
+        // 浮点数为 partial_ordering，NaN 视为等价
+        auto cmp = std::get<ParamStorageT<T>>(a) <=> std::get<ParamStorageT<T>>(b);
         if (cmp < 0) return std::weak_ordering::less;
         if (cmp > 0) return std::weak_ordering::greater;
         return std::weak_ordering::equivalent;
     }
 }
 
-// C++20: 使用指针简化
-inline const TypeHandler kBoolHandler = {
-    .name = "bool",
-    .output = [](std::ostream& os, const std::any& v) { output_value<bool>(os, v, "bool"); },
-    .to_string = [](std::ostream& os, std::string_view k, const std::any& v) { to_string_value<bool>(os, k, v); },
-    .equal = [](const std::any& a, const std::any& b) { return equal_value<bool>(a, b); },
-    .compare = [](const std::any& a, const std::any& b) { return compare_value<bool>(a, b); }
-};
-
-inline const TypeHandler kIntHandler = {
-    .name = "int",
-    .output = [](std::ostream& os, const std::any& v) { output_value<int>(os, v, "int"); },
-    .to_string = [](std::ostream& os, std::string_view k, const std::any& v) { to_string_value<int>(os, k, v); },
-    .equal = [](const std::any& a, const std::any& b) { return equal_value<int>(a, b); },
-    .compare = [](const std::any& a, const std::any& b) { return compare_value<int>(a, b); }
-};
-
-inline const TypeHandler kInt64Handler = {
-    .name = "int64",
-    .output = [](std::ostream& os, const std::any& v) { output_value<int64_t>(os, v, "int64"); },
-    .to_string = [](std::ostream& os, std::string_view k, const std::any& v) { to_string_value<int64_t>(os, k, v); },
-    .equal = [](const std::any& a, const std::any& b) { return equal_value<int64_t>(a, b); },
-    .compare = [](const std::any& a, const std::any& b) { return compare_value<int64_t>(a, b); }
-};
+template<typename T>
+inline std::any to_any_value(const ParamValue& value) {
+    return std::any(from_storage<T>(std::get<ParamStorageT<T>>(value)));
+}
 
-inline const TypeHandler kDoubleHandler = {
-    .name = "double",
-    .output = [](std::ostream& os, const std::any& v) { output_value<double>(os, v, "double"); },
-    .to_string = [](std::ostream& os, std::string_view k, const std::any& v) { to_string_value<double>(os, k, v); },
-    .equal = [](const std::any& a, const std::any& b) { return equal_value<double>(a, b); },
-    .compare = [](const std::any& a, const std::any& b) { return compare_value<double>(a, b); }
-};
+template<typename T>
+inline ParamValue from_any_value(const std::any& value) {
+    return ParamValue(std::in_place_type<ParamStorageT<T>>,
+                      to_storage(std::any_cast<const T&>(value)));
+}
 
-// C++20: 使用 constexpr 函数提高性能
-constexpr ParamType getParamType(const std::type_info& type) noexcept {
-    if (type == typeid(bool)) return ParamType::Bool;
-    if (type == typeid(int)) return ParamType::Int;
-    if (type == typeid(int64_t)) return ParamType::Int64;
-    if (type == typeid(double)) return ParamType::Double;
-    return ParamType::Unknown;
+template<typename T>
+constexpr TypeHandler makeHandler() noexcept {
+    return TypeHandler{
+        .type = &typeid(T),
+        .converter = make_any_converter<T>(kParamTypeName<T>),
+        .output = &output_value<T>,
+        .to_string = &to_string_value<T>,
+        .equal = &equal_value<T>,
+        .compare = &compare_value<T>,
+        .to_any = &to_any_value<T>,
+        .from_any = &from_any_value<T>,
+    };
 }
 
-inline ParamType getParamType(const std::any& value) noexcept {
-    return getParamType(value.type());
+inline const TypeHandler kBoolHandler = makeHandler<bool>();
+inline const TypeHandler kIntHandler = makeHandler<int>();
+inline const TypeHandler kInt64Handler = makeHandler<int64_t>();
+inline const TypeHandler kDoubleHandler = makeHandler<double>();
+inline const TypeHandler kStringHandler = makeHandler<std::string>();
+inline const TypeHandler kDoubleVecHandler = makeHandler<std::vector<double>>();
+inline const TypeHandler kInt64VecHandler = makeHandler<std::vector<int64_t>>();
+inline const TypeHandler kParamsHandler = makeHandler<Params>();
+
+// 存储值的类型直接由 variant 下标得到，无需 RTTI
+inline ParamType getParamType(const ParamValue& value) noexcept {
+    return static_cast<ParamType>(value.index() + 1);
 }
 
 // C++20: 使用 constexpr 查找表
@@ -122,10 +171,271 @@ inline const TypeHandler* getHandler(ParamType type) noexcept {
         case ParamType::Int: return &kIntHandler;
         case ParamType::Int64: return &kInt64Handler;
         case ParamType::Double: return &kDoubleHandler;
+        case ParamType::String: return &kStringHandler;
+        case ParamType::DoubleVec: return &kDoubleVecHandler;
+        case ParamType::Int64Vec: return &kInt64VecHandler;
+        case ParamType::Params: return &kParamsHandler;
         default: return nullptr;
     }
 }
 
+// std::any 的类型通过一次哈希查找得到；表由上述 TypeHandler 在首次使用时构建且不再修改，
+// Params 与 ConverterRegistry 共用，查找无需加锁
+inline ParamType getParamType(std::type_index type) noexcept {
+    static const std::unordered_map<std::type_index, ParamType> kAnyTypes = [] {
+        std::unordered_map<std::type_index, ParamType> types;
+        for (auto param_type = ParamType::Bool; const TypeHandler* handler = getHandler(param_type);
+             param_type = static_cast<ParamType>(static_cast<uint8_t>(param_type) + 1)) {
+            types.emplace(*handler->type, param_type);
+        }
+        return types;
+    }();
+    auto it = kAnyTypes.find(type);
+    return it == kAnyTypes.end() ? ParamType::Unknown : it->second;
+}
+
+inline ParamType getParamType(const std::any& value) noexcept {
+    return getParamType(value.type());
+}
+
+std::string_view param_type_name(const ParamValue& value) noexcept {
+    return param_type_name(value.index());
+}
+
+std::string_view param_type_name(size_t index) noexcept {
+    if (auto* handler = getHandler(static_cast<ParamType>(index + 1)); handler) {
+        return handler->converter.name;
+    }
+    return "unknown";
+}
+
+const AnyConverter* find_param_converter(std::type_index type) noexcept {
+    const TypeHandler* handler = getHandler(getParamType(type));
+    return handler ? &handler->converter : nullptr;
+}
+
+// 嵌套参数：{a=1, b=2}
+void write_value(std::ostream& os, const std::shared_ptr<const Params>& value) {
+    os << "{";
+    std::string_view split;
+    for (const auto& [key, item] : *value) {
+        os << split << key << "=";
+        std::visit([&os](const auto& v) { write_value(os, v); }, item);
+        split = kSplitStr;
+    }
+    os << "}";
+}
+
+// to_string() 输出格式的递归下降解析器
+class ParamsParser {
+public:
+    explicit ParamsParser(std::string_view text) noexcept : text_(text) {}
+
+    [[nodiscard]] Params parse() {
+        Params params = parseEntries('\0');
+        skipSpace();
+        if (pos_ != text_.size()) {
+            fail("unexpected character");
+        }
+        return params;
+    }
+
+private:
+    [[nodiscard]] Params parseEntries(char terminator) {
+        Params params;
+        while (true) {
+            skipSpace();
+            if (atEnd() || peek() == terminator) {
+                break;
+            }
+            const size_t eq = text_.find('=', pos_);
+            if (eq == std::string_view::npos) {
+                fail("missing '='");
+            }
+            const std::string key{trimRight(text_.substr(pos_, eq - pos_))};
+            pos_ = eq + 1;
+            parseValue(params, key);
+            skipSpace();
+            if (atEnd() || peek() != ',') {
+                break;
+            }
+            ++pos_;
+        }
+        if (terminator != '\0') {
+            expect(terminator);
+        }
+        return params;
+    }
+
+    void parseValue(Params& params, const std::string& key) {
+        skipSpace();
+        if (atEnd()) {
+            fail("missing value");
+        }
+        if (consume(kParamTypeName<std::vector<int64_t>>)) {
+            params.set(key, std::vector<int64_t>{});
+            return;
+        }
+        if (consume(kParamTypeName<std::vector<double>>)) {
+            params.set(key, std::vector<double>{});
+            return;
+        }
+        switch (peek()) {
+            case '"': params.set<std::string>(key, parseQuoted()); return;
+            case '[': parseVector(params, key); return;
+            case '{': ++pos_; params.set<Params>(key, parseEntries('}')); return;
+            default: parseScalar(params, key); return;
+        }
+    }
+
+    [[nodiscard]] std::string parseQuoted() {
+        expect('"');
+        std::string result;
+        while (!atEnd() && peek() != '"') {
+            if (peek() == '\\' && pos_ + 1 < text_.size()) {
+                ++pos_;
+            }
+            result.push_back(text_[pos_++]);
+        }
+        expect('"');
+        return result;
+    }
+
+    void parseVector(Params& params, const std::string& key) {
+        expect('[');
+        std::vector<std::string_view> tokens;
+        skipSpace();
+        while (!atEnd() && peek() != ']') {
+            tokens.push_back(nextToken());
+            if (tokens.back().empty()) {
+                fail("missing array element");
+            }
+            skipSpace();
+            if (!atEnd() && peek() == ',') {
+                ++pos_;
+            }
+            skipSpace();
+        }
+        expect(']');
+
+        std::vector<int64_t> integers;
+        for (const auto token : tokens) {
+            auto value = parseInteger(token);
+            if (!value) {
+                break;
+            }
+            integers.push_back(*value);
+        }
+        if (!tokens.empty() && integers.size() == tokens.size()) {
+            params.set(key, integers);
+            return;
+        }
+
+        std::vector<double> doubles;
+        doubles.reserve(tokens.size());
+        for (const auto token : tokens) {
+            auto value = parseDouble(token);
+            if (!value) {
+                fail("invalid number in array");
+            }
+            doubles.push_back(*value);
+        }
+        params.set(key, doubles);
+    }
+
+    void parseScalar(Params& params, const std::string& key) {
+        const std::string_view token = nextToken();
+        if (token.empty()) {
+            fail("missing value");
+        }
+        if (token == "true" || token == "false") {
+            params.set(key, token == "true");
+        } else if (auto integer = parseInteger(token)) {
+            if (*integer >= std::numeric_limits<int>::min() &&
+                *integer <= std::numeric_limits<int>::max()) {
+                params.set(key, static_cast<int>(*integer));
+            } else {
+                params.set(key, *integer);
+            }
+        } else if (auto number = parseDouble(token)) {
+            params.set(key, *number);
+        } else {
+            // 未加引号的文本按字符串处理
+            params.set<std::string>(key, std::string{token});
+        }
+    }
+
+    [[nodiscard]] static std::optional<int64_t> parseInteger(std::string_view token) noexcept {
+        int64_t value = 0;
+        const auto [ptr, ec] = std::from_chars(token.data(), token.data() + token.size(), value);
+        if (token.empty() || ec != std::errc{} || ptr != token.data() + token.size()) {
+            return std::nullopt;
+        }
+        return value;
+    }
+
+    [[nodiscard]] static std::optional<double> parseDouble(std::string_view token) noexcept {
+        return parse_number<double>(token);
+    }
+
+    // 读取到 ',' ']' '}' 之前的文本（去除尾部空白）
+    [[nodiscard]] std::string_view nextToken() noexcept {
+        const size_t begin = pos_;
+        while (!atEnd() && peek() != ',' && peek() != ']' && peek() != '}') {
+            ++pos_;
+        }
+        return trimRight(text_.substr(begin, pos_ - begin));
+    }
+
+    [[nodiscard]] static std::string_view trimRight(std::string_view str) noexcept {
+        while (!str.empty() && std::isspace(static_cast<unsigned char>(str.back()))) {
+            str.remove_suffix(1);
+        }
+        return str;
+    }
+
+    // 当前位置为 token（其后为值的结束位置）时跳过并返回 true
+    [[nodiscard]] bool consume(std::string_view token) noexcept {
+        if (text_.substr(pos_).starts_with(token)) {
+            const size_t end = pos_ + token.size();
+            size_t next = end;
+            while (next < text_.size() && std::isspace(static_cast<unsigned char>(text_[next]))) {
+                ++next;
+            }
+            if (next == text_.size() || text_[next] == ',' || text_[next] == '}') {
+                pos_ = end;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void skipSpace() noexcept {
+        while (!atEnd() && std::isspace(static_cast<unsigned char>(peek()))) {
+            ++pos_;
+        }
+    }
+
+    void expect(char c) {
+        if (atEnd() || peek() != c) {
+            fail(fmt::format("expected '{}'", c));
+        }
+        ++pos_;
+    }
+
+    [[noreturn]] void fail(std::string_view reason) const {
+        throw std::invalid_argument(fmt::format(
+            "Failed parse params at {}: {}", pos_, reason));
+    }
+
+    [[nodiscard]] bool atEnd() const noexcept { return pos_ >= text_.size(); }
+    [[nodiscard]] char peek() const noexcept { return text_[pos_]; }
+
+private:
+    std::string_view text_;
+    size_t pos_{0};
+};
+
 } // namespace detail
 
 // C++20: 使用 ranges 和现代语法简化输出
@@ -148,21 +458,51 @@ std::ostream& operator<<(std::ostream& os, const Params& params) {
     return os;
 }
 
+std::any get_any(const Params& params, const std::string& key) {
+    auto it = params.params_.find(key);
+    if (it == params.params_.end()) {
+        throw std::out_of_range(fmt::format("Param not found: {}", key));
+    }
+    return detail::getHandler(detail::getParamType(it->second))->to_any(it->second);
+}
+
+void set_any(Params& params, const std::string& key, const std::any& value) {
+    auto* handler = detail::getHandler(detail::getParamType(value));
+    if (handler == nullptr) {
+        throw std::invalid_argument(fmt::format(
+            "Param {} type unsupported: {}", key, value.type().name()));
+    }
+
+    auto it = params.params_.find(key);
+    if (it == params.params_.end()) {
+        params.params_.emplace(key, handler->from_any(value));
+        return;
+    }
+
+    if (detail::getParamType(it->second) != detail::getParamType(value)) {
+        throw std::logic_error(fmt::format(
+            "Param {} type mismatch: {} != {}",
+            key, detail::param_type_name(it->second), handler->converter.name));
+    }
+
+    it->second = handler->from_any(value);
+}
+
 bool Params::support(const std::any& value) noexcept {
     return detail::getParamType(value) != detail::ParamType::Unknown;
 }
 
+Params Params::from_string(std::string_view str) {
+    return detail::ParamsParser(str).parse();
+}
+
 std::string Params::type(const std::string& key) const {
     auto it = params_.find(key);
     if (it == params_.end()) {
         throw std::out_of_range(fmt::format("Param not found: {}", key));
     }
     
-    auto param_type = detail::getParamType(it->second);
-    if (auto* handler = detail::getHandler(param_type); handler) {
-        return std::string(handler->name);
-    }
-    return "unknown";
+    return std::string(detail::param_type_name(it->second));
 }
 
 // C++20: 使用 ranges 简化
@@ -224,11 +564,6 @@ std::weak_ordering Params::operator<=>(const Params& other) const noexcept {
             return std::weak_ordering::greater;
         }
         
-        // 如果类型未知，无法比较
-        if (type_lhs == detail::ParamType::Unknown) {
-            return std::weak_ordering::equivalent;
-        }
-        
         // 比较值
         if (auto* handler = detail::getHandler(type_lhs); handler) {
             auto cmp = handler->compare(it_lhs->second, it_rhs->second);
@@ -269,11 +604,6 @@ bool Params::operator==(const Params& other) const noexcept {
             return false;
         }
         
-        // 未知类型视为不相等
-        if (type_lhs == detail::ParamType::Unknown) {
-            return false;
-        }
-        
         // 值必须相等
         if (auto* handler = detail::getHandler(type_lhs); handler) {
             if (!handler->equal(it_lhs->second, it_rhs->second)) {
@@ -288,4 +618,4 @@ bool Params::operator==(const Params& other) const noexcept {
     return true;
 }
 
-} // namespace sequoia::utils
\ No newline at end of file
+} // namespace sequoia::utils
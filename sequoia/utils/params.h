@@ -1,45 +1,170 @@
-
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <map>
+#include <typeindex>
 #include <any>
+#include <memory>
+#include <variant>
+#include <vector>
 #include <concepts>
 #include <ranges>
 #include <compare>
 #include <fmt/format.h>
 #include <sequoia/utils/types.h>
+#include <sequoia/utils/small_vector.h>
 #include <sequoia/utils/log/log.h>
 
 namespace sequoia::utils {
 
+class Params;
+struct AnyConverter;
+
+template <typename Resource>
+class BasicArenaParams;
+
 // C++20 concept: 定义支持的参数类型
 template<typename T>
 concept SupportedParamType = std::same_as<T, bool> || 
                               std::same_as<T, int> || 
                               std::same_as<T, int64_t> || 
-                              std::same_as<T, double>;
+                              std::same_as<T, double> ||
+                              std::same_as<T, std::string> ||
+                              std::same_as<T, std::vector<double>> ||
+                              std::same_as<T, std::vector<int64_t>> ||
+                              std::same_as<T, Params>;
 
 // C++20 concept: 可转换的整数类型（int 和 int64_t 互相兼容）
 template<typename T>
 concept IntegerParamType = std::same_as<T, int> || std::same_as<T, int64_t>;
 
+// 数组参数的内联容量：元素个数不超过该值时不进行堆分配
+constexpr size_t PARAM_VECTOR_INLINE_SIZE = 4;
+
+using DoubleVec = SmallVector<double, PARAM_VECTOR_INLINE_SIZE>;
+using Int64Vec = SmallVector<int64_t, PARAM_VECTOR_INLINE_SIZE>;
+
+/**
+ * @brief 参数值的内部存储
+ *
+ * @details
+ * 1. std::variant 内联存放于 map 节点中，标量不会额外分配内存
+ * 2. 短字符串依赖 std::string 的 SSO，短数组使用 SmallVector 内联存储
+ * 3. 嵌套 Params 以不可变共享指针存放，拷贝时仅增加引用计数
+ * @note 备选类型的顺序与 detail::ParamType 保持一致
+ */
+using ParamValue = std::variant<bool, int, int64_t, double, std::string,
+                                DoubleVec, Int64Vec, std::shared_ptr<const Params>>;
+
+namespace detail {
+
+// 对外类型 -> 内部存储类型
+template <typename T>
+struct ParamStorage {
+    using type = T;
+};
+
+template <>
+struct ParamStorage<std::vector<double>> {
+    using type = DoubleVec;
+};
+
+template <>
+struct ParamStorage<std::vector<int64_t>> {
+    using type = Int64Vec;
+};
+
+template <>
+struct ParamStorage<Params> {
+    using type = std::shared_ptr<const Params>;
+};
+
+template <typename T>
+using ParamStorageT = typename ParamStorage<T>::type;
+
+// 类型名称（用于 type() 与错误信息）
+template <typename T>
+inline constexpr std::string_view kParamTypeName = "unknown";
+template <> inline constexpr std::string_view kParamTypeName<bool> = "bool";
+template <> inline constexpr std::string_view kParamTypeName<int> = "int";
+template <> inline constexpr std::string_view kParamTypeName<int64_t> = "int64";
+template <> inline constexpr std::string_view kParamTypeName<double> = "double";
+template <> inline constexpr std::string_view kParamTypeName<std::string> = "string";
+template <> inline constexpr std::string_view kParamTypeName<std::vector<double>> = "double[]";
+template <> inline constexpr std::string_view kParamTypeName<std::vector<int64_t>> = "int64[]";
+template <> inline constexpr std::string_view kParamTypeName<Params> = "params";
+
+template <typename T>
+inline constexpr bool kIsParamVector = std::same_as<T, std::vector<double>> || 
+                                       std::same_as<T, std::vector<int64_t>>;
+
+template <typename T>
+[[nodiscard]] ParamStorageT<T> to_storage(const T& value) {
+    if constexpr (kIsParamVector<T>) {
+        return ParamStorageT<T>(value);
+    } else if constexpr (std::same_as<T, Params>) {
+        return std::make_shared<const T>(value);
+    } else {
+        return value;
+    }
+}
+
+template <typename T>
+[[nodiscard]] T from_storage(const ParamStorageT<T>& value) {
+    if constexpr (kIsParamVector<T>) {
+        return value.to_vector();
+    } else if constexpr (std::same_as<T, Params>) {
+        return *value;
+    } else {
+        return value;
+    }
+}
+
+// 存储值的类型名称
+[[nodiscard]] std::string_view param_type_name(const ParamValue& value) noexcept;
+
+// 按 ParamValue 备选类型下标获取类型名称
+[[nodiscard]] std::string_view param_type_name(size_t index) noexcept;
+
+// Params 内置类型的文本转换函数（名称同 Params::type()），不支持的类型返回 nullptr；
+// 内置类型表不可变，可并发调用，返回的指针在进程生命周期内有效
+[[nodiscard]] const AnyConverter* find_param_converter(std::type_index type) noexcept;
+
+} // namespace detail
+
 class Params {
 public:
-    using ParamMap = std::map<std::string, std::any>;
+    using ParamMap = std::map<std::string, ParamValue>;
     using const_iterator = ParamMap::const_iterator;
     friend std::ostream& operator<<(std::ostream& os, const Params& params);
     friend std::any get_any(const Params&, const std::string&);
     friend void set_any(Params&, const std::string&, const std::any&);
+    template <typename Resource>
+    friend class BasicArenaParams;
 
     // 检查类型是否支持
     static constexpr bool is_supported_type(const std::type_info& type) noexcept {
         return type == typeid(bool) || type == typeid(int) || 
-               type == typeid(int64_t) || type == typeid(double);
+               type == typeid(int64_t) || type == typeid(double) ||
+               type == typeid(std::string) || type == typeid(std::vector<double>) ||
+               type == typeid(std::vector<int64_t>) || type == typeid(Params);
     }
     
     static bool support(const std::any& value) noexcept;
 
+    /**
+     * @brief 从 to_string() 的输出格式解析参数集
+     * 
+     * @param str 形如 `a=1, b=2.5, c=true, d="text", e=[1, 2], f={g=1}` 的字符串
+     * @return Params 解析结果
+     * @throws std::invalid_argument 格式错误
+     * 
+     * @details 整数优先解析为 int，超出范围时解析为 int64；带小数点、指数或 inf/nan 的数值解析为 double；
+     * 数组中全部为整数时解析为 int64[]，否则为 double[]；空数组写作 int64[] / double[]（单独的 [] 按 double[]）
+     */
+    [[nodiscard]] static Params from_string(std::string_view str);
+
 public:
     // 使用 ranges 返回键的视图
     auto keys_view() const {
@@ -76,6 +201,11 @@ public:
         requires SupportedParamType<ValueType>
     void set(const std::string& key, const ValueType& value);
     
+    // 字符串字面量按 std::string 存储
+    void set(const std::string& key, const char* value) {
+        set<std::string>(key, value);
+    }
+    
     // 删除参数
     bool remove(const std::string& key) noexcept {
         return params_.erase(key) > 0;
@@ -112,23 +242,23 @@ ValueType Params::get(const std::string& key) const {
         throw std::out_of_range(fmt::format("Param not found: {}", key));
     }
     
-    try {
-        return std::any_cast<ValueType>(it->second);
-    } catch (const std::bad_any_cast& e) {
-        // 尝试整数类型之间的转换（int <-> int64_t）
-        if constexpr (IntegerParamType<ValueType>) {
-            if (it->second.type() == typeid(int) && std::is_same_v<ValueType, int64_t>) {
-                return static_cast<int64_t>(std::any_cast<int>(it->second));
-            } else if (it->second.type() == typeid(int64_t) && std::is_same_v<ValueType, int>) {
-                return static_cast<int>(std::any_cast<int64_t>(it->second));
-            }
+    if (const auto* value = std::get_if<detail::ParamStorageT<ValueType>>(&it->second)) {
+        return detail::from_storage<ValueType>(*value);
+    }
+    
+    // 尝试整数类型之间的转换（int <-> int64_t）
+    if constexpr (IntegerParamType<ValueType>) {
+        if (const auto* value = std::get_if<int>(&it->second)) {
+            return static_cast<ValueType>(*value);
+        }
+        if (const auto* value = std::get_if<int64_t>(&it->second)) {
+            return static_cast<ValueType>(*value);
         }
-        
-        throw std::runtime_error(fmt::format(
-            "Failed convert param {} from {} to {}: {}", 
-            key, it->second.type().name(), typeid(ValueType).name(), 
-            e.what()));
     }
+        
+    throw std::runtime_error(fmt::format(
+        "Failed convert param {} from {} to {}", 
+        key, detail::param_type_name(it->second), detail::kParamTypeName<ValueType>));
 }
 
 template <typename ValueType>
@@ -145,60 +275,39 @@ ValueType Params::try_get(const std::string& key,
 template <typename ValueType>
     requires SupportedParamType<ValueType>
 void Params::set(const std::string& key, const ValueType& value) {
+    using StorageType = detail::ParamStorageT<ValueType>;
+    
     // 如果参数不存在，直接设置
-    if (!have(key)) {
-        params_[key] = value;
+    auto it = params_.find(key);
+    if (it == params_.end()) {
+        params_.emplace(key, ParamValue(std::in_place_type<StorageType>, 
+                                        detail::to_storage(value)));
         return;
     }
     
-    // 检查类型兼容性
-    const auto& existing_type = params_[key].type();
-    const auto& new_type = typeid(ValueType);
+    // 检查类型兼容性，允许 int 和 int64_t 之间的转换
+    bool compatible = std::holds_alternative<StorageType>(it->second);
+    if constexpr (IntegerParamType<ValueType>) {
+        compatible = compatible || std::holds_alternative<int>(it->second) || 
+                     std::holds_alternative<int64_t>(it->second);
+    }
     
-    if (existing_type != new_type) {
-        // 允许 int 和 int64_t 之间的转换
-        if constexpr (IntegerParamType<ValueType>) {
-            if (existing_type == typeid(int) || existing_type == typeid(int64_t)) {
-                // 允许转换
-            } else {
-                throw std::logic_error(fmt::format(
-                    "Param {} type mismatch: {} != {}", 
-                    key, existing_type.name(), new_type.name()));
-            }
-        } else {
-            throw std::logic_error(fmt::format(
-                "Param {} type mismatch: {} != {}", 
-                key, existing_type.name(), new_type.name()));
-        }
+    if (!compatible) {
+        throw std::logic_error(fmt::format(
+            "Param {} type mismatch: {} != {}", 
+            key, detail::param_type_name(it->second), detail::kParamTypeName<ValueType>));
     }
     
-    params_[key] = value;
+    it->second.template emplace<StorageType>(detail::to_storage(value));
 }
 
 // 获取原始 std::any 值（不使用特化，避免与 concept 冲突）
-inline std::any get_any(const Params& params, const std::string& key) {
-    auto it = params.params_.find(key);
-    if (it == params.params_.end()) {
-        throw std::out_of_range(fmt::format("Param not found: {}", key));
-    }
-    return it->second;
-}
+// 数组以 std::vector 返回，嵌套参数以 Params 返回
+std::any get_any(const Params& params, const std::string& key);
 
 // 设置 std::any 值（不使用特化，避免与 concept 冲突）
-inline void set_any(Params& params, const std::string& key, const std::any& value) {
-    if (!params.have(key)) {
-        params.params_[key] = value;
-        return;
-    }
-    
-    if (params.params_[key].type() != value.type()) {
-        throw std::logic_error(fmt::format(
-            "Param {} type mismatch: {} != {}", 
-            key, params.params_[key].type().name(), value.type().name()));
-    }
-    
-    params.params_[key] = value;
-}
+// 不支持的类型抛出 std::invalid_argument
+void set_any(Params& params, const std::string& key, const std::any& value);
 
 // C++20: 使用更现代的宏定义，增强类型安全
 #define PARAMETERS_SUPPORT \
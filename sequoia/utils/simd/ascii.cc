@@ -0,0 +1,106 @@
+#include "../encoding.h"
+#include "cpu.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+#if SEQUOIA_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace sequoia::utils::detail {
+
+namespace {
+
+constexpr uint64_t kHighBits = 0x8080808080808080ULL;
+
+// 每次检查 8 字节
+size_t asciiPrefixScalar(const char* data, size_t len) noexcept {
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        if ((word & kHighBits) != 0) {
+            break;
+        }
+    }
+    while (i < len && static_cast<unsigned char>(data[i]) < 0x80) {
+        ++i;
+    }
+    return i;
+}
+
+#if SEQUOIA_SIMD_X86
+
+size_t asciiPrefixSse2(const char* data, size_t len) noexcept {
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        const int mask = _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)));
+        if (mask != 0) {
+            return i + static_cast<size_t>(std::countr_zero(static_cast<uint32_t>(mask)));
+        }
+    }
+    return i + asciiPrefixScalar(data + i, len - i);
+}
+
+SEQUOIA_TARGET_AVX2
+size_t asciiPrefixAvx2(const char* data, size_t len) noexcept {
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        const int mask = _mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)));
+        if (mask != 0) {
+            return i + static_cast<size_t>(std::countr_zero(static_cast<uint32_t>(mask)));
+        }
+    }
+    return i + asciiPrefixSse2(data + i, len - i);
+}
+
+// 整块写入输出，遇到非 ASCII 字节时只计入其之前的部分（多写的字节由后续输出覆盖）
+SEQUOIA_TARGET_AVX2
+size_t copyAsciiAvx2(const char* src, char* dst, size_t len) noexcept {
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), block);
+        const int mask = _mm256_movemask_epi8(block);
+        if (mask != 0) {
+            return i + static_cast<size_t>(std::countr_zero(static_cast<uint32_t>(mask)));
+        }
+    }
+    const size_t tail = asciiPrefixScalar(src + i, len - i);
+    std::memcpy(dst + i, src + i, tail);
+    return i + tail;
+}
+
+#endif // SEQUOIA_SIMD_X86
+
+} // namespace
+
+size_t ascii_prefix(std::string_view input) noexcept {
+#if SEQUOIA_SIMD_X86
+    const simd::SimdLevel level = simd::activeLevel();
+    if (level >= simd::SimdLevel::AVX2) {
+        return asciiPrefixAvx2(input.data(), input.size());
+    }
+    if (level >= simd::SimdLevel::SSE2) {
+        return asciiPrefixSse2(input.data(), input.size());
+    }
+#endif
+    return asciiPrefixScalar(input.data(), input.size());
+}
+
+size_t copy_ascii(std::string_view input, std::span<char> out) noexcept {
+    const size_t len = std::min(input.size(), out.size());
+#if SEQUOIA_SIMD_X86
+    if (simd::activeLevel() >= simd::SimdLevel::AVX2) {
+        return copyAsciiAvx2(input.data(), out.data(), len);
+    }
+#endif
+    const size_t count = ascii_prefix(input.substr(0, len));
+    std::memcpy(out.data(), input.data(), count);
+    return count;
+}
+
+} // namespace sequoia::utils::detail
@@ -0,0 +1,96 @@
+#include "../arithmetic.h"
+#include "cpu.h"
+
+#if SEQUOIA_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace sequoia::utils {
+
+namespace {
+
+// 大小写转换区间：[first, first + 25] 内的字节加上/减去 0x20
+struct CaseRange {
+    char first;
+    char last;
+    char delta;
+};
+
+constexpr CaseRange kToLower{'A', 'Z', 0x20};
+constexpr CaseRange kToUpper{'a', 'z', -0x20};
+
+void convertScalar(const char* src, size_t len, char* dst, CaseRange range) noexcept {
+    for (size_t i = 0; i < len; ++i) {
+        const char c = src[i];
+        dst[i] = (c >= range.first && c <= range.last) ? static_cast<char>(c + range.delta) : c;
+    }
+}
+
+#if SEQUOIA_SIMD_X86
+
+// 有符号比较：>= 0x80 的字节为负数，不会落入区间
+size_t convertSse2(const char* src, size_t len, char* dst, CaseRange range) noexcept {
+    const __m128i lower_bound = _mm_set1_epi8(static_cast<char>(range.first - 1));
+    const __m128i upper_bound = _mm_set1_epi8(static_cast<char>(range.last + 1));
+    const __m128i delta = _mm_set1_epi8(range.delta);
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i in_range = _mm_and_si128(_mm_cmpgt_epi8(chars, lower_bound),
+                                               _mm_cmplt_epi8(chars, upper_bound));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                         _mm_add_epi8(chars, _mm_and_si128(in_range, delta)));
+    }
+    return i;
+}
+
+SEQUOIA_TARGET_AVX2
+size_t convertAvx2(const char* src, size_t len, char* dst, CaseRange range) noexcept {
+    const __m256i lower_bound = _mm256_set1_epi8(static_cast<char>(range.first - 1));
+    const __m256i upper_bound = _mm256_set1_epi8(static_cast<char>(range.last + 1));
+    const __m256i delta = _mm256_set1_epi8(range.delta);
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        const __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        const __m256i in_range = _mm256_and_si256(_mm256_cmpgt_epi8(chars, lower_bound),
+                                                  _mm256_cmpgt_epi8(upper_bound, chars));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                            _mm256_add_epi8(chars, _mm256_and_si256(in_range, delta)));
+    }
+    return i;
+}
+
+#endif // SEQUOIA_SIMD_X86
+
+size_t convert(std::string_view str, std::span<char> out, CaseRange range) noexcept {
+    if (out.size() < str.size()) {
+        return 0;
+    }
+
+    const char* src = str.data();
+    char* dst = out.data();
+    size_t done = 0;
+#if SEQUOIA_SIMD_X86
+    const simd::SimdLevel level = simd::activeLevel();
+    if (level >= simd::SimdLevel::AVX2) {
+        done = convertAvx2(src, str.size(), dst, range);
+    }
+    if (level >= simd::SimdLevel::SSE2) {
+        done += convertSse2(src + done, str.size() - done, dst + done, range);
+    }
+#endif
+    convertScalar(src + done, str.size() - done, dst + done, range);
+    return str.size();
+}
+
+} // namespace
+
+size_t toLower(std::string_view str, std::span<char> out) noexcept {
+    return convert(str, out, kToLower);
+}
+
+size_t toUpper(std::string_view str, std::span<char> out) noexcept {
+    return convert(str, out, kToUpper);
+}
+
+} // namespace sequoia::utils
@@ -0,0 +1,58 @@
+#include "cpu.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace sequoia::utils::simd {
+
+namespace {
+
+SimdLevel detect() noexcept {
+#if SEQUOIA_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+        return SimdLevel::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return SimdLevel::AVX2;
+    }
+    // x86-64 基线保证支持 SSE2
+    return SimdLevel::SSE2;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+std::atomic<SimdLevel>& activeLevelRef() noexcept {
+    static std::atomic<SimdLevel> level{detectedLevel()};
+    return level;
+}
+
+} // namespace
+
+SimdLevel detectedLevel() noexcept {
+    static const SimdLevel level = detect();
+    return level;
+}
+
+SimdLevel activeLevel() noexcept {
+    return activeLevelRef().load(std::memory_order_relaxed);
+}
+
+SimdLevel setMaxLevel(SimdLevel level) noexcept {
+    const SimdLevel effective = std::min(level, detectedLevel());
+    activeLevelRef().store(effective, std::memory_order_relaxed);
+    return effective;
+}
+
+std::string_view levelName(SimdLevel level) noexcept {
+    switch (level) {
+        case SimdLevel::Scalar: return "scalar";
+        case SimdLevel::SSE2: return "sse2";
+        case SimdLevel::AVX2: return "avx2";
+        case SimdLevel::AVX512: return "avx512";
+    }
+    return "unknown";
+}
+
+} // namespace sequoia::utils::simd
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+// x86-64 + GCC/Clang 时启用 SSE2/AVX2/AVX-512 内核（通过 target 属性按函数开启指令集）
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SEQUOIA_SIMD_X86 1
+#define SEQUOIA_TARGET_AVX2 __attribute__((target("avx2")))
+#define SEQUOIA_TARGET_AVX512 __attribute__((target("avx512f,avx512bw")))
+#else
+#define SEQUOIA_SIMD_X86 0
+#define SEQUOIA_TARGET_AVX2
+#define SEQUOIA_TARGET_AVX512
+#endif
+
+namespace sequoia::utils::simd {
+
+/**
+ * @brief SIMD 指令集等级（由低到高）
+ */
+enum class SimdLevel : uint8_t {
+    Scalar,
+    SSE2,
+    AVX2,
+    AVX512,
+};
+
+/**
+ * @brief 当前 CPU 支持的最高指令集（进程内只检测一次）
+ */
+[[nodiscard]] SimdLevel detectedLevel() noexcept;
+
+/**
+ * @brief 各内核运行时分派使用的指令集，不超过 detectedLevel()
+ */
+[[nodiscard]] SimdLevel activeLevel() noexcept;
+
+/**
+ * @brief 限制运行时分派可使用的最高指令集（用于测试和基准对比）
+ * 
+ * @param level 期望的最高等级
+ * @return SimdLevel 实际生效的等级
+ */
+SimdLevel setMaxLevel(SimdLevel level) noexcept;
+
+[[nodiscard]] std::string_view levelName(SimdLevel level) noexcept;
+
+} // namespace sequoia::utils::simd
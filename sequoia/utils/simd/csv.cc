@@ -0,0 +1,232 @@
+#include "../csv.h"
+#include "../split.h"
+#include "cpu.h"
+
+#include <algorithm>
+#include <bit>
+
+#if SEQUOIA_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace sequoia::utils {
+
+namespace {
+
+constexpr size_t kBlockSize = 64;
+
+// 返回块内结构字符的位图（第 i 位对应 block[i]），len 不超过 kBlockSize
+using StructuralScanner = uint64_t (*)(const char* block, size_t len, const DelimiterSet& structurals) noexcept;
+
+uint64_t scanScalar(const char* block, size_t len, const DelimiterSet& structurals) noexcept {
+    uint64_t mask = 0;
+    for (size_t i = 0; i < len; ++i) {
+        mask |= static_cast<uint64_t>(structurals.contains(block[i])) << i;
+    }
+    return mask;
+}
+
+#if SEQUOIA_SIMD_X86
+
+SEQUOIA_TARGET_AVX2
+uint64_t scanAvx2(const char* block, size_t len, const DelimiterSet& structurals) noexcept {
+    if (len < kBlockSize) {
+        return scanScalar(block, len, structurals);
+    }
+    const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+    const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32));
+    __m256i lo_hits = _mm256_setzero_si256();
+    __m256i hi_hits = _mm256_setzero_si256();
+    for (const char c : structurals.simd_chars()) {
+        const __m256i needle = _mm256_set1_epi8(c);
+        lo_hits = _mm256_or_si256(lo_hits, _mm256_cmpeq_epi8(lo, needle));
+        hi_hits = _mm256_or_si256(hi_hits, _mm256_cmpeq_epi8(hi, needle));
+    }
+    const auto lo_mask = static_cast<uint32_t>(_mm256_movemask_epi8(lo_hits));
+    const auto hi_mask = static_cast<uint32_t>(_mm256_movemask_epi8(hi_hits));
+    return (static_cast<uint64_t>(hi_mask) << 32) | lo_mask;
+}
+
+#endif // SEQUOIA_SIMD_X86
+
+StructuralScanner selectScanner() noexcept {
+#if SEQUOIA_SIMD_X86
+    if (simd::activeLevel() >= simd::SimdLevel::AVX2) {
+        return scanAvx2;
+    }
+#endif
+    return scanScalar;
+}
+
+// 单次 tokenize 调用的解析状态
+class TokenizeState {
+public:
+    TokenizeState(const CsvDialect& dialect, std::string_view buffer,
+                  std::vector<CsvField>& out, std::vector<uint32_t>& record_ends) noexcept
+        : dialect_(dialect), data_(buffer.data()), size_(buffer.size()), out_(out), record_ends_(record_ends) {}
+
+    // 处理 pos 处的结构字符
+    void process(size_t pos) {
+        if (pos < skip_) {
+            return;
+        }
+        const char c = data_[pos];
+        if (in_quotes_) {
+            if (c == dialect_.escape && dialect_.escape != '\0') {
+                escaped_ = true;
+                skip_ = pos + 2;
+            } else if (c == dialect_.quote && dialect_.quote != '\0') {
+                // 位于缓冲区末尾的引号之后没有换行，非最后一块时整条记录会被回滚，无需区分跨块的 ""
+                if (dialect_.escape == '\0' && pos + 1 < size_ && data_[pos + 1] == dialect_.quote) {
+                    escaped_ = true;
+                    skip_ = pos + 2;
+                } else {
+                    quote_end_ = pos;
+                    in_quotes_ = false;
+                }
+            }
+            return;
+        }
+
+        if (c == dialect_.delimiter) {
+            emitField(pos);
+            field_start_ = pos + 1;
+        } else if (c == '\n') {
+            size_t end = pos;
+            if (!quoted_ && end > field_start_ && data_[end - 1] == '\r') {
+                --end;
+            }
+            emitField(end);
+            endRecord(pos + 1);
+        } else if (c == dialect_.quote && dialect_.quote != '\0' && pos == field_start_) {
+            in_quotes_ = true;
+            quoted_ = true;
+        }
+    }
+
+    // 所有结构字符处理完毕，返回消费的字节数
+    size_t finish(bool final) {
+        if (!final) {
+            return rollback();
+        }
+        if (field_start_ < size_ || out_.size() > record_begin_ || in_quotes_) {
+            if (in_quotes_) {
+                // 未闭合的引号字段延伸到末尾
+                quote_end_ = size_;
+                in_quotes_ = false;
+            }
+            size_t end = size_;
+            if (!quoted_ && end > field_start_ && data_[end - 1] == '\r') {
+                --end;
+            }
+            emitField(end);
+            endRecord(size_);
+        }
+        return consumed_;
+    }
+
+private:
+    void emitField(size_t end) {
+        CsvField field;
+        if (quoted_) {
+            field.offset = static_cast<uint32_t>(field_start_ + 1);
+            field.size = static_cast<uint32_t>(quote_end_ - field_start_ - 1);
+        } else {
+            field.offset = static_cast<uint32_t>(field_start_);
+            field.size = static_cast<uint32_t>(end - field_start_);
+        }
+        field.quoted = quoted_;
+        field.escaped = escaped_;
+        out_.push_back(field);
+        quoted_ = false;
+        escaped_ = false;
+    }
+
+    void endRecord(size_t next) {
+        // 空行只产生一个空字段
+        if (dialect_.skip_empty_lines && out_.size() == record_begin_ + 1 &&
+            out_.back().size == 0 && !out_.back().quoted) {
+            out_.pop_back();
+        } else {
+            record_ends_.push_back(static_cast<uint32_t>(out_.size()));
+        }
+        record_begin_ = out_.size();
+        field_start_ = next;
+        consumed_ = next;
+    }
+
+    // 丢弃未完成的记录
+    size_t rollback() {
+        out_.resize(record_begin_);
+        return consumed_;
+    }
+
+    const CsvDialect& dialect_;
+    const char* data_;
+    size_t size_;
+    std::vector<CsvField>& out_;
+    std::vector<uint32_t>& record_ends_;
+
+    size_t field_start_{0};
+    size_t quote_end_{0};
+    size_t skip_{0};
+    size_t record_begin_{0};
+    size_t consumed_{0};
+    bool in_quotes_{false};
+    bool quoted_{false};
+    bool escaped_{false};
+};
+
+} // namespace
+
+CsvTokenizer::CsvTokenizer(CsvDialect dialect) noexcept : dialect_(dialect) {
+    // 转义符与引号相同即双引号转义
+    if (dialect_.escape == dialect_.quote) {
+        dialect_.escape = '\0';
+    }
+}
+
+size_t CsvTokenizer::tokenize(std::string_view buffer, CsvIndex& index, bool final) const {
+    index.clear();
+    if (buffer.size() > kMaxBufferSize) {
+        buffer = buffer.substr(0, kMaxBufferSize);
+        final = false;
+    }
+
+    const char structural_chars[] = {dialect_.delimiter, '\n', dialect_.quote, dialect_.escape};
+    const size_t structural_count = dialect_.quote == '\0' ? 2 : (dialect_.escape == '\0' ? 3 : 4);
+    const DelimiterSet structurals(std::string_view(structural_chars, structural_count));
+    const StructuralScanner scan = selectScanner();
+
+    TokenizeState state(dialect_, buffer, index.fields_, index.record_ends_);
+    for (size_t block = 0; block < buffer.size(); block += kBlockSize) {
+        const size_t len = std::min(kBlockSize, buffer.size() - block);
+        uint64_t mask = scan(buffer.data() + block, len, structurals);
+        while (mask != 0) {
+            state.process(block + static_cast<size_t>(std::countr_zero(mask)));
+            mask &= mask - 1;
+        }
+    }
+    return state.finish(final);
+}
+
+void CsvTokenizer::unescape(std::string_view buffer, const CsvField& field, std::string& out) const {
+    const std::string_view value = field.view(buffer);
+    if (!field.escaped) {
+        out.assign(value);
+        return;
+    }
+
+    out.clear();
+    out.reserve(value.size());
+    const char escape = dialect_.escape != '\0' ? dialect_.escape : dialect_.quote;
+    for (size_t i = 0; i < value.size(); ++i) {
+        // 转义符后的字符按原样输出（"" -> "，\x -> x）
+        if (value[i] == escape && i + 1 < value.size()) {
+            ++i;
+        }
+        out.push_back(value[i]);
+    }
+}
+
+} // namespace sequoia::utils
@@ -0,0 +1,303 @@
+#include "../arithmetic.h"
+#include "cpu.h"
+
+#include <array>
+#include <cstring>
+
+#if SEQUOIA_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace sequoia::utils {
+
+namespace {
+
+// 每字节两个字符的查找表
+using HexTable = std::array<std::array<char, 2>, 256>;
+
+constexpr HexTable makeHexTable(const char* digits) noexcept {
+    HexTable table{};
+    for (size_t i = 0; i < table.size(); ++i) {
+        table[i] = {digits[i >> 4], digits[i & 0x0F]};
+    }
+    return table;
+}
+
+constexpr HexTable kUpperTable = makeHexTable("0123456789ABCDEF");
+constexpr HexTable kLowerTable = makeHexTable("0123456789abcdef");
+
+// 十六进制字符 -> 数值，非法字符为 -1
+constexpr std::array<int8_t, 256> makeNibbleTable() noexcept {
+    std::array<int8_t, 256> table{};
+    for (size_t i = 0; i < table.size(); ++i) {
+        table[i] = -1;
+    }
+    for (int i = 0; i < 10; ++i) {
+        table['0' + i] = static_cast<int8_t>(i);
+    }
+    for (int i = 0; i < 6; ++i) {
+        table['A' + i] = static_cast<int8_t>(10 + i);
+        table['a' + i] = static_cast<int8_t>(10 + i);
+    }
+    return table;
+}
+
+constexpr std::array<int8_t, 256> kNibbleTable = makeNibbleTable();
+
+const HexTable& hexTable(HexCase hex_case) noexcept {
+    return hex_case == HexCase::Upper ? kUpperTable : kLowerTable;
+}
+
+// 'A' - '0' - 10 或 'a' - '0' - 10
+constexpr char alphaOffset(HexCase hex_case) noexcept {
+    return hex_case == HexCase::Upper ? 7 : 39;
+}
+
+void encodeScalar(const unsigned char* src, size_t len, char* dst, HexCase hex_case) noexcept {
+    const HexTable& table = hexTable(hex_case);
+    for (size_t i = 0; i < len; ++i) {
+        std::memcpy(dst + i * 2, table[src[i]].data(), 2);
+    }
+}
+
+// 返回 false 表示遇到非法字符
+bool decodeScalar(const unsigned char* src, size_t len, char* dst) noexcept {
+    for (size_t i = 0; i < len; ++i) {
+        const int8_t high = kNibbleTable[src[i * 2]];
+        const int8_t low = kNibbleTable[src[i * 2 + 1]];
+        if ((high | low) < 0) {
+            return false;
+        }
+        dst[i] = static_cast<char>((high << 4) | low);
+    }
+    return true;
+}
+
+#if SEQUOIA_SIMD_X86
+
+// ==================== SSE2 ====================
+
+inline __m128i nibbleToAsciiSse2(__m128i nibbles, __m128i alpha_offset) noexcept {
+    const __m128i gt9 = _mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9));
+    const __m128i ascii = _mm_add_epi8(nibbles, _mm_set1_epi8('0'));
+    return _mm_add_epi8(ascii, _mm_and_si128(gt9, alpha_offset));
+}
+
+// 每次处理 16 字节 -> 32 字符，返回已处理的字节数
+size_t encodeSse2(const unsigned char* src, size_t len, char* dst, HexCase hex_case) noexcept {
+    const __m128i mask = _mm_set1_epi8(0x0F);
+    const __m128i alpha_offset = _mm_set1_epi8(alphaOffset(hex_case));
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i high = nibbleToAsciiSse2(_mm_and_si128(_mm_srli_epi16(in, 4), mask), alpha_offset);
+        const __m128i low = nibbleToAsciiSse2(_mm_and_si128(in, mask), alpha_offset);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 2), _mm_unpacklo_epi8(high, low));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 2 + 16), _mm_unpackhi_epi8(high, low));
+    }
+    return i;
+}
+
+// 16 个字符 -> 8 个 16 位数值（每个 < 256），invalid 累积非法字符掩码
+inline __m128i decodeBlockSse2(__m128i chars, __m128i& invalid) noexcept {
+    const __m128i digit = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+    const __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+    const __m128i alpha = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    const __m128i is_alpha = _mm_cmpeq_epi8(_mm_min_epu8(alpha, _mm_set1_epi8(5)), alpha);
+    invalid = _mm_or_si128(invalid, _mm_andnot_si128(_mm_or_si128(is_digit, is_alpha), _mm_set1_epi8(-1)));
+
+    const __m128i nibbles = _mm_or_si128(
+        _mm_and_si128(digit, is_digit),
+        _mm_and_si128(_mm_add_epi8(alpha, _mm_set1_epi8(10)), is_alpha));
+    // 小端序：偶数位置（高半字节）位于 16 位的低字节
+    const __m128i high = _mm_and_si128(nibbles, _mm_set1_epi16(0x00FF));
+    const __m128i low = _mm_srli_epi16(nibbles, 8);
+    return _mm_or_si128(_mm_slli_epi16(high, 4), low);
+}
+
+// 每次处理 32 字符 -> 16 字节，返回已处理的字节数；遇到非法字符返回 SIZE_MAX
+size_t decodeSse2(const unsigned char* src, size_t len, char* dst) noexcept {
+    size_t i = 0;
+    __m128i invalid = _mm_setzero_si128();
+    for (; i + 16 <= len; i += 16) {
+        const __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2));
+        const __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2 + 16));
+        const __m128i bytes = _mm_packus_epi16(decodeBlockSse2(first, invalid),
+                                               decodeBlockSse2(second, invalid));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), bytes);
+    }
+    return _mm_movemask_epi8(invalid) != 0 ? SIZE_MAX : i;
+}
+
+// ==================== AVX2 ====================
+
+SEQUOIA_TARGET_AVX2
+inline __m256i nibbleToAsciiAvx2(__m256i nibbles, __m256i alpha_offset) noexcept {
+    const __m256i gt9 = _mm256_cmpgt_epi8(nibbles, _mm256_set1_epi8(9));
+    const __m256i ascii = _mm256_add_epi8(nibbles, _mm256_set1_epi8('0'));
+    return _mm256_add_epi8(ascii, _mm256_and_si256(gt9, alpha_offset));
+}
+
+// 每次处理 32 字节 -> 64 字符，返回已处理的字节数
+SEQUOIA_TARGET_AVX2
+size_t encodeAvx2(const unsigned char* src, size_t len, char* dst, HexCase hex_case) noexcept {
+    const __m256i mask = _mm256_set1_epi8(0x0F);
+    const __m256i alpha_offset = _mm256_set1_epi8(alphaOffset(hex_case));
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        const __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        const __m256i high = nibbleToAsciiAvx2(_mm256_and_si256(_mm256_srli_epi16(in, 4), mask), alpha_offset);
+        const __m256i low = nibbleToAsciiAvx2(_mm256_and_si256(in, mask), alpha_offset);
+        // unpack 在 128 位通道内进行，需要重新排列通道
+        const __m256i lo_pairs = _mm256_unpacklo_epi8(high, low);
+        const __m256i hi_pairs = _mm256_unpackhi_epi8(high, low);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 2),
+                            _mm256_permute2x128_si256(lo_pairs, hi_pairs, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 2 + 32),
+                            _mm256_permute2x128_si256(lo_pairs, hi_pairs, 0x31));
+    }
+    return i;
+}
+
+SEQUOIA_TARGET_AVX2
+inline __m256i decodeBlockAvx2(__m256i chars, __m256i& invalid) noexcept {
+    const __m256i digit = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+    const __m256i is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+    const __m256i alpha = _mm256_sub_epi8(_mm256_or_si256(chars, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    const __m256i is_alpha = _mm256_cmpeq_epi8(_mm256_min_epu8(alpha, _mm256_set1_epi8(5)), alpha);
+    invalid = _mm256_or_si256(invalid, _mm256_andnot_si256(_mm256_or_si256(is_digit, is_alpha),
+                                                           _mm256_set1_epi8(-1)));
+
+    const __m256i nibbles = _mm256_or_si256(
+        _mm256_and_si256(digit, is_digit),
+        _mm256_and_si256(_mm256_add_epi8(alpha, _mm256_set1_epi8(10)), is_alpha));
+    const __m256i high = _mm256_and_si256(nibbles, _mm256_set1_epi16(0x00FF));
+    const __m256i low = _mm256_srli_epi16(nibbles, 8);
+    return _mm256_or_si256(_mm256_slli_epi16(high, 4), low);
+}
+
+// 每次处理 64 字符 -> 32 字节，返回已处理的字节数；遇到非法字符返回 SIZE_MAX
+SEQUOIA_TARGET_AVX2
+size_t decodeAvx2(const unsigned char* src, size_t len, char* dst) noexcept {
+    size_t i = 0;
+    __m256i invalid = _mm256_setzero_si256();
+    for (; i + 32 <= len; i += 32) {
+        const __m256i first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 2));
+        const __m256i second = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 2 + 32));
+        // packus 在 128 位通道内交错，0xD8 恢复为顺序排列
+        const __m256i packed = _mm256_packus_epi16(decodeBlockAvx2(first, invalid),
+                                                   decodeBlockAvx2(second, invalid));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                            _mm256_permute4x64_epi64(packed, 0xD8));
+    }
+    return _mm256_movemask_epi8(invalid) != 0 ? SIZE_MAX : i;
+}
+
+#endif // SEQUOIA_SIMD_X86
+
+void encode(const unsigned char* src, size_t len, char* dst, HexCase hex_case) noexcept {
+    size_t done = 0;
+#if SEQUOIA_SIMD_X86
+    const simd::SimdLevel level = simd::activeLevel();
+    if (level >= simd::SimdLevel::AVX2) {
+        done = encodeAvx2(src, len, dst, hex_case);
+    }
+    if (level >= simd::SimdLevel::SSE2) {
+        done += encodeSse2(src + done, len - done, dst + done * 2, hex_case);
+    }
+#endif
+    encodeScalar(src + done, len - done, dst + done * 2, hex_case);
+}
+
+bool decode(const unsigned char* src, size_t len, char* dst) noexcept {
+    size_t done = 0;
+#if SEQUOIA_SIMD_X86
+    const simd::SimdLevel level = simd::activeLevel();
+    if (level >= simd::SimdLevel::AVX2) {
+        done = decodeAvx2(src, len, dst);
+        if (done == SIZE_MAX) {
+            return false;
+        }
+    }
+    if (level >= simd::SimdLevel::SSE2) {
+        const size_t sse_done = decodeSse2(src + done * 2, len - done, dst + done);
+        if (sse_done == SIZE_MAX) {
+            return false;
+        }
+        done += sse_done;
+    }
+#endif
+    return decodeScalar(src + done * 2, len - done, dst + done);
+}
+
+} // namespace
+
+size_t byteToHex(std::string_view bytes, std::span<char> out, HexCase hex_case) noexcept {
+    if (out.size() < bytes.size() * 2) {
+        return 0;
+    }
+    encode(reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size(), out.data(), hex_case);
+    return bytes.size() * 2;
+}
+
+std::string byteToHex(const char* bytes, size_t len, HexCase hex_case) {
+    if (bytes == nullptr) {
+        return {};
+    }
+
+    std::string result(len * 2, '\0');
+    encode(reinterpret_cast<const unsigned char*>(bytes), len, result.data(), hex_case);
+    return result;
+}
+
+size_t byteToHexWithPrefix(std::string_view bytes, std::span<char> out, HexCase hex_case) noexcept {
+    constexpr size_t kCharsPerByte = 5;
+    if (out.size() < bytes.size() * kCharsPerByte) {
+        return 0;
+    }
+
+    const HexTable& table = hexTable(hex_case);
+    char* dst = out.data();
+    for (const char byte : bytes) {
+        const auto& digits = table[static_cast<unsigned char>(byte)];
+        const char item[kCharsPerByte] = {'0', 'x', digits[0], digits[1], ' '};
+        std::memcpy(dst, item, kCharsPerByte);
+        dst += kCharsPerByte;
+    }
+    return bytes.size() * kCharsPerByte;
+}
+
+std::string byteToHexWithPrefix(const char* bytes, size_t len, HexCase hex_case) {
+    if (bytes == nullptr) {
+        return {};
+    }
+
+    std::string result(len * 5, '\0');
+    (void)byteToHexWithPrefix(std::string_view(bytes, len), result, hex_case);
+    return result;
+}
+
+std::optional<size_t> hexToByte(std::string_view hex, std::span<char> out) noexcept {
+    const size_t len = hex.size() / 2;
+    if (hex.size() % 2 != 0 || out.size() < len) {
+        return std::nullopt;
+    }
+    if (!decode(reinterpret_cast<const unsigned char*>(hex.data()), len, out.data())) {
+        return std::nullopt;
+    }
+    return len;
+}
+
+std::optional<std::string> hexToByte(std::string_view hex) {
+    if (hex.size() % 2 != 0) {
+        return std::nullopt;
+    }
+
+    std::string result(hex.size() / 2, '\0');
+    if (!hexToByte(hex, result)) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+} // namespace sequoia::utils
@@ -0,0 +1,257 @@
+#include "../null.h"
+#include "cpu.h"
+
+#include <array>
+#include <bit>
+
+#if SEQUOIA_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace sequoia::utils {
+
+namespace {
+
+template <typename T>
+std::optional<size_t> findFirstNullScalar(const T* values, size_t begin, size_t size) noexcept {
+    for (size_t i = begin; i < size; ++i) {
+        if (is_null(values[i])) {
+            return i;
+        }
+    }
+    return std::nullopt;
+}
+
+template <typename T>
+size_t countNullScalar(const T* values, size_t size) noexcept {
+    size_t count = 0;
+    for (size_t i = 0; i < size; ++i) {
+        count += is_null(values[i]) ? 1 : 0;
+    }
+    return count;
+}
+
+template <typename T>
+size_t compactScalar(const T* values, size_t size, T* out) noexcept {
+    size_t written = 0;
+    for (size_t i = 0; i < size; ++i) {
+        if (!is_null(values[i])) {
+            out[written++] = values[i];
+        }
+    }
+    return written;
+}
+
+template <typename T>
+size_t replaceNullScalar(T* values, size_t size, T fill) noexcept {
+    size_t replaced = 0;
+    for (size_t i = 0; i < size; ++i) {
+        if (is_null(values[i])) {
+            values[i] = fill;
+            ++replaced;
+        }
+    }
+    return replaced;
+}
+
+#if SEQUOIA_SIMD_X86
+
+// 紧凑化查找表：有效通道位 -> _mm256_permutevar8x32_epi32 下标，把有效通道依次移到低位
+template <size_t Lanes>
+constexpr auto makeCompactTable() noexcept {
+    constexpr size_t kParts = 8 / Lanes;  // 每个通道占几个 32 位分量
+    std::array<std::array<int32_t, 8>, (size_t{1} << Lanes)> table{};
+    for (size_t mask = 0; mask < table.size(); ++mask) {
+        size_t k = 0;
+        for (size_t lane = 0; lane < Lanes; ++lane) {
+            if ((mask >> lane) & 1) {
+                for (size_t part = 0; part < kParts; ++part) {
+                    table[mask][k * kParts + part] = static_cast<int32_t>(lane * kParts + part);
+                }
+                ++k;
+            }
+        }
+    }
+    return table;
+}
+
+constexpr auto kCompactTable4 = makeCompactTable<4>();
+constexpr auto kCompactTable8 = makeCompactTable<8>();
+
+// null 通道为全 1 的掩码
+template <typename T>
+SEQUOIA_TARGET_AVX2
+__m256i nullMaskAvx2(__m256i v) noexcept {
+    if constexpr (std::is_same_v<T, double>) {
+        const __m256d d = _mm256_castsi256_pd(v);
+        return _mm256_castpd_si256(_mm256_cmp_pd(d, d, _CMP_UNORD_Q));
+    } else if constexpr (std::is_same_v<T, float>) {
+        const __m256 f = _mm256_castsi256_ps(v);
+        return _mm256_castps_si256(_mm256_cmp_ps(f, f, _CMP_UNORD_Q));
+    } else if constexpr (sizeof(T) == 8) {
+        return _mm256_cmpeq_epi64(v, _mm256_set1_epi64x(static_cast<int64_t>(std::numeric_limits<T>::max())));
+    } else {
+        return _mm256_cmpeq_epi32(v, _mm256_set1_epi32(static_cast<int32_t>(std::numeric_limits<T>::max())));
+    }
+}
+
+// 每个通道取一位
+template <typename T>
+SEQUOIA_TARGET_AVX2
+uint32_t laneBitsAvx2(__m256i mask) noexcept {
+    if constexpr (sizeof(T) == 8) {
+        return static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(mask)));
+    } else {
+        return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(mask)));
+    }
+}
+
+template <typename T>
+SEQUOIA_TARGET_AVX2
+__m256i loadAvx2(const T* p) noexcept {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+
+template <typename T>
+SEQUOIA_TARGET_AVX2
+std::optional<size_t> findFirstNullAvx2(const T* values, size_t size) noexcept {
+    constexpr size_t kLanes = 32 / sizeof(T);
+    size_t i = 0;
+    // 每次检查 4 个向量，合并后只做一次分支
+    for (; i + 4 * kLanes <= size; i += 4 * kLanes) {
+        const __m256i m0 = nullMaskAvx2<T>(loadAvx2(values + i));
+        const __m256i m1 = nullMaskAvx2<T>(loadAvx2(values + i + kLanes));
+        const __m256i m2 = nullMaskAvx2<T>(loadAvx2(values + i + 2 * kLanes));
+        const __m256i m3 = nullMaskAvx2<T>(loadAvx2(values + i + 3 * kLanes));
+        const __m256i any = _mm256_or_si256(_mm256_or_si256(m0, m1), _mm256_or_si256(m2, m3));
+        if (!_mm256_testz_si256(any, any)) {
+            break;
+        }
+    }
+    for (; i + kLanes <= size; i += kLanes) {
+        const uint32_t bits = laneBitsAvx2<T>(nullMaskAvx2<T>(loadAvx2(values + i)));
+        if (bits != 0) {
+            return i + static_cast<size_t>(std::countr_zero(bits));
+        }
+    }
+    return findFirstNullScalar(values, i, size);
+}
+
+template <typename T>
+SEQUOIA_TARGET_AVX2
+size_t countNullAvx2(const T* values, size_t size) noexcept {
+    constexpr size_t kLanes = 32 / sizeof(T);
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + kLanes <= size; i += kLanes) {
+        count += static_cast<size_t>(std::popcount(laneBitsAvx2<T>(nullMaskAvx2<T>(loadAvx2(values + i)))));
+    }
+    return count + countNullScalar(values + i, size - i);
+}
+
+template <typename T>
+SEQUOIA_TARGET_AVX2
+size_t compactAvx2(const T* values, size_t size, T* out) noexcept {
+    constexpr size_t kLanes = 32 / sizeof(T);
+    constexpr uint32_t kAllLanes = (1u << kLanes) - 1;
+    size_t written = 0;
+    size_t i = 0;
+    for (; i + kLanes <= size; i += kLanes) {
+        const __m256i v = loadAvx2(values + i);
+        const uint32_t valid = ~laneBitsAvx2<T>(nullMaskAvx2<T>(v)) & kAllLanes;
+        const auto& indices = kLanes == 4 ? kCompactTable4[valid] : kCompactTable8[valid];
+        const __m256i permute = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices.data()));
+        // 整块写入：written <= i，写入范围不超过已读取的输入，原地紧凑化也安全
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + written), _mm256_permutevar8x32_epi32(v, permute));
+        written += static_cast<size_t>(std::popcount(valid));
+    }
+    return written + compactScalar(values + i, size - i, out + written);
+}
+
+template <typename T>
+SEQUOIA_TARGET_AVX2
+size_t replaceNullAvx2(T* values, size_t size, T fill) noexcept {
+    constexpr size_t kLanes = 32 / sizeof(T);
+    __m256i fill_vec;
+    if constexpr (sizeof(T) == 8) {
+        fill_vec = _mm256_set1_epi64x(std::bit_cast<int64_t>(fill));
+    } else {
+        fill_vec = _mm256_set1_epi32(std::bit_cast<int32_t>(fill));
+    }
+    size_t replaced = 0;
+    size_t i = 0;
+    for (; i + kLanes <= size; i += kLanes) {
+        const __m256i v = loadAvx2(values + i);
+        const __m256i mask = nullMaskAvx2<T>(v);
+        const uint32_t bits = laneBitsAvx2<T>(mask);
+        if (bits != 0) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(values + i), _mm256_blendv_epi8(v, fill_vec, mask));
+            replaced += static_cast<size_t>(std::popcount(bits));
+        }
+    }
+    return replaced + replaceNullScalar(values + i, size - i, fill);
+}
+
+#endif // SEQUOIA_SIMD_X86
+
+} // namespace
+
+template<SentinelValue T>
+std::optional<size_t> find_first_null(std::span<const T> values) noexcept {
+#if SEQUOIA_SIMD_X86
+    if (simd::activeLevel() >= simd::SimdLevel::AVX2) {
+        return findFirstNullAvx2(values.data(), values.size());
+    }
+#endif
+    return findFirstNullScalar(values.data(), 0, values.size());
+}
+
+template<SentinelValue T>
+size_t count_null(std::span<const T> values) noexcept {
+#if SEQUOIA_SIMD_X86
+    if (simd::activeLevel() >= simd::SimdLevel::AVX2) {
+        return countNullAvx2(values.data(), values.size());
+    }
+#endif
+    return countNullScalar(values.data(), values.size());
+}
+
+template<SentinelValue T>
+size_t compact_non_null(std::span<const T> values, std::span<T> out) noexcept {
+    if (out.size() < values.size()) {
+        return 0;
+    }
+#if SEQUOIA_SIMD_X86
+    if (simd::activeLevel() >= simd::SimdLevel::AVX2) {
+        return compactAvx2(values.data(), values.size(), out.data());
+    }
+#endif
+    return compactScalar(values.data(), values.size(), out.data());
+}
+
+template<SentinelValue T>
+size_t replace_null(std::span<T> values, T fill) noexcept {
+#if SEQUOIA_SIMD_X86
+    if (simd::activeLevel() >= simd::SimdLevel::AVX2) {
+        return replaceNullAvx2(values.data(), values.size(), fill);
+    }
+#endif
+    return replaceNullScalar(values.data(), values.size(), fill);
+}
+
+#define SEQUOIA_INSTANTIATE_SENTINEL_KERNELS(T)                                          \
+    template std::optional<size_t> find_first_null<T>(std::span<const T>) noexcept;      \
+    template size_t count_null<T>(std::span<const T>) noexcept;                          \
+    template size_t compact_non_null<T>(std::span<const T>, std::span<T>) noexcept;      \
+    template size_t replace_null<T>(std::span<T>, T) noexcept;
+
+SEQUOIA_INSTANTIATE_SENTINEL_KERNELS(int32_t)
+SEQUOIA_INSTANTIATE_SENTINEL_KERNELS(int64_t)
+SEQUOIA_INSTANTIATE_SENTINEL_KERNELS(uint32_t)
+SEQUOIA_INSTANTIATE_SENTINEL_KERNELS(uint64_t)
+SEQUOIA_INSTANTIATE_SENTINEL_KERNELS(float)
+SEQUOIA_INSTANTIATE_SENTINEL_KERNELS(double)
+
+#undef SEQUOIA_INSTANTIATE_SENTINEL_KERNELS
+
+} // namespace sequoia::utils
@@ -0,0 +1,555 @@
+#include "../nullable_column.h"
+#include "cpu.h"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+
+#if SEQUOIA_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace sequoia::utils::detail {
+
+namespace {
+
+// 标量实现：每次处理位图中的一个字（至多 64 个元素），bits 的第 k 位对应 values[k]
+
+template <typename T>
+uint64_t sentinelWord(const T* values, size_t count, T* out) noexcept {
+    uint64_t bits = 0;
+    for (size_t k = 0; k < count; ++k) {
+        const bool valid = !is_null(values[k]);
+        out[k] = valid ? values[k] : T{};
+        bits |= static_cast<uint64_t>(valid) << k;
+    }
+    return bits;
+}
+
+template <typename T>
+void fillNullWord(const T* values, uint64_t bits, size_t count, T fill, T* out) noexcept {
+    for (size_t k = 0; k < count; ++k) {
+        out[k] = ((bits >> k) & 1) ? values[k] : fill;
+    }
+}
+
+template <typename T>
+NullableSumType<T> sumWord(const T* values, uint64_t bits) noexcept {
+    NullableSumType<T> sum = 0;
+    for (; bits != 0; bits &= bits - 1) {
+        sum += values[std::countr_zero(bits)];
+    }
+    return sum;
+}
+
+template <typename T>
+T minWord(const T* values, uint64_t bits, T current) noexcept {
+    for (; bits != 0; bits &= bits - 1) {
+        current = std::min(current, values[std::countr_zero(bits)]);
+    }
+    return current;
+}
+
+template <typename T>
+T maxWord(const T* values, uint64_t bits, T current) noexcept {
+    for (; bits != 0; bits &= bits - 1) {
+        current = std::max(current, values[std::countr_zero(bits)]);
+    }
+    return current;
+}
+
+// min / max 的单位元：掩码掉的通道填入该值，不影响结果
+template <typename T>
+constexpr T minIdentity() noexcept {
+    if constexpr (std::is_floating_point_v<T>) {
+        return std::numeric_limits<T>::infinity();
+    } else {
+        return std::numeric_limits<T>::max();
+    }
+}
+
+template <typename T>
+constexpr T maxIdentity() noexcept {
+    if constexpr (std::is_floating_point_v<T>) {
+        return -std::numeric_limits<T>::infinity();
+    } else {
+        return std::numeric_limits<T>::lowest();
+    }
+}
+
+template <typename T>
+size_t sentinelToBitmapScalar(const T* values, size_t size, T* out, uint64_t* bitmap) noexcept {
+    size_t valid = 0;
+    for (size_t base = 0; base < size; base += 64) {
+        const uint64_t bits = sentinelWord(values + base, std::min<size_t>(64, size - base), out + base);
+        bitmap[base / 64] = bits;
+        valid += static_cast<size_t>(std::popcount(bits));
+    }
+    return valid;
+}
+
+template <typename T>
+void fillNullScalar(const T* values, const uint64_t* bitmap, size_t size, T fill, T* out) noexcept {
+    for (size_t base = 0; base < size; base += 64) {
+        fillNullWord(values + base, bitmap[base / 64], std::min<size_t>(64, size - base), fill, out + base);
+    }
+}
+
+template <typename T>
+NullableSumType<T> sumScalar(const T* values, const uint64_t* bitmap, size_t size) noexcept {
+    NullableSumType<T> sum = 0;
+    for (size_t base = 0; base < size; base += 64) {
+        sum += sumWord(values + base, bitmap[base / 64]);
+    }
+    return sum;
+}
+
+template <typename T>
+T minScalar(const T* values, const uint64_t* bitmap, size_t size) noexcept {
+    T result = minIdentity<T>();
+    for (size_t base = 0; base < size; base += 64) {
+        result = minWord(values + base, bitmap[base / 64], result);
+    }
+    return result;
+}
+
+template <typename T>
+T maxScalar(const T* values, const uint64_t* bitmap, size_t size) noexcept {
+    T result = maxIdentity<T>();
+    for (size_t base = 0; base < size; base += 64) {
+        result = maxWord(values + base, bitmap[base / 64], result);
+    }
+    return result;
+}
+
+#if SEQUOIA_SIMD_X86
+
+// 各指令集的向量操作，掩码由位图中连续的 kLanes 位展开得到
+
+template <typename T>
+struct Avx2Ops;
+
+template <>
+struct Avx2Ops<double> {
+    using Vec = __m256d;
+    using Mask = __m256d;
+    static constexpr size_t kLanes = 4;
+
+    SEQUOIA_TARGET_AVX2 static Vec load(const double* p) noexcept { return _mm256_loadu_pd(p); }
+    SEQUOIA_TARGET_AVX2 static void store(double* p, Vec v) noexcept { _mm256_storeu_pd(p, v); }
+    SEQUOIA_TARGET_AVX2 static Vec broadcast(double x) noexcept { return _mm256_set1_pd(x); }
+    SEQUOIA_TARGET_AVX2 static Vec add(Vec a, Vec b) noexcept { return _mm256_add_pd(a, b); }
+    SEQUOIA_TARGET_AVX2 static Vec min(Vec a, Vec b) noexcept { return _mm256_min_pd(a, b); }
+    SEQUOIA_TARGET_AVX2 static Vec max(Vec a, Vec b) noexcept { return _mm256_max_pd(a, b); }
+
+    // 低 4 位展开为 4 个 64 位通道的全 1 / 全 0 掩码
+    SEQUOIA_TARGET_AVX2 static Mask mask(uint64_t bits) noexcept {
+        const __m256i select = _mm256_setr_epi64x(1, 2, 4, 8);
+        const __m256i lanes = _mm256_and_si256(_mm256_set1_epi64x(static_cast<int64_t>(bits)), select);
+        return _mm256_castsi256_pd(_mm256_cmpeq_epi64(lanes, select));
+    }
+
+    SEQUOIA_TARGET_AVX2 static Vec select(Mask m, Vec v, Vec other) noexcept {
+        return _mm256_blendv_pd(other, v, m);
+    }
+
+    // NaN 与自身比较为无序
+    SEQUOIA_TARGET_AVX2 static Mask valid(Vec v) noexcept { return _mm256_cmp_pd(v, v, _CMP_ORD_Q); }
+    SEQUOIA_TARGET_AVX2 static uint64_t bits(Mask m) noexcept {
+        return static_cast<uint64_t>(_mm256_movemask_pd(m));
+    }
+};
+
+template <>
+struct Avx2Ops<int64_t> {
+    using Vec = __m256i;
+    using Mask = __m256i;
+    static constexpr size_t kLanes = 4;
+
+    SEQUOIA_TARGET_AVX2 static Vec load(const int64_t* p) noexcept {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    }
+    SEQUOIA_TARGET_AVX2 static void store(int64_t* p, Vec v) noexcept {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+    }
+    SEQUOIA_TARGET_AVX2 static Vec broadcast(int64_t x) noexcept { return _mm256_set1_epi64x(x); }
+    SEQUOIA_TARGET_AVX2 static Vec add(Vec a, Vec b) noexcept { return _mm256_add_epi64(a, b); }
+    // AVX2 没有 64 位整数 min/max，用比较加混合实现
+    SEQUOIA_TARGET_AVX2 static Vec min(Vec a, Vec b) noexcept {
+        return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b));
+    }
+    SEQUOIA_TARGET_AVX2 static Vec max(Vec a, Vec b) noexcept {
+        return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(b, a));
+    }
+
+    SEQUOIA_TARGET_AVX2 static Mask mask(uint64_t bits) noexcept {
+        const __m256i select = _mm256_setr_epi64x(1, 2, 4, 8);
+        const __m256i lanes = _mm256_and_si256(_mm256_set1_epi64x(static_cast<int64_t>(bits)), select);
+        return _mm256_cmpeq_epi64(lanes, select);
+    }
+
+    SEQUOIA_TARGET_AVX2 static Vec select(Mask m, Vec v, Vec other) noexcept {
+        return _mm256_blendv_epi8(other, v, m);
+    }
+
+    SEQUOIA_TARGET_AVX2 static Mask valid(Vec v) noexcept {
+        const __m256i sentinel = _mm256_set1_epi64x(std::numeric_limits<int64_t>::max());
+        return _mm256_xor_si256(_mm256_cmpeq_epi64(v, sentinel), _mm256_set1_epi64x(-1));
+    }
+    SEQUOIA_TARGET_AVX2 static uint64_t bits(Mask m) noexcept {
+        return static_cast<uint64_t>(_mm256_movemask_pd(_mm256_castsi256_pd(m)));
+    }
+};
+
+template <typename T>
+struct Avx512Ops;
+
+template <>
+struct Avx512Ops<double> {
+    using Vec = __m512d;
+    using Mask = __mmask8;
+    static constexpr size_t kLanes = 8;
+
+    SEQUOIA_TARGET_AVX512 static Vec load(const double* p) noexcept { return _mm512_loadu_pd(p); }
+    SEQUOIA_TARGET_AVX512 static void store(double* p, Vec v) noexcept { _mm512_storeu_pd(p, v); }
+    SEQUOIA_TARGET_AVX512 static Vec broadcast(double x) noexcept { return _mm512_set1_pd(x); }
+    SEQUOIA_TARGET_AVX512 static Vec add(Vec a, Vec b) noexcept { return _mm512_add_pd(a, b); }
+    SEQUOIA_TARGET_AVX512 static Vec min(Vec a, Vec b) noexcept { return _mm512_min_pd(a, b); }
+    SEQUOIA_TARGET_AVX512 static Vec max(Vec a, Vec b) noexcept { return _mm512_max_pd(a, b); }
+    // 位图的一个字节即 8 个通道的掩码寄存器
+    SEQUOIA_TARGET_AVX512 static Mask mask(uint64_t bits) noexcept { return static_cast<Mask>(bits); }
+    SEQUOIA_TARGET_AVX512 static Vec select(Mask m, Vec v, Vec other) noexcept {
+        return _mm512_mask_blend_pd(m, other, v);
+    }
+    SEQUOIA_TARGET_AVX512 static Mask valid(Vec v) noexcept { return _mm512_cmp_pd_mask(v, v, _CMP_ORD_Q); }
+    SEQUOIA_TARGET_AVX512 static uint64_t bits(Mask m) noexcept { return m; }
+};
+
+template <>
+struct Avx512Ops<int64_t> {
+    using Vec = __m512i;
+    using Mask = __mmask8;
+    static constexpr size_t kLanes = 8;
+
+    SEQUOIA_TARGET_AVX512 static Vec load(const int64_t* p) noexcept { return _mm512_loadu_si512(p); }
+    SEQUOIA_TARGET_AVX512 static void store(int64_t* p, Vec v) noexcept { _mm512_storeu_si512(p, v); }
+    SEQUOIA_TARGET_AVX512 static Vec broadcast(int64_t x) noexcept { return _mm512_set1_epi64(x); }
+    SEQUOIA_TARGET_AVX512 static Vec add(Vec a, Vec b) noexcept { return _mm512_add_epi64(a, b); }
+    SEQUOIA_TARGET_AVX512 static Vec min(Vec a, Vec b) noexcept { return _mm512_min_epi64(a, b); }
+    SEQUOIA_TARGET_AVX512 static Vec max(Vec a, Vec b) noexcept { return _mm512_max_epi64(a, b); }
+    SEQUOIA_TARGET_AVX512 static Mask mask(uint64_t bits) noexcept { return static_cast<Mask>(bits); }
+    SEQUOIA_TARGET_AVX512 static Vec select(Mask m, Vec v, Vec other) noexcept {
+        return _mm512_mask_blend_epi64(m, other, v);
+    }
+    SEQUOIA_TARGET_AVX512 static Mask valid(Vec v) noexcept {
+        return _mm512_cmpneq_epi64_mask(v, _mm512_set1_epi64(std::numeric_limits<int64_t>::max()));
+    }
+    SEQUOIA_TARGET_AVX512 static uint64_t bits(Mask m) noexcept { return m; }
+};
+
+// 以下 AVX2 / AVX-512 内核逐字处理位图，字内不足 kLanes 的尾部交给标量实现
+
+template <typename T, typename Ops, typename Vec>
+SEQUOIA_TARGET_AVX2
+T reduceAvx2(Vec acc, T init, T (*combine)(T, T)) noexcept {
+    alignas(32) T lanes[Ops::kLanes];
+    Ops::store(lanes, acc);
+    for (const T lane : lanes) {
+        init = combine(init, lane);
+    }
+    return init;
+}
+
+template <typename T>
+SEQUOIA_TARGET_AVX2
+size_t sentinelToBitmapAvx2(const T* values, size_t size, T* out, uint64_t* bitmap) noexcept {
+    using Ops = Avx2Ops<T>;
+    const auto zero = Ops::broadcast(T{});
+    size_t valid = 0;
+    for (size_t base = 0; base < size; base += 64) {
+        const size_t count = std::min<size_t>(64, size - base);
+        uint64_t bits = 0;
+        size_t j = 0;
+        for (; j + Ops::kLanes <= count; j += Ops::kLanes) {
+            const auto v = Ops::load(values + base + j);
+            const auto m = Ops::valid(v);
+            Ops::store(out + base + j, Ops::select(m, v, zero));
+            bits |= Ops::bits(m) << j;
+        }
+        if (j < count) {
+            bits |= sentinelWord(values + base + j, count - j, out + base + j) << j;
+        }
+        bitmap[base / 64] = bits;
+        valid += static_cast<size_t>(std::popcount(bits));
+    }
+    return valid;
+}
+
+template <typename T>
+SEQUOIA_TARGET_AVX2
+void fillNullAvx2(const T* values, const uint64_t* bitmap, size_t size, T fill, T* out) noexcept {
+    using Ops = Avx2Ops<T>;
+    const auto fill_vec = Ops::broadcast(fill);
+    for (size_t base = 0; base < size; base += 64) {
+        const size_t count = std::min<size_t>(64, size - base);
+        const uint64_t word = bitmap[base / 64];
+        size_t j = 0;
+        for (; j + Ops::kLanes <= count; j += Ops::kLanes) {
+            Ops::store(out + base + j, Ops::select(Ops::mask(word >> j), Ops::load(values + base + j), fill_vec));
+        }
+        if (j < count) {
+            fillNullWord(values + base + j, word >> j, count - j, fill, out + base + j);
+        }
+    }
+}
+
+template <typename T>
+SEQUOIA_TARGET_AVX2
+T sumAvx2(const T* values, const uint64_t* bitmap, size_t size) noexcept {
+    using Ops = Avx2Ops<T>;
+    const auto zero = Ops::broadcast(T{});
+    auto acc = zero;
+    T tail = 0;
+    for (size_t base = 0; base < size; base += 64) {
+        const size_t count = std::min<size_t>(64, size - base);
+        const uint64_t word = bitmap[base / 64];
+        size_t j = 0;
+        for (; j + Ops::kLanes <= count; j += Ops::kLanes) {
+            acc = Ops::add(acc, Ops::select(Ops::mask(word >> j), Ops::load(values + base + j), zero));
+        }
+        if (j < count) {
+            tail += sumWord(values + base + j, word >> j);
+        }
+    }
+    return reduceAvx2<T, Ops>(acc, tail, +[](T a, T b) { return a + b; });
+}
+
+template <typename T, bool IsMin>
+SEQUOIA_TARGET_AVX2
+T minMaxAvx2(const T* values, const uint64_t* bitmap, size_t size) noexcept {
+    using Ops = Avx2Ops<T>;
+    const T identity = IsMin ? minIdentity<T>() : maxIdentity<T>();
+    const auto identity_vec = Ops::broadcast(identity);
+    auto acc = identity_vec;
+    T tail = identity;
+    for (size_t base = 0; base < size; base += 64) {
+        const size_t count = std::min<size_t>(64, size - base);
+        const uint64_t word = bitmap[base / 64];
+        size_t j = 0;
+        for (; j + Ops::kLanes <= count; j += Ops::kLanes) {
+            const auto v = Ops::select(Ops::mask(word >> j), Ops::load(values + base + j), identity_vec);
+            acc = IsMin ? Ops::min(acc, v) : Ops::max(acc, v);
+        }
+        if (j < count) {
+            tail = IsMin ? minWord(values + base + j, word >> j, tail) : maxWord(values + base + j, word >> j, tail);
+        }
+    }
+    if constexpr (IsMin) {
+        return reduceAvx2<T, Ops>(acc, tail, +[](T a, T b) { return std::min(a, b); });
+    } else {
+        return reduceAvx2<T, Ops>(acc, tail, +[](T a, T b) { return std::max(a, b); });
+    }
+}
+
+template <typename T>
+SEQUOIA_TARGET_AVX512
+size_t sentinelToBitmapAvx512(const T* values, size_t size, T* out, uint64_t* bitmap) noexcept {
+    using Ops = Avx512Ops<T>;
+    const auto zero = Ops::broadcast(T{});
+    size_t valid = 0;
+    for (size_t base = 0; base < size; base += 64) {
+        const size_t count = std::min<size_t>(64, size - base);
+        uint64_t bits = 0;
+        size_t j = 0;
+        for (; j + Ops::kLanes <= count; j += Ops::kLanes) {
+            const auto v = Ops::load(values + base + j);
+            const auto m = Ops::valid(v);
+            Ops::store(out + base + j, Ops::select(m, v, zero));
+            bits |= Ops::bits(m) << j;
+        }
+        if (j < count) {
+            bits |= sentinelWord(values + base + j, count - j, out + base + j) << j;
+        }
+        bitmap[base / 64] = bits;
+        valid += static_cast<size_t>(std::popcount(bits));
+    }
+    return valid;
+}
+
+template <typename T>
+SEQUOIA_TARGET_AVX512
+void fillNullAvx512(const T* values, const uint64_t* bitmap, size_t size, T fill, T* out) noexcept {
+    using Ops = Avx512Ops<T>;
+    const auto fill_vec = Ops::broadcast(fill);
+    for (size_t base = 0; base < size; base += 64) {
+        const size_t count = std::min<size_t>(64, size - base);
+        const uint64_t word = bitmap[base / 64];
+        size_t j = 0;
+        for (; j + Ops::kLanes <= count; j += Ops::kLanes) {
+            Ops::store(out + base + j, Ops::select(Ops::mask(word >> j), Ops::load(values + base + j), fill_vec));
+        }
+        if (j < count) {
+            fillNullWord(values + base + j, word >> j, count - j, fill, out + base + j);
+        }
+    }
+}
+
+template <typename T>
+SEQUOIA_TARGET_AVX512
+T sumAvx512(const T* values, const uint64_t* bitmap, size_t size) noexcept {
+    using Ops = Avx512Ops<T>;
+    const auto zero = Ops::broadcast(T{});
+    auto acc = zero;
+    T tail = 0;
+    for (size_t base = 0; base < size; base += 64) {
+        const size_t count = std::min<size_t>(64, size - base);
+        const uint64_t word = bitmap[base / 64];
+        size_t j = 0;
+        for (; j + Ops::kLanes <= count; j += Ops::kLanes) {
+            acc = Ops::add(acc, Ops::select(Ops::mask(word >> j), Ops::load(values + base + j), zero));
+        }
+        if (j < count) {
+            tail += sumWord(values + base + j, word >> j);
+        }
+    }
+    if constexpr (std::is_floating_point_v<T>) {
+        return _mm512_reduce_add_pd(acc) + tail;
+    } else {
+        return static_cast<T>(_mm512_reduce_add_epi64(acc)) + tail;
+    }
+}
+
+template <typename T, bool IsMin>
+SEQUOIA_TARGET_AVX512
+T minMaxAvx512(const T* values, const uint64_t* bitmap, size_t size) noexcept {
+    using Ops = Avx512Ops<T>;
+    const T identity = IsMin ? minIdentity<T>() : maxIdentity<T>();
+    const auto identity_vec = Ops::broadcast(identity);
+    auto acc = identity_vec;
+    T tail = identity;
+    for (size_t base = 0; base < size; base += 64) {
+        const size_t count = std::min<size_t>(64, size - base);
+        const uint64_t word = bitmap[base / 64];
+        size_t j = 0;
+        for (; j + Ops::kLanes <= count; j += Ops::kLanes) {
+            const auto v = Ops::select(Ops::mask(word >> j), Ops::load(values + base + j), identity_vec);
+            acc = IsMin ? Ops::min(acc, v) : Ops::max(acc, v);
+        }
+        if (j < count) {
+            tail = IsMin ? minWord(values + base + j, word >> j, tail) : maxWord(values + base + j, word >> j, tail);
+        }
+    }
+    if constexpr (std::is_floating_point_v<T>) {
+        return IsMin ? std::min(_mm512_reduce_min_pd(acc), tail) : std::max(_mm512_reduce_max_pd(acc), tail);
+    } else {
+        return IsMin ? std::min<T>(_mm512_reduce_min_epi64(acc), tail) : std::max<T>(_mm512_reduce_max_epi64(acc), tail);
+    }
+}
+
+#endif // SEQUOIA_SIMD_X86
+
+// double 与 int64_t 有向量实现，其余类型使用标量实现
+template <typename T>
+constexpr bool kHasSimdKernel = std::is_same_v<T, double> || std::is_same_v<T, int64_t>;
+
+} // namespace
+
+template <NullableValue T>
+size_t sentinel_to_bitmap(const T* values, size_t size, T* out, uint64_t* bitmap) noexcept {
+#if SEQUOIA_SIMD_X86
+    if constexpr (kHasSimdKernel<T>) {
+        const simd::SimdLevel level = simd::activeLevel();
+        if (level >= simd::SimdLevel::AVX512) {
+            return sentinelToBitmapAvx512(values, size, out, bitmap);
+        }
+        if (level >= simd::SimdLevel::AVX2) {
+            return sentinelToBitmapAvx2(values, size, out, bitmap);
+        }
+    }
+#endif
+    return sentinelToBitmapScalar(values, size, out, bitmap);
+}
+
+template <NullableValue T>
+void fill_null(const T* values, const uint64_t* bitmap, size_t size, T fill, T* out) noexcept {
+#if SEQUOIA_SIMD_X86
+    if constexpr (kHasSimdKernel<T>) {
+        const simd::SimdLevel level = simd::activeLevel();
+        if (level >= simd::SimdLevel::AVX512) {
+            fillNullAvx512(values, bitmap, size, fill, out);
+            return;
+        }
+        if (level >= simd::SimdLevel::AVX2) {
+            fillNullAvx2(values, bitmap, size, fill, out);
+            return;
+        }
+    }
+#endif
+    fillNullScalar(values, bitmap, size, fill, out);
+}
+
+template <NullableValue T>
+NullableSumType<T> sum_valid(const T* values, const uint64_t* bitmap, size_t size) noexcept {
+#if SEQUOIA_SIMD_X86
+    if constexpr (kHasSimdKernel<T>) {
+        const simd::SimdLevel level = simd::activeLevel();
+        if (level >= simd::SimdLevel::AVX512) {
+            return sumAvx512(values, bitmap, size);
+        }
+        if (level >= simd::SimdLevel::AVX2) {
+            return sumAvx2(values, bitmap, size);
+        }
+    }
+#endif
+    return sumScalar(values, bitmap, size);
+}
+
+template <NullableValue T>
+T min_valid(const T* values, const uint64_t* bitmap, size_t size) noexcept {
+#if SEQUOIA_SIMD_X86
+    if constexpr (kHasSimdKernel<T>) {
+        const simd::SimdLevel level = simd::activeLevel();
+        if (level >= simd::SimdLevel::AVX512) {
+            return minMaxAvx512<T, true>(values, bitmap, size);
+        }
+        if (level >= simd::SimdLevel::AVX2) {
+            return minMaxAvx2<T, true>(values, bitmap, size);
+        }
+    }
+#endif
+    return minScalar(values, bitmap, size);
+}
+
+template <NullableValue T>
+T max_valid(const T* values, const uint64_t* bitmap, size_t size) noexcept {
+#if SEQUOIA_SIMD_X86
+    if constexpr (kHasSimdKernel<T>) {
+        const simd::SimdLevel level = simd::activeLevel();
+        if (level >= simd::SimdLevel::AVX512) {
+            return minMaxAvx512<T, false>(values, bitmap, size);
+        }
+        if (level >= simd::SimdLevel::AVX2) {
+            return minMaxAvx2<T, false>(values, bitmap, size);
+        }
+    }
+#endif
+    return maxScalar(values, bitmap, size);
+}
+
+#define SEQUOIA_INSTANTIATE_NULLABLE_KERNELS(T)                                                   \
+    template size_t sentinel_to_bitmap<T>(const T*, size_t, T*, uint64_t*) noexcept;               \
+    template void fill_null<T>(const T*, const uint64_t*, size_t, T, T*) noexcept;                 \
+    template NullableSumType<T> sum_valid<T>(const T*, const uint64_t*, size_t) noexcept;          \
+    template T min_valid<T>(const T*, const uint64_t*, size_t) noexcept;                           \
+    template T max_valid<T>(const T*, const uint64_t*, size_t) noexcept;
+
+SEQUOIA_INSTANTIATE_NULLABLE_KERNELS(int32_t)
+SEQUOIA_INSTANTIATE_NULLABLE_KERNELS(int64_t)
+SEQUOIA_INSTANTIATE_NULLABLE_KERNELS(uint32_t)
+SEQUOIA_INSTANTIATE_NULLABLE_KERNELS(uint64_t)
+SEQUOIA_INSTANTIATE_NULLABLE_KERNELS(float)
+SEQUOIA_INSTANTIATE_NULLABLE_KERNELS(double)
+
+#undef SEQUOIA_INSTANTIATE_NULLABLE_KERNELS
+
+} // namespace sequoia::utils::detail
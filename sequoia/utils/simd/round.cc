@@ -0,0 +1,221 @@
+#include "../arithmetic.h"
+#include "cpu.h"
+
+#include <limits>
+
+#if SEQUOIA_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace sequoia::utils {
+
+namespace {
+
+enum class RoundMode {
+    HalfEven,  // roundEx
+    Ceil,      // ceilEx
+    Floor,     // floorEx
+};
+
+template <RoundMode Mode, std::floating_point ValueType>
+ValueType roundScaled(ValueType scaled_value) noexcept {
+    if constexpr (Mode == RoundMode::HalfEven) {
+        return detail::round_half_even(scaled_value);
+    } else if constexpr (Mode == RoundMode::Ceil) {
+        return detail::ceil_away(scaled_value);
+    } else {
+        return detail::floor_toward_zero(scaled_value);
+    }
+}
+
+// 与 roundEx/ceilEx/floorEx 的逐个计算完全相同，只是 scale 在循环外计算
+template <RoundMode Mode, std::floating_point ValueType>
+void roundScalar(const ValueType* in, ValueType* out, size_t count, ValueType scale, bool multiply) noexcept {
+    for (size_t i = 0; i < count; ++i) {
+        if (multiply) {
+            out[i] = roundScaled<Mode>(in[i] * scale) / scale;
+        } else {
+            out[i] = roundScaled<Mode>(in[i] / scale) * scale;
+        }
+    }
+}
+
+#if SEQUOIA_SIMD_X86
+
+// 以下向量实现逐条对应标量版本的运算（IEEE 乘除、截断和比较均为精确定义），结果逐位一致：
+// std::round 的远离 0 舍入由截断加上 |小数部分| >= 0.5 时的 ±1 实现，保留 -0.0 的符号
+
+SEQUOIA_TARGET_AVX2
+__m256d roundAwayAvx2(__m256d x) noexcept {
+    const __m256d sign_mask = _mm256_set1_pd(-0.0);
+    const __m256d truncated = _mm256_round_pd(x, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    const __m256d fraction = _mm256_andnot_pd(sign_mask, _mm256_sub_pd(x, truncated));
+    const __m256d step = _mm256_or_pd(_mm256_and_pd(x, sign_mask), _mm256_set1_pd(1.0));
+    const __m256d carry = _mm256_cmp_pd(fraction, _mm256_set1_pd(0.5), _CMP_GE_OQ);
+    return _mm256_blendv_pd(truncated, _mm256_add_pd(truncated, step), carry);
+}
+
+template <RoundMode Mode>
+SEQUOIA_TARGET_AVX2
+__m256d roundScaledAvx2(__m256d scaled) noexcept {
+    if constexpr (Mode == RoundMode::HalfEven) {
+        const __m256d sign_mask = _mm256_set1_pd(-0.0);
+        const __m256d rounded = roundAwayAvx2(scaled);
+        const __m256d diff = _mm256_andnot_pd(sign_mask, _mm256_sub_pd(rounded, scaled));
+        const __m256d tie_distance = _mm256_andnot_pd(sign_mask, _mm256_sub_pd(diff, _mm256_set1_pd(0.5)));
+        const __m256d tie = _mm256_cmp_pd(
+            tie_distance, _mm256_set1_pd(std::numeric_limits<double>::epsilon()), _CMP_LT_OQ);
+        if (_mm256_movemask_pd(tie) == 0) {
+            return rounded;
+        }
+        const __m256d even = _mm256_mul_pd(
+            _mm256_set1_pd(2.0), roundAwayAvx2(_mm256_div_pd(scaled, _mm256_set1_pd(2.0))));
+        return _mm256_blendv_pd(rounded, even, tie);
+    } else if constexpr (Mode == RoundMode::Ceil) {
+        const __m256d non_negative = _mm256_cmp_pd(scaled, _mm256_setzero_pd(), _CMP_GE_OQ);
+        const __m256d up = _mm256_round_pd(_mm256_add_pd(scaled, _mm256_set1_pd(1.0)),
+                                           _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+        const __m256d down = _mm256_round_pd(_mm256_sub_pd(scaled, _mm256_set1_pd(1.0)),
+                                             _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC);
+        return _mm256_blendv_pd(down, up, non_negative);
+    } else {
+        // 正数 floor、负数 ceil 即向 0 截断（包括 -0.0 和 NaN）
+        return _mm256_round_pd(scaled, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    }
+}
+
+template <RoundMode Mode>
+SEQUOIA_TARGET_AVX2
+void roundAvx2(const double* in, double* out, size_t count, double scale, bool multiply) noexcept {
+    const __m256d scale_vec = _mm256_set1_pd(scale);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256d value = _mm256_loadu_pd(in + i);
+        __m256d result;
+        if (multiply) {
+            result = _mm256_div_pd(roundScaledAvx2<Mode>(_mm256_mul_pd(value, scale_vec)), scale_vec);
+        } else {
+            result = _mm256_mul_pd(roundScaledAvx2<Mode>(_mm256_div_pd(value, scale_vec)), scale_vec);
+        }
+        _mm256_storeu_pd(out + i, result);
+    }
+    roundScalar<Mode>(in + i, out + i, count - i, scale, multiply);
+}
+
+SEQUOIA_TARGET_AVX512
+__m512d roundAwayAvx512(__m512d x) noexcept {
+    const __m512i sign_mask = _mm512_set1_epi64(static_cast<int64_t>(0x8000000000000000ULL));
+    const __m512d truncated = _mm512_roundscale_pd(x, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    const __m512d fraction = _mm512_abs_pd(_mm512_sub_pd(x, truncated));
+    const __m512d step = _mm512_castsi512_pd(_mm512_or_si512(
+        _mm512_and_si512(_mm512_castpd_si512(x), sign_mask), _mm512_castpd_si512(_mm512_set1_pd(1.0))));
+    const __mmask8 carry = _mm512_cmp_pd_mask(fraction, _mm512_set1_pd(0.5), _CMP_GE_OQ);
+    return _mm512_mask_add_pd(truncated, carry, truncated, step);
+}
+
+template <RoundMode Mode>
+SEQUOIA_TARGET_AVX512
+__m512d roundScaledAvx512(__m512d scaled) noexcept {
+    if constexpr (Mode == RoundMode::HalfEven) {
+        const __m512d rounded = roundAwayAvx512(scaled);
+        const __m512d diff = _mm512_abs_pd(_mm512_sub_pd(rounded, scaled));
+        const __m512d tie_distance = _mm512_abs_pd(_mm512_sub_pd(diff, _mm512_set1_pd(0.5)));
+        const __mmask8 tie = _mm512_cmp_pd_mask(
+            tie_distance, _mm512_set1_pd(std::numeric_limits<double>::epsilon()), _CMP_LT_OQ);
+        if (tie == 0) {
+            return rounded;
+        }
+        const __m512d even = _mm512_mul_pd(
+            _mm512_set1_pd(2.0), roundAwayAvx512(_mm512_div_pd(scaled, _mm512_set1_pd(2.0))));
+        return _mm512_mask_blend_pd(tie, rounded, even);
+    } else if constexpr (Mode == RoundMode::Ceil) {
+        const __mmask8 non_negative = _mm512_cmp_pd_mask(scaled, _mm512_setzero_pd(), _CMP_GE_OQ);
+        const __m512d up = _mm512_roundscale_pd(_mm512_add_pd(scaled, _mm512_set1_pd(1.0)),
+                                                _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+        const __m512d down = _mm512_roundscale_pd(_mm512_sub_pd(scaled, _mm512_set1_pd(1.0)),
+                                                  _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC);
+        return _mm512_mask_blend_pd(non_negative, down, up);
+    } else {
+        return _mm512_roundscale_pd(scaled, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    }
+}
+
+template <RoundMode Mode>
+SEQUOIA_TARGET_AVX512
+void roundAvx512(const double* in, double* out, size_t count, double scale, bool multiply) noexcept {
+    const __m512d scale_vec = _mm512_set1_pd(scale);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m512d value = _mm512_loadu_pd(in + i);
+        __m512d result;
+        if (multiply) {
+            result = _mm512_div_pd(roundScaledAvx512<Mode>(_mm512_mul_pd(value, scale_vec)), scale_vec);
+        } else {
+            result = _mm512_mul_pd(roundScaledAvx512<Mode>(_mm512_div_pd(value, scale_vec)), scale_vec);
+        }
+        _mm512_storeu_pd(out + i, result);
+    }
+    roundScalar<Mode>(in + i, out + i, count - i, scale, multiply);
+}
+
+#endif // SEQUOIA_SIMD_X86
+
+template <RoundMode Mode>
+size_t roundBatch(std::span<const double> values, std::span<double> out, int32_t ndigits) noexcept {
+    if (out.size() < values.size()) {
+        return 0;
+    }
+    const double scale = detail::power_of_ten<double>(std::abs(ndigits));
+    const bool multiply = ndigits >= 0;
+#if SEQUOIA_SIMD_X86
+    const simd::SimdLevel level = simd::activeLevel();
+    if (level >= simd::SimdLevel::AVX512) {
+        roundAvx512<Mode>(values.data(), out.data(), values.size(), scale, multiply);
+        return values.size();
+    }
+    if (level >= simd::SimdLevel::AVX2) {
+        roundAvx2<Mode>(values.data(), out.data(), values.size(), scale, multiply);
+        return values.size();
+    }
+#endif
+    roundScalar<Mode>(values.data(), out.data(), values.size(), scale, multiply);
+    return values.size();
+}
+
+template <RoundMode Mode>
+size_t roundBatch(std::span<const float> values, std::span<float> out, int32_t ndigits) noexcept {
+    if (out.size() < values.size()) {
+        return 0;
+    }
+    roundScalar<Mode>(values.data(), out.data(), values.size(), detail::power_of_ten<float>(std::abs(ndigits)),
+                      ndigits >= 0);
+    return values.size();
+}
+
+} // namespace
+
+size_t roundEx(std::span<const double> values, std::span<double> out, int32_t ndigits) noexcept {
+    return roundBatch<RoundMode::HalfEven>(values, out, ndigits);
+}
+
+size_t roundEx(std::span<const float> values, std::span<float> out, int32_t ndigits) noexcept {
+    return roundBatch<RoundMode::HalfEven>(values, out, ndigits);
+}
+
+size_t ceilEx(std::span<const double> values, std::span<double> out, int32_t ndigits) noexcept {
+    return roundBatch<RoundMode::Ceil>(values, out, ndigits);
+}
+
+size_t ceilEx(std::span<const float> values, std::span<float> out, int32_t ndigits) noexcept {
+    return roundBatch<RoundMode::Ceil>(values, out, ndigits);
+}
+
+size_t floorEx(std::span<const double> values, std::span<double> out, int32_t ndigits) noexcept {
+    return roundBatch<RoundMode::Floor>(values, out, ndigits);
+}
+
+size_t floorEx(std::span<const float> values, std::span<float> out, int32_t ndigits) noexcept {
+    return roundBatch<RoundMode::Floor>(values, out, ndigits);
+}
+
+} // namespace sequoia::utils
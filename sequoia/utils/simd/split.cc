@@ -0,0 +1,97 @@
+#include "../split.h"
+#include "cpu.h"
+
+#include <bit>
+#include <cstring>
+
+#if SEQUOIA_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace sequoia::utils::detail {
+
+namespace {
+
+const char* findCharMemchr(const char* first, const char* last, char c) noexcept {
+    // 空区间可能是 [nullptr, nullptr)，memchr 要求指针非空
+    if (first == last) {
+        return last;
+    }
+    const void* found = std::memchr(first, c, static_cast<size_t>(last - first));
+    return found != nullptr ? static_cast<const char*>(found) : last;
+}
+
+const char* findAnyOfScalar(const char* first, const char* last, const DelimiterSet& delimiters) noexcept {
+    for (; first != last; ++first) {
+        if (delimiters.contains(*first)) {
+            return first;
+        }
+    }
+    return last;
+}
+
+#if SEQUOIA_SIMD_X86
+
+// 短字段居多，逐块比较 32 字节，命中后用 ctz 定位
+SEQUOIA_TARGET_AVX2
+const char* findCharAvx2(const char* first, const char* last, char c) noexcept {
+    const __m256i needle = _mm256_set1_epi8(c);
+    for (; last - first >= 32; first += 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+        const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)));
+        if (mask != 0) {
+            return first + std::countr_zero(mask);
+        }
+    }
+    return findCharMemchr(first, last, c);
+}
+
+SEQUOIA_TARGET_AVX2
+const char* findAnyOfAvx2(const char* first, const char* last, const DelimiterSet& delimiters,
+                          std::string_view chars) noexcept {
+    __m256i needles[DelimiterSet::kMaxSimdChars];
+    for (size_t i = 0; i < chars.size(); ++i) {
+        needles[i] = _mm256_set1_epi8(chars[i]);
+    }
+    for (; last - first >= 32; first += 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+        __m256i hits = _mm256_setzero_si256();
+        for (size_t i = 0; i < chars.size(); ++i) {
+            hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(block, needles[i]));
+        }
+        const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(hits));
+        if (mask != 0) {
+            return first + std::countr_zero(mask);
+        }
+    }
+    return findAnyOfScalar(first, last, delimiters);
+}
+
+#endif // SEQUOIA_SIMD_X86
+
+} // namespace
+
+const char* find_char(const char* first, const char* last, char c) noexcept {
+#if SEQUOIA_SIMD_X86
+    if (simd::activeLevel() >= simd::SimdLevel::AVX2) {
+        return findCharAvx2(first, last, c);
+    }
+#endif
+    // libc 的 memchr 本身已向量化
+    return findCharMemchr(first, last, c);
+}
+
+const char* find_any_of(const char* first, const char* last, const DelimiterSet& delimiters) noexcept {
+    const std::string_view chars = delimiters.simd_chars();
+    if (chars.size() == 1) {
+        return find_char(first, last, chars.front());
+    }
+#if SEQUOIA_SIMD_X86
+    if (!chars.empty() && simd::activeLevel() >= simd::SimdLevel::AVX2) {
+        return findAnyOfAvx2(first, last, delimiters, chars);
+    }
+#endif
+    return findAnyOfScalar(first, last, delimiters);
+}
+
+} // namespace sequoia::utils::detail
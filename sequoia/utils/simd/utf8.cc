@@ -0,0 +1,299 @@
+#include "../encoding.h"
+#include "cpu.h"
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+#if SEQUOIA_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace sequoia::utils {
+
+namespace {
+
+bool isContinuation(unsigned char byte) noexcept {
+    return (byte & 0xC0) == 0x80;
+}
+
+bool isPrintableAscii(unsigned char byte) noexcept {
+    return byte >= 0x20 && byte < 0x7F;
+}
+
+// 逐个序列解码，ASCII 连续段批量跳过
+std::optional<size_t> findInvalidScalar(std::string_view str, size_t pos) noexcept {
+    const auto* in = reinterpret_cast<const unsigned char*>(str.data());
+    while (pos < str.size()) {
+        if (in[pos] < 0x80) {
+            pos += detail::ascii_prefix(str.substr(pos));
+            continue;
+        }
+        uint32_t code_point = 0;
+        size_t length = 0;
+        if (detail::decode_utf8(in + pos, str.size() - pos, code_point, length) != detail::TranscodeStatus::Ok) {
+            return pos;
+        }
+        pos += length;
+    }
+    return std::nullopt;
+}
+
+size_t countCodePointsScalar(const unsigned char* in, size_t len) noexcept {
+    size_t count = 0;
+    for (size_t i = 0; i < len; ++i) {
+        count += isContinuation(in[i]) ? 0 : 1;
+    }
+    return count;
+}
+
+#if SEQUOIA_SIMD_X86
+
+// simdutf / simdjson 的查表校验：用前一字节的高、低半字节和当前字节的高半字节查三张表，
+// 三者按位与不为 0 即为非法的两字节组合；再单独检查三、四字节序列的后续字节个数
+constexpr uint8_t kTooShort = 1 << 0;   // 11______ 0_______ 或 11______ 11______
+constexpr uint8_t kTooLong = 1 << 1;    // 0_______ 10______
+constexpr uint8_t kOverlong3 = 1 << 2;  // 11100000 100_____
+constexpr uint8_t kTooLarge = 1 << 3;   // 11110100 1001____ 或 11110100 101_____ 等
+constexpr uint8_t kSurrogate = 1 << 4;  // 11101101 101_____
+constexpr uint8_t kOverlong2 = 1 << 5;  // 1100000_ 10______
+constexpr uint8_t kTooLarge1000 = 1 << 6;  // 11110101 1000____ 等
+constexpr uint8_t kOverlong4 = 1 << 6;     // 11110000 1000____
+constexpr uint8_t kTwoConts = 1 << 7;      // 10______ 10______
+constexpr uint8_t kCarry = kTooShort | kTooLong | kTwoConts;
+
+#define SEQUOIA_UTF8_TABLE(...) _mm256_setr_epi8(__VA_ARGS__, __VA_ARGS__)
+
+SEQUOIA_TARGET_AVX2
+__m256i prevBytes1(__m256i input, __m256i prev_input) noexcept {
+    return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(prev_input, input, 0x21), 15);
+}
+
+SEQUOIA_TARGET_AVX2
+__m256i prevBytes2(__m256i input, __m256i prev_input) noexcept {
+    return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(prev_input, input, 0x21), 14);
+}
+
+SEQUOIA_TARGET_AVX2
+__m256i prevBytes3(__m256i input, __m256i prev_input) noexcept {
+    return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(prev_input, input, 0x21), 13);
+}
+
+SEQUOIA_TARGET_AVX2
+__m256i highNibble(__m256i value) noexcept {
+    return _mm256_and_si256(_mm256_srli_epi16(value, 4), _mm256_set1_epi8(0x0F));
+}
+
+// 返回非 0 的字节表示对应位置存在错误
+SEQUOIA_TARGET_AVX2
+__m256i checkBlock(__m256i input, __m256i prev_input) noexcept {
+    const __m256i byte_1_high_table = SEQUOIA_UTF8_TABLE(
+        kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong,
+        kTwoConts, kTwoConts, kTwoConts, kTwoConts,
+        static_cast<char>(kTooShort | kOverlong2),
+        kTooShort,
+        static_cast<char>(kTooShort | kOverlong3 | kSurrogate),
+        static_cast<char>(kTooShort | kTooLarge | kTooLarge1000 | kOverlong4));
+    const __m256i byte_1_low_table = SEQUOIA_UTF8_TABLE(
+        static_cast<char>(kCarry | kOverlong3 | kOverlong2 | kOverlong4),
+        static_cast<char>(kCarry | kOverlong2),
+        static_cast<char>(kCarry),
+        static_cast<char>(kCarry),
+        static_cast<char>(kCarry | kTooLarge),
+        static_cast<char>(kCarry | kTooLarge | kTooLarge1000),
+        static_cast<char>(kCarry | kTooLarge | kTooLarge1000),
+        static_cast<char>(kCarry | kTooLarge | kTooLarge1000),
+        static_cast<char>(kCarry | kTooLarge | kTooLarge1000),
+        static_cast<char>(kCarry | kTooLarge | kTooLarge1000),
+        static_cast<char>(kCarry | kTooLarge | kTooLarge1000),
+        static_cast<char>(kCarry | kTooLarge | kTooLarge1000),
+        static_cast<char>(kCarry | kTooLarge | kTooLarge1000),
+        static_cast<char>(kCarry | kTooLarge | kTooLarge1000 | kSurrogate),
+        static_cast<char>(kCarry | kTooLarge | kTooLarge1000),
+        static_cast<char>(kCarry | kTooLarge | kTooLarge1000));
+    const __m256i byte_2_high_table = SEQUOIA_UTF8_TABLE(
+        kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort,
+        static_cast<char>(kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge1000 | kOverlong4),
+        static_cast<char>(kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge),
+        static_cast<char>(kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge),
+        static_cast<char>(kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge),
+        kTooShort, kTooShort, kTooShort, kTooShort);
+
+    const __m256i prev1 = prevBytes1(input, prev_input);
+    const __m256i byte_1_high = _mm256_shuffle_epi8(byte_1_high_table, highNibble(prev1));
+    const __m256i byte_1_low = _mm256_shuffle_epi8(byte_1_low_table, _mm256_and_si256(prev1, _mm256_set1_epi8(0x0F)));
+    const __m256i byte_2_high = _mm256_shuffle_epi8(byte_2_high_table, highNibble(input));
+    const __m256i special_cases = _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+
+    // 三、四字节序列的第 3、4 个字节必须是后续字节，且后续字节只能出现在这些位置或两字节组合中
+    const __m256i is_third_byte = _mm256_subs_epu8(prevBytes2(input, prev_input), _mm256_set1_epi8(0xE0 - 0x80));
+    const __m256i is_fourth_byte =
+        _mm256_subs_epu8(prevBytes3(input, prev_input), _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+    const __m256i must_be_continuation =
+        _mm256_and_si256(_mm256_or_si256(is_third_byte, is_fourth_byte), _mm256_set1_epi8(static_cast<char>(0x80)));
+    return _mm256_xor_si256(must_be_continuation, special_cases);
+}
+
+#undef SEQUOIA_UTF8_TABLE
+
+// 块末尾 3 字节内出现多字节序列的首字节时，序列延续到下一块
+SEQUOIA_TARGET_AVX2
+__m256i incompleteTail(__m256i input) noexcept {
+    const __m256i max_value = _mm256_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1));
+    return _mm256_subs_epu8(input, max_value);
+}
+
+struct BlockState {
+    __m256i prev_input;
+    __m256i prev_incomplete;
+};
+
+// 校验一个 32 字节块，返回块内（或从前一块延续过来的序列）是否有错误
+SEQUOIA_TARGET_AVX2
+bool blockHasError(BlockState& state, __m256i input) noexcept {
+    __m256i error;
+    if (_mm256_movemask_epi8(input) == 0) {
+        // ASCII 块：只需确认前一块没有未完成的序列
+        error = state.prev_incomplete;
+        state.prev_incomplete = _mm256_setzero_si256();
+    } else {
+        error = checkBlock(input, state.prev_input);
+        state.prev_incomplete = incompleteTail(input);
+    }
+    state.prev_input = input;
+    return _mm256_testz_si256(error, error) == 0;
+}
+
+/**
+ * @brief 按 32 字节分块校验
+ *
+ * @return size_t 第一个含错误的块的起始偏移（错误可能属于从前一块延续过来的序列），
+ *                末尾序列被截断时返回 len - 3，合法时返回 len
+ */
+SEQUOIA_TARGET_AVX2
+size_t firstInvalidBlockAvx2(const char* data, size_t len) noexcept {
+    BlockState state{_mm256_setzero_si256(), _mm256_setzero_si256()};
+
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        if (blockHasError(state, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)))) {
+            return i;
+        }
+    }
+    if (i < len) {
+        // 尾部补 0（ASCII）后按整块校验，被截断的序列会与补齐的 0 组成非法组合
+        alignas(32) char tail[32] = {};
+        std::memcpy(tail, data + i, len - i);
+        if (blockHasError(state, _mm256_load_si256(reinterpret_cast<const __m256i*>(tail)))) {
+            return i;
+        }
+    } else if (_mm256_testz_si256(state.prev_incomplete, state.prev_incomplete) == 0) {
+        return len - 3;  // 被截断的序列位于最后 3 字节内
+    }
+    return len;
+}
+
+SEQUOIA_TARGET_AVX2
+size_t countCodePointsAvx2(const char* data, size_t len) noexcept {
+    // 有符号比较：后续字节 0x80~0xBF 即 -128~-65
+    const __m256i threshold = _mm256_set1_epi8(-65);
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(block, threshold)));
+        count += static_cast<size_t>(std::popcount(mask));
+    }
+    return count + countCodePointsScalar(reinterpret_cast<const unsigned char*>(data + i), len - i);
+}
+
+SEQUOIA_TARGET_AVX2
+size_t asciiWidthPrefixAvx2(const char* data, size_t len, size_t& width) noexcept {
+    const __m256i control = _mm256_set1_epi8(0x1F);
+    const __m256i del = _mm256_set1_epi8(0x7F);
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        const auto non_ascii = static_cast<uint32_t>(_mm256_movemask_epi8(block));
+        // 有符号比较下非 ASCII 字节为负数，不会计入
+        const auto printable = static_cast<uint32_t>(_mm256_movemask_epi8(
+            _mm256_andnot_si256(_mm256_cmpeq_epi8(block, del), _mm256_cmpgt_epi8(block, control))));
+        if (non_ascii != 0) {
+            const int ascii = std::countr_zero(non_ascii);
+            width += static_cast<size_t>(std::popcount(printable & ((1U << ascii) - 1)));
+            return i + static_cast<size_t>(ascii);
+        }
+        width += static_cast<size_t>(std::popcount(printable));
+    }
+    for (; i < len && static_cast<unsigned char>(data[i]) < 0x80; ++i) {
+        width += isPrintableAscii(static_cast<unsigned char>(data[i])) ? 1 : 0;
+    }
+    return i;
+}
+
+#endif // SEQUOIA_SIMD_X86
+
+// 从 pos 向前最多回退 3 字节，找到包含 pos 的序列的起点（pos 之前的内容已确认合法）
+size_t sequenceStart(std::string_view str, size_t pos) noexcept {
+    size_t start = pos >= 3 ? pos - 3 : 0;
+    while (start < pos && isContinuation(static_cast<unsigned char>(str[start]))) {
+        ++start;
+    }
+    return start;
+}
+
+} // namespace
+
+bool is_valid_utf8(std::string_view str) noexcept {
+#if SEQUOIA_SIMD_X86
+    if (simd::activeLevel() >= simd::SimdLevel::AVX2) {
+        return firstInvalidBlockAvx2(str.data(), str.size()) == str.size();
+    }
+#endif
+    return !findInvalidScalar(str, 0).has_value();
+}
+
+std::optional<size_t> find_invalid_utf8(std::string_view str) noexcept {
+#if SEQUOIA_SIMD_X86
+    if (simd::activeLevel() >= simd::SimdLevel::AVX2) {
+        const size_t block = firstInvalidBlockAvx2(str.data(), str.size());
+        if (block == str.size()) {
+            return std::nullopt;
+        }
+        // 只在出错的块附近逐个序列定位
+        return findInvalidScalar(str, sequenceStart(str, block));
+    }
+#endif
+    return findInvalidScalar(str, 0);
+}
+
+size_t utf8_length(std::string_view str) noexcept {
+#if SEQUOIA_SIMD_X86
+    if (simd::activeLevel() >= simd::SimdLevel::AVX2) {
+        return countCodePointsAvx2(str.data(), str.size());
+    }
+#endif
+    return countCodePointsScalar(reinterpret_cast<const unsigned char*>(str.data()), str.size());
+}
+
+namespace detail {
+
+size_t ascii_width_prefix(std::string_view input, size_t& width) noexcept {
+#if SEQUOIA_SIMD_X86
+    if (simd::activeLevel() >= simd::SimdLevel::AVX2) {
+        return asciiWidthPrefixAvx2(input.data(), input.size(), width);
+    }
+#endif
+    const size_t ascii = ascii_prefix(input);
+    for (size_t i = 0; i < ascii; ++i) {
+        width += isPrintableAscii(static_cast<unsigned char>(input[i])) ? 1 : 0;
+    }
+    return ascii;
+}
+
+} // namespace detail
+
+} // namespace sequoia::utils
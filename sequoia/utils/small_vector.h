@@ -0,0 +1,171 @@
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace sequoia::utils {
+
+/**
+ * @brief 带内联缓冲区的小型向量（small-vector optimization）
+ *
+ * @tparam T 元素类型（必须是平凡可复制类型）
+ * @tparam N 内联容量，元素个数不超过 N 时不进行堆分配
+ *
+ * @details 仅支持平凡可复制类型，扩容和拷贝均使用 memcpy
+ */
+template <typename T, size_t N>
+    requires std::is_trivially_copyable_v<T> && (N > 0)
+class SmallVector {
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    SmallVector() noexcept = default;
+
+    SmallVector(std::initializer_list<T> init) {
+        assign(init.begin(), init.size());
+    }
+
+    explicit SmallVector(std::span<const T> values) {
+        assign(values.data(), values.size());
+    }
+
+    explicit SmallVector(const std::vector<T>& values) {
+        assign(values.data(), values.size());
+    }
+
+    SmallVector(const SmallVector& other) {
+        assign(other.data(), other.size());
+    }
+
+    SmallVector(SmallVector&& other) noexcept {
+        steal(other);
+    }
+
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) {
+            size_ = 0;
+            assign(other.data(), other.size());
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept {
+        if (this != &other) {
+            release();
+            steal(other);
+        }
+        return *this;
+    }
+
+    [[nodiscard]] size_t size() const noexcept { return size_; }
+    [[nodiscard]] size_t capacity() const noexcept { return capacity_; }
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+    // 是否仍使用内联缓冲区（未发生堆分配）
+    [[nodiscard]] bool is_inline() const noexcept { return heap_ == nullptr; }
+
+    [[nodiscard]] T* data() noexcept { return heap_ ? heap_.get() : inline_; }
+    [[nodiscard]] const T* data() const noexcept { return heap_ ? heap_.get() : inline_; }
+
+    [[nodiscard]] iterator begin() noexcept { return data(); }
+    [[nodiscard]] iterator end() noexcept { return data() + size_; }
+    [[nodiscard]] const_iterator begin() const noexcept { return data(); }
+    [[nodiscard]] const_iterator end() const noexcept { return data() + size_; }
+
+    [[nodiscard]] T& operator[](size_t index) noexcept { return data()[index]; }
+    [[nodiscard]] const T& operator[](size_t index) const noexcept { return data()[index]; }
+
+    void reserve(size_t new_capacity) {
+        if (new_capacity <= capacity_) {
+            return;
+        }
+        auto buffer = std::make_unique_for_overwrite<T[]>(new_capacity);
+        std::memcpy(buffer.get(), data(), size_ * sizeof(T));
+        heap_ = std::move(buffer);
+        capacity_ = new_capacity;
+    }
+
+    void push_back(const T& value) {
+        if (size_ == capacity_) [[unlikely]] {
+            grow_and_push(value);
+            return;
+        }
+        data()[size_++] = value;
+    }
+
+    void clear() noexcept {
+        size_ = 0;
+    }
+
+    [[nodiscard]] std::span<const T> span() const noexcept {
+        return {data(), size_};
+    }
+
+    [[nodiscard]] std::vector<T> to_vector() const {
+        return std::vector<T>(begin(), end());
+    }
+
+    [[nodiscard]] bool operator==(const SmallVector& other) const noexcept {
+        return std::equal(begin(), end(), other.begin(), other.end());
+    }
+
+    [[nodiscard]] auto operator<=>(const SmallVector& other) const noexcept {
+        return std::lexicographical_compare_three_way(begin(), end(), other.begin(), other.end());
+    }
+
+private:
+    // 扩容后直接写入新的堆缓冲区；不内联，编译器不会把内联缓冲区的下标与扩容后的 size_ 混在一起分析
+    [[gnu::noinline]] void grow_and_push(const T& value) {
+        // value 可能引用自身元素，先拷贝再扩容
+        const T copy = value;
+        reserve(capacity_ * 2);
+        T* buffer = heap_.get();
+        buffer[size_++] = copy;
+    }
+
+    void assign(const T* values, size_t count) {
+        reserve(count);
+        if (count > 0) {
+            std::memcpy(data(), values, count * sizeof(T));
+        }
+        size_ = count;
+    }
+
+    void steal(SmallVector& other) noexcept {
+        size_ = other.size_;
+        if (other.heap_) {
+            heap_ = std::move(other.heap_);
+            capacity_ = other.capacity_;
+        } else {
+            capacity_ = N;
+            std::memcpy(inline_, other.inline_, size_ * sizeof(T));
+        }
+        other.size_ = 0;
+        other.capacity_ = N;
+    }
+
+    void release() noexcept {
+        heap_.reset();
+        capacity_ = N;
+    }
+
+private:
+    /// @brief 堆缓冲区，为空时使用内联缓冲区
+    std::unique_ptr<T[]> heap_;
+    size_t size_{0};
+    size_t capacity_{N};
+    T inline_[N]{};
+};
+
+} // namespace sequoia::utils
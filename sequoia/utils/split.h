@@ -0,0 +1,305 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <string_view>
+
+namespace sequoia::utils {
+
+/**
+ * @brief 分隔符字符集合（多分隔符分割使用）
+ *
+ * @details 256 位位图用于标量查找；不超过 kMaxSimdChars 个字符时同时保存字符列表供 SIMD 内核使用
+ */
+class DelimiterSet {
+public:
+    static constexpr size_t kMaxSimdChars = 8;
+
+    constexpr DelimiterSet() noexcept = default;
+
+    constexpr explicit DelimiterSet(std::string_view delimiters) noexcept {
+        for (const char c : delimiters) {
+            if (contains(c)) {
+                continue;
+            }
+            const auto byte = static_cast<unsigned char>(c);
+            bits_[byte >> 6] |= uint64_t{1} << (byte & 63);
+            if (count_ < kMaxSimdChars) {
+                chars_[count_] = c;
+            }
+            ++count_;
+        }
+    }
+
+    [[nodiscard]] constexpr bool contains(char c) const noexcept {
+        const auto byte = static_cast<unsigned char>(c);
+        return (bits_[byte >> 6] >> (byte & 63)) & 1;
+    }
+
+    [[nodiscard]] constexpr bool empty() const noexcept {
+        return count_ == 0;
+    }
+
+    // 字符数超过 kMaxSimdChars 时返回空，只能走标量查找
+    [[nodiscard]] constexpr std::string_view simd_chars() const noexcept {
+        return count_ <= kMaxSimdChars ? std::string_view(chars_.data(), count_) : std::string_view{};
+    }
+
+private:
+    std::array<uint64_t, 4> bits_{};
+    std::array<char, kMaxSimdChars> chars_{};
+    size_t count_{0};
+};
+
+namespace detail {
+
+/**
+ * @brief 在 [first, last) 中查找字符 c，未找到返回 last
+ *
+ * @details 运行时按 CPU 分派到 AVX2 / memchr 实现
+ */
+[[nodiscard]] const char* find_char(const char* first, const char* last, char c) noexcept;
+
+/**
+ * @brief 在 [first, last) 中查找任一分隔符，未找到返回 last
+ */
+[[nodiscard]] const char* find_any_of(const char* first, const char* last,
+                                      const DelimiterSet& delimiters) noexcept;
+
+// 以下分隔符策略的 find() 返回从 pos 开始的下一个分隔符位置（未找到为 npos），length() 为分隔符长度
+
+struct CharDelimiter {
+    char delimiter;
+
+    [[nodiscard]] size_t find(std::string_view str, size_t pos) const noexcept {
+        // 默认构造的 string_view 的 data() 为 nullptr，即使长度为 0 也不能传给 memchr
+        if (pos >= str.size()) {
+            return std::string_view::npos;
+        }
+        const char* last = str.data() + str.size();
+        const char* found = find_char(str.data() + pos, last, delimiter);
+        return found == last ? std::string_view::npos : static_cast<size_t>(found - str.data());
+    }
+
+    [[nodiscard]] constexpr size_t length() const noexcept {
+        return 1;
+    }
+};
+
+struct StringDelimiter {
+    std::string_view delimiter;
+
+    [[nodiscard]] size_t find(std::string_view str, size_t pos) const noexcept {
+        // 空分隔符不分割
+        if (delimiter.empty()) {
+            return std::string_view::npos;
+        }
+        // 用 SIMD 查找首字符，再比较剩余部分
+        const char* last = str.data() + str.size();
+        const char* cursor = str.data() + pos;
+        while (static_cast<size_t>(last - cursor) >= delimiter.size()) {
+            cursor = find_char(cursor, last - delimiter.size() + 1, delimiter.front());
+            if (cursor == last - delimiter.size() + 1) {
+                break;
+            }
+            if (std::string_view(cursor, delimiter.size()) == delimiter) {
+                return static_cast<size_t>(cursor - str.data());
+            }
+            ++cursor;
+        }
+        return std::string_view::npos;
+    }
+
+    [[nodiscard]] constexpr size_t length() const noexcept {
+        return delimiter.size();
+    }
+};
+
+struct AnyOfDelimiter {
+    DelimiterSet delimiters;
+
+    [[nodiscard]] size_t find(std::string_view str, size_t pos) const noexcept {
+        const char* last = str.data() + str.size();
+        const char* found = find_any_of(str.data() + pos, last, delimiters);
+        return found == last ? std::string_view::npos : static_cast<size_t>(found - str.data());
+    }
+
+    [[nodiscard]] constexpr size_t length() const noexcept {
+        return 1;
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief 惰性分割视图，逐个产生字段，不分配内存
+ *
+ * @tparam Delimiter 分隔符策略
+ *
+ * @details
+ * 1. 满足 std::ranges::forward_range，可与 std::views::take 等适配器组合
+ * 2. 分割规则与 split() 一致：连续分隔符产生空字段，空字符串产生一个空字段
+ * 3. 产生的 std::string_view 指向输入字符串，生命周期应与输入相同
+ *
+ * @code
+ * for (std::string_view field : split_view("a,b,c", ',')) { ... }
+ * auto first_two = split_view(line, '\t') | std::views::take(2);
+ * @endcode
+ */
+template <typename Delimiter>
+class SplitView : public std::ranges::view_interface<SplitView<Delimiter>> {
+public:
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using iterator_concept = std::forward_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::string_view;
+
+        Iterator() = default;
+
+        Iterator(std::string_view str, Delimiter delimiter) noexcept
+            : str_(str), delimiter_(delimiter), done_(false) {
+            locate(0);
+        }
+
+        [[nodiscard]] std::string_view operator*() const noexcept {
+            return str_.substr(start_, end_ - start_);
+        }
+
+        Iterator& operator++() noexcept {
+            if (end_ == str_.size() && !has_delimiter_) {
+                done_ = true;
+            } else {
+                locate(end_ + delimiter_.length());
+            }
+            return *this;
+        }
+
+        Iterator operator++(int) noexcept {
+            Iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        // 从当前字段开始到结尾的全部内容
+        [[nodiscard]] std::string_view rest() const noexcept {
+            return str_.substr(start_);
+        }
+
+        [[nodiscard]] bool operator==(const Iterator& other) const noexcept {
+            return done_ == other.done_ && (done_ || (str_.data() == other.str_.data() && start_ == other.start_));
+        }
+
+        [[nodiscard]] bool operator==(std::default_sentinel_t) const noexcept {
+            return done_;
+        }
+
+    private:
+        void locate(size_t start) noexcept {
+            start_ = start;
+            const size_t pos = delimiter_.find(str_, start);
+            has_delimiter_ = pos != std::string_view::npos;
+            end_ = has_delimiter_ ? pos : str_.size();
+        }
+
+        std::string_view str_;
+        Delimiter delimiter_{};
+        size_t start_{0};
+        size_t end_{0};
+        bool has_delimiter_{false};
+        bool done_{true};
+    };
+
+    SplitView() = default;
+
+    SplitView(std::string_view str, Delimiter delimiter) noexcept
+        : str_(str), delimiter_(delimiter) {}
+
+    [[nodiscard]] Iterator begin() const noexcept {
+        return Iterator(str_, delimiter_);
+    }
+
+    [[nodiscard]] std::default_sentinel_t end() const noexcept {
+        return std::default_sentinel;
+    }
+
+private:
+    std::string_view str_;
+    Delimiter delimiter_{};
+};
+
+/**
+ * @brief 按单个字符惰性分割字符串
+ */
+[[nodiscard]] inline SplitView<detail::CharDelimiter> split_view(std::string_view str_view, char delimiter) noexcept {
+    return {str_view, detail::CharDelimiter{delimiter}};
+}
+
+/**
+ * @brief 按分隔符字符串惰性分割字符串，分隔符为空时不分割
+ */
+[[nodiscard]] inline SplitView<detail::StringDelimiter> split_view(std::string_view str_view,
+                                                                  std::string_view split_str) noexcept {
+    return {str_view, detail::StringDelimiter{split_str}};
+}
+
+/**
+ * @brief 按任一分隔符字符惰性分割字符串 如：split_any("a,b;c", ",;") -> "a" "b" "c"
+ */
+[[nodiscard]] inline SplitView<detail::AnyOfDelimiter> split_any(std::string_view str_view,
+                                                                const DelimiterSet& delimiters) noexcept {
+    return {str_view, detail::AnyOfDelimiter{delimiters}};
+}
+
+[[nodiscard]] inline SplitView<detail::AnyOfDelimiter> split_any(std::string_view str_view,
+                                                                std::string_view delimiters) noexcept {
+    return split_any(str_view, DelimiterSet(delimiters));
+}
+
+/**
+ * @brief 将分割结果写入调用方提供的数组（不分配内存）
+ *
+ * @param fields 分割视图
+ * @param out 输出数组
+ * @return size_t 写入的字段数
+ *
+ * @note 字段数超过 out.size() 时，最后一个元素保存剩余的全部未分割内容
+ */
+template <typename Delimiter>
+[[nodiscard]] size_t split_into(SplitView<Delimiter> fields, std::span<std::string_view> out) noexcept {
+    if (out.empty()) {
+        return 0;
+    }
+    size_t count = 0;
+    auto it = fields.begin();
+    for (; count + 1 < out.size() && it != std::default_sentinel; ++it) {
+        out[count++] = *it;
+    }
+    if (it != std::default_sentinel) {
+        out[count++] = it.rest();
+    }
+    return count;
+}
+
+// 按单个字符分割，写入调用方提供的数组
+[[nodiscard]] inline size_t split_into(std::string_view str_view, char delimiter,
+                                       std::span<std::string_view> out) noexcept {
+    return split_into(split_view(str_view, delimiter), out);
+}
+
+// 按分隔符字符串分割，写入调用方提供的数组
+[[nodiscard]] inline size_t split_into(std::string_view str_view, std::string_view split_str,
+                                       std::span<std::string_view> out) noexcept {
+    return split_into(split_view(str_view, split_str), out);
+}
+
+} // namespace sequoia::utils
+
+template <typename Delimiter>
+inline constexpr bool std::ranges::enable_borrowed_range<sequoia::utils::SplitView<Delimiter>> = true;
@@ -0,0 +1,209 @@
+#include "category.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <mutex>
+
+namespace sequoia::utils::trace {
+
+namespace {
+
+struct CategoryTable {
+    std::mutex mutex;
+    // 名称写入后才以 release 发布 count，信号处理函数只读取 [0, count)
+    std::array<std::array<char, kMaxCategoryName + 1>, kMaxCategories> names{};
+    std::atomic<size_t> count{0};
+    // 信号触发时读取的文件路径
+    std::array<char, 256> signal_path{};
+};
+
+// 常量初始化（无析构顺序与初始化守卫问题），信号处理函数可直接访问
+CategoryTable& categoryTable() noexcept {
+    static constinit CategoryTable table;
+    return table;
+}
+
+[[nodiscard]] bool isSeparator(char ch) noexcept {
+    return ch == ',' || ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r';
+}
+
+[[nodiscard]] bool nameEquals(const std::array<char, kMaxCategoryName + 1>& stored, const char* name,
+                              size_t size) noexcept {
+    for (size_t i = 0; i < size; ++i) {
+        if (stored[i] != name[i]) {
+            return false;
+        }
+    }
+    return stored[size] == '\0';
+}
+
+// 只查找不注册，异步信号安全
+[[nodiscard]] uint64_t findBit(const char* name, size_t size) noexcept {
+    const CategoryTable& table = categoryTable();
+    const size_t count = table.count.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; ++i) {
+        if (nameEquals(table.names[i], name, size)) {
+            return uint64_t{1} << i;
+        }
+    }
+    return 0;
+}
+
+// 依次回调列表中的每个名称
+template <typename Callback>
+void forEachName(const char* list, size_t size, Callback&& callback) {
+    size_t pos = 0;
+    while (pos < size) {
+        while (pos < size && isSeparator(list[pos])) {
+            ++pos;
+        }
+        const size_t begin = pos;
+        while (pos < size && !isSeparator(list[pos])) {
+            ++pos;
+        }
+        if (pos > begin) {
+            callback(list + begin, pos - begin);
+        }
+    }
+}
+
+[[nodiscard]] bool isAll(const char* name, size_t size) noexcept {
+    return size == 3 && name[0] == 'a' && name[1] == 'l' && name[2] == 'l';
+}
+
+[[nodiscard]] bool isNone(const char* name, size_t size) noexcept {
+    return size == 4 && name[0] == 'n' && name[1] == 'o' && name[2] == 'n' && name[3] == 'e';
+}
+
+void reloadCategoriesOnSignal(int) {
+    const int saved_errno = errno;
+    const int fd = ::open(categoryTable().signal_path.data(), O_RDONLY | O_CLOEXEC);
+    if (fd >= 0) {
+        std::array<char, 4096> buffer;
+        size_t size = 0;
+        while (size < buffer.size()) {
+            const ssize_t n = ::read(fd, buffer.data() + size, buffer.size() - size);
+            if (n <= 0) {
+                break;
+            }
+            size += static_cast<size_t>(n);
+        }
+        ::close(fd);
+
+        uint64_t mask = 0;
+        forEachName(buffer.data(), size, [&mask](const char* name, size_t length) {
+            mask |= isAll(name, length) ? ~uint64_t{0} : findBit(name, length);
+        });
+        set_category_mask(mask);
+    }
+    errno = saved_errno;
+}
+
+// 进程启动时按环境变量初始化
+[[maybe_unused]] const bool kCategoriesFromEnv = [] {
+    if (const char* list = std::getenv("SEQUOIA_TRACE_CATEGORIES")) {
+        return set_categories(list);
+    }
+    return true;
+}();
+
+} // namespace
+
+uint64_t category_bit(std::string_view name) {
+    if (name.empty() || name.size() > kMaxCategoryName) {
+        return 0;
+    }
+    if (const uint64_t bit = findBit(name.data(), name.size()); bit != 0) {
+        return bit;
+    }
+
+    CategoryTable& table = categoryTable();
+    const std::lock_guard<std::mutex> guard(table.mutex);
+    const size_t count = table.count.load(std::memory_order_relaxed);
+    // 加锁后再查一次，避免并发注册同名类别
+    for (size_t i = 0; i < count; ++i) {
+        if (nameEquals(table.names[i], name.data(), name.size())) {
+            return uint64_t{1} << i;
+        }
+    }
+    if (count == kMaxCategories) {
+        return 0;
+    }
+    auto& slot = table.names[count];
+    name.copy(slot.data(), name.size());
+    slot[name.size()] = '\0';
+    table.count.store(count + 1, std::memory_order_release);
+    return uint64_t{1} << count;
+}
+
+void enable_category(std::string_view name) {
+    detail::category_mask.fetch_or(category_bit(name), std::memory_order_relaxed);
+}
+
+void disable_category(std::string_view name) {
+    detail::category_mask.fetch_and(~category_bit(name), std::memory_order_relaxed);
+}
+
+bool set_categories(std::string_view list) {
+    uint64_t mask = 0;
+    bool ok = true;
+    forEachName(list.data(), list.size(), [&](const char* name, size_t size) {
+        if (isAll(name, size)) {
+            mask = ~uint64_t{0};
+        } else if (!isNone(name, size)) {
+            const uint64_t bit = category_bit(std::string_view(name, size));
+            ok = ok && bit != 0;
+            mask |= bit;
+        }
+    });
+    set_category_mask(mask);
+    return ok;
+}
+
+std::vector<std::string> categories() {
+    const CategoryTable& table = categoryTable();
+    const size_t count = table.count.load(std::memory_order_acquire);
+    std::vector<std::string> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        result.emplace_back(table.names[i].data());
+    }
+    return result;
+}
+
+std::vector<std::string> enabled_categories() {
+    const uint64_t mask = category_mask();
+    std::vector<std::string> result;
+    const auto names = categories();
+    for (size_t i = 0; i < names.size(); ++i) {
+        if ((mask >> i) & 1) {
+            result.push_back(names[i]);
+        }
+    }
+    return result;
+}
+
+bool install_category_signal(int signum, std::string_view path) {
+    CategoryTable& table = categoryTable();
+    if (path.empty() || path.size() >= table.signal_path.size()) {
+        return false;
+    }
+    {
+        const std::lock_guard<std::mutex> guard(table.mutex);
+        path.copy(table.signal_path.data(), path.size());
+        table.signal_path[path.size()] = '\0';
+    }
+
+    struct sigaction action {};
+    action.sa_handler = &reloadCategoriesOnSignal;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    return ::sigaction(signum, &action, nullptr) == 0;
+}
+
+} // namespace sequoia::utils::trace
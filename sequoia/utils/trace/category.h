@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sequoia::utils::trace {
+
+// 最多 64 个类别（掩码的每一位对应一个），超出后新类别恒为关闭
+inline constexpr size_t kMaxCategories = 64;
+inline constexpr size_t kMaxCategoryName = 31;
+
+namespace detail {
+
+// 启用的类别掩码，热路径只做一次 relaxed load
+inline std::atomic<uint64_t> category_mask{0};
+
+} // namespace detail
+
+/**
+ * @brief 类别对应的掩码位，首次使用时注册
+ *
+ * @return uint64_t 只有一位为 1；名称为空、超过 kMaxCategoryName 或类别已满时返回 0（恒为关闭）
+ */
+[[nodiscard]] uint64_t category_bit(std::string_view name);
+
+[[nodiscard]] inline bool category_enabled(uint64_t bit) noexcept {
+    return (detail::category_mask.load(std::memory_order_relaxed) & bit) != 0;
+}
+
+[[nodiscard]] inline bool category_enabled(std::string_view name) {
+    return category_enabled(category_bit(name));
+}
+
+void enable_category(std::string_view name);
+
+void disable_category(std::string_view name);
+
+/**
+ * @brief 按列表设置启用的类别，未列出的全部关闭
+ *
+ * @param list 以逗号或空白分隔的类别名；"all" 启用全部（含之后注册的类别），空串或 "none" 全部关闭
+ * @return bool 列表中有无法注册的名称时返回 false（其余名称仍生效）
+ */
+bool set_categories(std::string_view list);
+
+[[nodiscard]] inline uint64_t category_mask() noexcept {
+    return detail::category_mask.load(std::memory_order_relaxed);
+}
+
+inline void set_category_mask(uint64_t mask) noexcept {
+    detail::category_mask.store(mask, std::memory_order_relaxed);
+}
+
+// 已注册的类别名（按注册顺序，下标即位序号）
+[[nodiscard]] std::vector<std::string> categories();
+
+[[nodiscard]] std::vector<std::string> enabled_categories();
+
+/**
+ * @brief 收到 signum 时从 path 重新读取类别列表（格式同 set_categories）
+ *
+ * @details
+ * 1. 信号处理函数只使用 open / read 与原子操作，是异步信号安全的；
+ *    文件中尚未注册的类别名会被忽略，文件最多读取前 4KB
+ * 2. 进程启动时若设置了环境变量 SEQUOIA_TRACE_CATEGORIES，按其内容初始化
+ *
+ * @code
+ * install_category_signal(SIGUSR2, "/var/run/gateway.trace");
+ * // 排查时：echo "db,net" > /var/run/gateway.trace && kill -USR2 <pid>
+ * @endcode
+ *
+ * @return bool path 过长或注册信号处理函数失败时返回 false
+ */
+bool install_category_signal(int signum, std::string_view path);
+
+} // namespace sequoia::utils::trace
@@ -0,0 +1,168 @@
+#include "chrome_trace.h"
+
+#include <unistd.h>
+
+#include <array>
+#include <cstdio>
+#include <fstream>
+
+namespace sequoia::utils::trace {
+
+namespace {
+
+void appendJsonString(std::string& out, std::string_view text) {
+    out += '"';
+    for (const char ch : text) {
+        switch (ch) {
+        case '"':
+            out += "\\\"";
+            break;
+        case '\\':
+            out += "\\\\";
+            break;
+        case '\n':
+            out += "\\n";
+            break;
+        case '\t':
+            out += "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(ch) < 0x20) {
+                std::array<char, 8> escaped{};
+                std::snprintf(escaped.data(), escaped.size(), "\\u%04x", static_cast<unsigned>(ch));
+                out += escaped.data();
+            } else {
+                out += ch;
+            }
+        }
+    }
+    out += '"';
+}
+
+// 微秒，保留到纳秒
+void appendMicroseconds(std::string& out, double us) {
+    std::array<char, 32> buffer{};
+    std::snprintf(buffer.data(), buffer.size(), "%.3f", us);
+    out += buffer.data();
+}
+
+} // namespace
+
+// 线程退出时标记事件环，下次导出后释放
+struct ChromeTrace::ThreadExit {
+    std::shared_ptr<detail::EventRing> ring;
+
+    ~ThreadExit() {
+        if (ring) {
+            ring->retire();
+        }
+        thread_ring_ = nullptr;
+    }
+};
+
+ChromeTrace& ChromeTrace::instance() {
+    // 有意不析构：进程退出时其他线程可能仍在记录
+    static ChromeTrace* trace = new ChromeTrace();
+    return *trace;
+}
+
+detail::EventRing* ChromeTrace::register_thread() noexcept {
+    // 在 zone 的析构中调用，事件环分配失败时丢弃本次事件而不是终止进程
+    try {
+        thread_local ThreadExit thread_exit;
+
+        std::shared_ptr<detail::EventRing> ring;
+        {
+            const std::lock_guard<std::mutex> guard(mutex_);
+            ring = std::make_shared<detail::EventRing>(next_thread_id_++);
+            rings_.push_back(ring);
+        }
+        thread_exit.ring = ring;
+        thread_ring_ = ring.get();
+        return thread_ring_;
+    } catch (...) {
+        unregistered_lost_.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+}
+
+std::string ChromeTrace::flush() {
+    const double ns_per_tick = 1.0 / ticks_per_ns();
+    const uint64_t origin = origin_ticks();
+    const auto to_us = [&](uint64_t ticks) {
+        return static_cast<double>(static_cast<int64_t>(ticks - origin)) * ns_per_tick / 1000.0;
+    };
+    const std::string pid = std::to_string(::getpid());
+
+    std::string json = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    const auto begin_event = [&]() {
+        if (!first) {
+            json += ',';
+        }
+        first = false;
+        json += "\n{";
+    };
+
+    std::vector<detail::EventRing::Event> events;
+    const std::lock_guard<std::mutex> guard(mutex_);
+    uint64_t lost = unregistered_lost_.exchange(0, std::memory_order_relaxed);
+    for (auto it = rings_.begin(); it != rings_.end();) {
+        const auto& ring = *it;
+        // 先读 retired：为 true 时线程已不再写入，本次读取即可取完，之后释放事件环
+        const bool retired = ring->retired();
+        events.clear();
+        lost += ring->read(events);
+        const std::string tid = std::to_string(ring->thread_id());
+
+        begin_event();
+        json += "\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" + pid + ",\"tid\":" + tid +
+                ",\"args\":{\"name\":\"thread-" + tid + "\"}}";
+        for (const auto& event : events) {
+            begin_event();
+            json += "\"name\":";
+            appendJsonString(json, event.site->display_name());
+            if (event.end == 0) {
+                json += ",\"ph\":\"i\",\"s\":\"t\",\"ts\":";
+                appendMicroseconds(json, to_us(event.start));
+            } else {
+                json += ",\"ph\":\"X\",\"ts\":";
+                appendMicroseconds(json, to_us(event.start));
+                json += ",\"dur\":";
+                appendMicroseconds(json, static_cast<double>(event.end - event.start) * ns_per_tick / 1000.0);
+            }
+            json += ",\"pid\":" + pid + ",\"tid\":" + tid + ",\"args\":{\"file\":";
+            appendJsonString(json, event.site->location.file_name());
+            json += ",\"line\":" + std::to_string(event.site->location.line()) + "}}";
+        }
+        it = retired ? rings_.erase(it) : it + 1;
+    }
+    json += "\n],\"otherData\":{\"lost_events\":\"" + std::to_string(lost) + "\"}}\n";
+    return json;
+}
+
+bool ChromeTrace::flush(const std::string& path) {
+    const std::string json = flush();
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+    file << json;
+    return static_cast<bool>(file.flush());
+}
+
+void ChromeTrace::set_output_path(std::string path) {
+    const std::lock_guard<std::mutex> guard(mutex_);
+    output_path_ = std::move(path);
+}
+
+std::string ChromeTrace::output_path() {
+    const std::lock_guard<std::mutex> guard(mutex_);
+    return output_path_;
+}
+
+bool ChromeTrace::shutdown() {
+    return flush(output_path());
+}
+
+} // namespace sequoia::utils::trace
@@ -0,0 +1,226 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <sequoia/utils/trace/zone.h>
+
+namespace sequoia::utils::trace {
+
+namespace detail {
+
+/**
+ * @brief 线程私有的有界事件环：写满后覆盖最旧的事件，保留最近 kCapacity - 1 个
+ *
+ * @details 写入方为所属线程（无锁、无分配）；读取方在持有导出锁时复制后按 head 校验（seqlock 式），
+ *          复制期间可能被覆盖的槽位直接丢弃，因此不会导出撕裂的事件
+ */
+class EventRing {
+public:
+    static constexpr size_t kCapacity = 16384;
+
+    struct Event {
+        const ZoneSite* site;
+        uint64_t start;
+        // 0 表示瞬时事件（帧标记）
+        uint64_t end;
+    };
+
+    explicit EventRing(uint32_t thread_id) noexcept : thread_id_(thread_id) {}
+
+    void push(const ZoneSite* site, uint64_t start, uint64_t end) noexcept {
+        const uint64_t head = head_.load(std::memory_order_relaxed);
+        // 保证读取方看到本次写入的槽位内容时，也能看到此前发布的 head
+        std::atomic_thread_fence(std::memory_order_release);
+        Slot& slot = slots_[head % kCapacity];
+        slot.site.store(site, std::memory_order_relaxed);
+        slot.start.store(start, std::memory_order_relaxed);
+        slot.end.store(end, std::memory_order_relaxed);
+        head_.store(head + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief 复制自上次读取以来仍保留的事件并前移读取位置
+     *
+     * @return uint64_t 因覆盖而丢失的事件数
+     */
+    uint64_t read(std::vector<Event>& out) {
+        const uint64_t head = head_.load(std::memory_order_acquire);
+        const uint64_t from = std::max(read_, oldest_valid(head));
+        const size_t base = out.size();
+        for (uint64_t i = from; i < head; ++i) {
+            const Slot& slot = slots_[i % kCapacity];
+            out.push_back(Event{slot.site.load(std::memory_order_relaxed), slot.start.load(std::memory_order_relaxed),
+                                slot.end.load(std::memory_order_relaxed)});
+        }
+        // 复制期间写入方可能已绕回，丢弃被覆盖的前缀
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const uint64_t now = head_.load(std::memory_order_relaxed);
+        const uint64_t valid_from = std::max(from, oldest_valid(now));
+        const auto torn = static_cast<size_t>(std::min(valid_from, head) - from);
+        out.erase(out.begin() + static_cast<std::ptrdiff_t>(base),
+                  out.begin() + static_cast<std::ptrdiff_t>(base + torn));
+        const uint64_t lost = std::min(valid_from, head) - read_;
+        read_ = head;
+        return lost;
+    }
+
+    [[nodiscard]] uint32_t thread_id() const noexcept {
+        return thread_id_;
+    }
+
+    void retire() noexcept {
+        retired_.store(true, std::memory_order_release);
+    }
+
+    [[nodiscard]] bool retired() const noexcept {
+        return retired_.load(std::memory_order_acquire);
+    }
+
+private:
+    // head 为 h 时仍可安全读取的最小序号（下一次写入的槽位不算在内）
+    [[nodiscard]] static constexpr uint64_t oldest_valid(uint64_t head) noexcept {
+        return head >= kCapacity ? head - kCapacity + 1 : 0;
+    }
+
+    struct Slot {
+        std::atomic<const ZoneSite*> site{nullptr};
+        std::atomic<uint64_t> start{0};
+        std::atomic<uint64_t> end{0};
+    };
+
+    alignas(64) std::atomic<uint64_t> head_{0};
+    std::atomic<bool> retired_{false};
+    // 以下只在导出锁内访问
+    uint64_t read_{0};
+    uint32_t thread_id_;
+    Slot slots_[kCapacity];
+};
+
+} // namespace detail
+
+/**
+ * @brief 将 zone 与帧标记记录为 Chrome trace-event JSON（chrome://tracing、Perfetto UI 可直接打开）
+ *
+ * @details
+ * 1. 开启 UTIL_TRACE_CHROME 后，T_SCOPED* 记录为完整事件（"ph":"X"），T_FRAME_MARK* 记录为瞬时事件（"ph":"i"）；
+ *    热路径为两次读 TSC 与一次线程私有环写入，无锁、无分配
+ * 2. 每个线程只保留最近 EventRing::kCapacity - 1 个事件，更早的被覆盖并计入 otherData.lost_events；
+ *    线程首次记录时分配事件环，分配失败的事件同样计入 lost_events
+ * 3. flush 导出自上次 flush 以来仍保留的事件；T_SHUTDOWN 调用 shutdown，导出到 output_path
+ *
+ * @code
+ * ChromeTrace::instance().set_output_path("/tmp/order_gateway.json");
+ * ...
+ * T_SHUTDOWN;  // 或随时 ChromeTrace::instance().flush("/tmp/snapshot.json")
+ * @endcode
+ */
+class ChromeTrace {
+public:
+    [[nodiscard]] static ChromeTrace& instance();
+
+    ChromeTrace(const ChromeTrace&) = delete;
+    ChromeTrace& operator=(const ChromeTrace&) = delete;
+
+    [[nodiscard]] static bool enabled() noexcept {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    // 运行时开关，关闭后新进入的 zone 不再记录
+    static void set_enabled(bool enabled) noexcept {
+        enabled_.store(enabled, std::memory_order_relaxed);
+    }
+
+    // 记录一个已结束的 zone
+    static void record(const ZoneSite* site, uint64_t start_ticks, uint64_t end_ticks) noexcept {
+        if (detail::EventRing* events = ring()) [[likely]] {
+            events->push(site, start_ticks, end_ticks);
+        }
+    }
+
+    // 记录瞬时事件
+    static void mark(const ZoneSite* site) noexcept {
+        if (!enabled()) {
+            return;
+        }
+        if (detail::EventRing* events = ring()) [[likely]] {
+            events->push(site, detail::read_ticks(), 0);
+        }
+    }
+
+    /**
+     * @brief 导出到文件
+     *
+     * @return bool 文件无法打开或写入失败时返回 false（事件仍视为已导出）
+     */
+    bool flush(const std::string& path);
+
+    // 导出为 JSON 文本（同样会前移读取位置）
+    [[nodiscard]] std::string flush();
+
+    // shutdown 时的导出路径，默认 "sequoia_trace.json"
+    void set_output_path(std::string path);
+
+    [[nodiscard]] std::string output_path();
+
+    // 导出到 output_path
+    bool shutdown();
+
+private:
+    struct ThreadExit;
+
+    ChromeTrace() = default;
+
+    // 事件环分配失败时返回 nullptr，调用方丢弃事件
+    [[nodiscard]] static detail::EventRing* ring() noexcept {
+        detail::EventRing* ring = thread_ring_;
+        if (ring == nullptr) [[unlikely]] {
+            ring = instance().register_thread();
+        }
+        return ring;
+    }
+
+    // 失败时事件计入 lost_events，下次记录时重试
+    detail::EventRing* register_thread() noexcept;
+
+private:
+    static inline std::atomic<bool> enabled_{true};
+    static inline thread_local detail::EventRing* thread_ring_{nullptr};
+
+    std::mutex mutex_;
+    uint32_t next_thread_id_{0};
+    std::vector<std::shared_ptr<detail::EventRing>> rings_;
+    std::string output_path_{"sequoia_trace.json"};
+    // 事件环注册失败时丢弃的事件，不持锁累加，导出时并入 lost_events
+    std::atomic<uint64_t> unregistered_lost_{0};
+};
+
+/**
+ * @brief 作用域计时：析构时记录为 Chrome 完整事件
+ */
+class ChromeScopedZone {
+public:
+    // active 为 false 时不记录（用于按类别开关的 zone）
+    explicit ChromeScopedZone(const ZoneSite* site, bool active = true) noexcept
+        : site_(active && ChromeTrace::enabled() ? site : nullptr), start_(site_ ? detail::read_ticks() : 0) {}
+
+    ~ChromeScopedZone() {
+        if (site_ != nullptr) {
+            ChromeTrace::record(site_, start_, detail::read_ticks());
+        }
+    }
+
+    ChromeScopedZone(const ChromeScopedZone&) = delete;
+    ChromeScopedZone& operator=(const ChromeScopedZone&) = delete;
+
+private:
+    const ZoneSite* site_;
+    uint64_t start_;
+};
+
+} // namespace sequoia::utils::trace
@@ -0,0 +1,177 @@
+#include "memory.h"
+#include "trace.h"
+
+#if defined(UTIL_TRACE_ENABLE) && defined(UTIL_TRACE_MEMORY)
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// 替换全局 operator new/delete，把每次分配与释放上报给 Tracy 的内存视图
+// 使用 Secure 版本：进程启动早期或 T_SHUTDOWN 之后 profiler 不可用时静默跳过
+
+namespace {
+
+// 常量初始化，静态构造之前的分配也能计数
+constinit std::atomic<uint64_t> allocations{0};
+constinit std::atomic<uint64_t> frees{0};
+constinit std::atomic<uint64_t> allocated_bytes{0};
+
+void onAllocate(void* ptr, std::size_t size) noexcept {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    TracySecureAlloc(ptr, size);
+}
+
+void* allocate(std::size_t size) noexcept {
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr != nullptr) {
+        onAllocate(ptr, size);
+    }
+    return ptr;
+}
+
+void* allocateAligned(std::size_t size, std::align_val_t alignment) noexcept {
+    const auto align = static_cast<std::size_t>(alignment);
+    // aligned_alloc 要求 size 为 alignment 的整数倍
+    const std::size_t rounded = size == 0 ? align : (size + align - 1) / align * align;
+    void* ptr = std::aligned_alloc(align, rounded);
+    if (ptr != nullptr) {
+        onAllocate(ptr, size);
+    }
+    return ptr;
+}
+
+void deallocate(void* ptr) noexcept {
+    if (ptr != nullptr) {
+        frees.fetch_add(1, std::memory_order_relaxed);
+        TracySecureFree(ptr);
+        std::free(ptr);
+    }
+}
+
+void* allocateOrThrow(std::size_t size) {
+    while (true) {
+        if (void* ptr = allocate(size)) {
+            return ptr;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void* allocateAlignedOrThrow(std::size_t size, std::align_val_t alignment) {
+    while (true) {
+        if (void* ptr = allocateAligned(size, alignment)) {
+            return ptr;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    return allocateOrThrow(size);
+}
+
+void* operator new[](std::size_t size) {
+    return allocateOrThrow(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return allocateAlignedOrThrow(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return allocateAlignedOrThrow(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+    deallocate(ptr);
+}
+
+#endif
+
+namespace sequoia::utils::trace {
+
+MemoryStats memory_stats() noexcept {
+#if defined(UTIL_TRACE_ENABLE) && defined(UTIL_TRACE_MEMORY)
+    return MemoryStats{
+        .allocations = allocations.load(std::memory_order_relaxed),
+        .frees = frees.load(std::memory_order_relaxed),
+        .allocated_bytes = allocated_bytes.load(std::memory_order_relaxed),
+    };
+#else
+    return {};
+#endif
+}
+
+} // namespace sequoia::utils::trace
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+
+namespace sequoia::utils::trace {
+
+/**
+ * @brief 全局 operator new/delete 的累计次数（UTIL_TRACE_MEMORY）
+ *
+ * @details 未启用 UTIL_TRACE_MEMORY 时恒为 0；计数包含所有线程，delete nullptr 不计入 frees
+ */
+struct MemoryStats {
+    uint64_t allocations{0};
+    uint64_t frees{0};
+    // 按请求大小累计，不含对齐补齐
+    uint64_t allocated_bytes{0};
+};
+
+[[nodiscard]] MemoryStats memory_stats() noexcept;
+
+} // namespace sequoia::utils::trace
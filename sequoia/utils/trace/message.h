@@ -0,0 +1,38 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string_view>
+
+namespace sequoia::utils::trace {
+
+/**
+ * @brief 时间线消息的附加接收者，与 Tracy 并行收到 Logger 转发的每条消息
+ *
+ * @details
+ * 1. text 为 "[级别] [模块] 消息"，color 为 0xRRGGBB（0 表示默认颜色），仅在回调期间有效
+ * 2. 设置后即使未连接 Tracy（或未启用 UTIL_TRACE_ENABLE）Logger 也会转发，用于测试或转发到其他系统
+ * 3. 回调可能在任意写日志的线程上并发调用
+ */
+using MessageSink = void (*)(std::string_view text, uint32_t color);
+
+namespace detail {
+
+inline std::atomic<MessageSink> message_sink{nullptr};
+
+} // namespace detail
+
+/**
+ * @brief 设置消息接收者，nullptr 表示取消
+ *
+ * @return MessageSink 之前的接收者
+ */
+inline MessageSink set_message_sink(MessageSink sink) noexcept {
+    return detail::message_sink.exchange(sink, std::memory_order_acq_rel);
+}
+
+[[nodiscard]] inline MessageSink message_sink() noexcept {
+    return detail::message_sink.load(std::memory_order_acquire);
+}
+
+} // namespace sequoia::utils::trace
@@ -0,0 +1,308 @@
+#include "perf_counter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <x86intrin.h>
+#endif
+
+namespace sequoia::utils::trace {
+
+namespace {
+
+#if defined(__linux__)
+
+constexpr std::array<uint64_t, 4> kEventConfigs = {
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_BRANCH_MISSES,
+};
+
+int openCounter(uint64_t config, int group_fd) noexcept {
+    perf_event_attr attr{};
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.disabled = group_fd < 0 ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, PERF_FLAG_FD_CLOEXEC));
+}
+
+[[nodiscard]] bool readBySyscall(int fd, uint64_t& value) noexcept {
+    return ::read(fd, &value, sizeof(value)) == static_cast<ssize_t>(sizeof(value));
+}
+
+// 按 perf_event_mmap_page 的约定以 seqlock 方式读取，事件未被调度到硬件时返回 false
+[[nodiscard]] bool readByRdpmc(const perf_event_mmap_page* page, uint64_t& value) noexcept {
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    uint32_t seq = 0;
+    do {
+        seq = page->lock;
+        std::atomic_signal_fence(std::memory_order_acq_rel);
+        const uint32_t index = page->index;
+        if (page->cap_user_rdpmc == 0 || index == 0) {
+            return false;
+        }
+        const auto width = static_cast<uint32_t>(page->pmc_width);
+        // rdpmc 返回 pmc_width 位的原始值，需要符号扩展
+        auto counter = static_cast<int64_t>(__rdpmc(static_cast<int>(index - 1)));
+        counter = static_cast<int64_t>(static_cast<uint64_t>(counter) << (64 - width)) >> (64 - width);
+        value = static_cast<uint64_t>(page->offset + counter);
+        std::atomic_signal_fence(std::memory_order_acq_rel);
+    } while (page->lock != seq);
+    return true;
+#else
+    (void)page;
+    (void)value;
+    return false;
+#endif
+}
+
+#endif
+
+} // namespace
+
+PerfCounters& PerfCounters::current() {
+    thread_local PerfCounters counters;
+    return counters;
+}
+
+PerfCounters::PerfCounters() {
+#if defined(__linux__)
+    for (size_t i = 0; i < kCounters; ++i) {
+        fds_[i] = openCounter(kEventConfigs[i], i == 0 ? -1 : fds_[0]);
+        if (fds_[i] < 0) {
+            close();
+            return;
+        }
+    }
+
+    user_read_ = true;
+    const auto page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    for (size_t i = 0; i < kCounters; ++i) {
+        void* page = ::mmap(nullptr, page_size, PROT_READ, MAP_SHARED, fds_[i], 0);
+        if (page == MAP_FAILED) {
+            user_read_ = false;
+            continue;
+        }
+        pages_[i] = page;
+        if (static_cast<const perf_event_mmap_page*>(page)->cap_user_rdpmc == 0) {
+            user_read_ = false;
+        }
+    }
+
+    ::ioctl(fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ::ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+PerfCounters::~PerfCounters() {
+    close();
+}
+
+void PerfCounters::close() noexcept {
+#if defined(__linux__)
+    const auto page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    for (size_t i = 0; i < kCounters; ++i) {
+        if (pages_[i] != nullptr) {
+            ::munmap(pages_[i], page_size);
+            pages_[i] = nullptr;
+        }
+        if (fds_[i] >= 0) {
+            ::close(fds_[i]);
+            fds_[i] = -1;
+        }
+    }
+#endif
+    user_read_ = false;
+}
+
+bool PerfCounters::read(PerfSample& sample) const noexcept {
+#if defined(__linux__)
+    if (!available()) {
+        return false;
+    }
+    std::array<uint64_t, kCounters> values{};
+    for (size_t i = 0; i < kCounters; ++i) {
+        const bool ok = (user_read_ && readByRdpmc(static_cast<const perf_event_mmap_page*>(pages_[i]), values[i])) ||
+                        readBySyscall(fds_[i], values[i]);
+        if (!ok) {
+            return false;
+        }
+    }
+    sample = PerfSample{values[0], values[1], values[2], values[3]};
+    return true;
+#else
+    (void)sample;
+    return false;
+#endif
+}
+
+// 线程退出时标记累计表，下次 snapshot 合并后释放
+struct PerfProfiler::ThreadExit {
+    std::shared_ptr<ThreadTotals> totals;
+
+    ~ThreadExit() {
+        if (totals) {
+            const std::lock_guard<std::mutex> guard(totals->mutex);
+            totals->retired = true;
+        }
+        thread_totals_ = nullptr;
+    }
+};
+
+PerfProfiler& PerfProfiler::instance() {
+    // 有意不析构：进程退出时其他线程可能仍在记录
+    static PerfProfiler* profiler = new PerfProfiler();
+    return *profiler;
+}
+
+PerfProfiler::ThreadTotals* PerfProfiler::register_thread() {
+    thread_local ThreadExit thread_exit;
+
+    auto totals = std::make_shared<ThreadTotals>();
+    {
+        const std::lock_guard<std::mutex> guard(mutex_);
+        threads_.push_back(totals);
+    }
+    thread_exit.totals = totals;
+    thread_totals_ = totals.get();
+    return thread_totals_;
+}
+
+void PerfProfiler::record(const ZoneSite* site, const PerfSample& delta) noexcept {
+    // 在析构函数中调用，异常不能逃出：注册线程或插入新 site 失败时丢弃本次样本
+    try {
+        ThreadTotals* totals = thread_totals_;
+        if (totals == nullptr) [[unlikely]] {
+            totals = register_thread();
+        }
+        const std::lock_guard<std::mutex> guard(totals->mutex);
+        ZoneTotals& zone = totals->zones[site];
+        ++zone.count;
+        zone.total += delta;
+    } catch (...) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+std::unordered_map<const ZoneSite*, PerfProfiler::ZoneTotals> PerfProfiler::merge_locked() {
+    std::unordered_map<const ZoneSite*, ZoneTotals> merged = retired_;
+    for (auto it = threads_.begin(); it != threads_.end();) {
+        // 持有一份引用，erase 时不会在加锁期间析构
+        const std::shared_ptr<ThreadTotals> totals = *it;
+        bool retired = false;
+        {
+            const std::lock_guard<std::mutex> guard(totals->mutex);
+            retired = totals->retired;
+            for (const auto& [site, zone] : totals->zones) {
+                ZoneTotals& target = merged[site];
+                target.count += zone.count;
+                target.total += zone.total;
+                if (retired) {
+                    // 已退出线程的累计值移入 retired_，不再逐次合并
+                    ZoneTotals& kept = retired_[site];
+                    kept.count += zone.count;
+                    kept.total += zone.total;
+                }
+            }
+        }
+        it = retired ? threads_.erase(it) : it + 1;
+    }
+    return merged;
+}
+
+std::vector<PerfZoneStats> PerfProfiler::snapshot() {
+    const std::lock_guard<std::mutex> guard(mutex_);
+    std::vector<PerfZoneStats> result;
+    for (const auto& [site, zone] : merge_locked()) {
+        result.push_back(PerfZoneStats{
+            .name = site->display_name(),
+            .file = site->location.file_name(),
+            .line = site->location.line(),
+            .count = zone.count,
+            .total = zone.total,
+        });
+    }
+    std::sort(result.begin(), result.end(), [](const PerfZoneStats& lhs, const PerfZoneStats& rhs) {
+        return lhs.total.cycles > rhs.total.cycles;
+    });
+    return result;
+}
+
+std::optional<PerfZoneStats> PerfProfiler::find(std::string_view name) {
+    std::optional<PerfZoneStats> result;
+    for (auto& zone : snapshot()) {
+        if (zone.name != name) {
+            continue;
+        }
+        if (!result) {
+            result = std::move(zone);
+        } else {
+            result->count += zone.count;
+            result->total += zone.total;
+        }
+    }
+    return result;
+}
+
+std::string PerfProfiler::report() {
+    const std::vector<PerfZoneStats> zones = snapshot();
+
+    std::string result;
+    std::array<char, 512> line{};
+    if (!PerfCounters::current().available()) {
+        result += "hardware counters unavailable (no PMU access: check perf_event_paranoid or virtualization)\n";
+    }
+    std::snprintf(line.data(), line.size(), "%-40s %12s %14s %14s %8s %12s %12s\n", "zone", "count", "cycles",
+                  "instructions", "IPC", "cache MPKI", "branch MPKI");
+    result += line.data();
+    for (const auto& zone : zones) {
+        std::snprintf(line.data(), line.size(), "%-40s %12llu %14llu %14llu %8.2f %12.3f %12.3f\n", zone.name.c_str(),
+                      static_cast<unsigned long long>(zone.count), static_cast<unsigned long long>(zone.total.cycles),
+                      static_cast<unsigned long long>(zone.total.instructions), zone.total.ipc(),
+                      zone.total.cache_mpki(), zone.total.branch_mpki());
+        result += line.data();
+    }
+    if (const uint64_t lost = dropped(); lost != 0) {
+        std::snprintf(line.data(), line.size(), "dropped samples: %llu\n", static_cast<unsigned long long>(lost));
+        result += line.data();
+    }
+    return result;
+}
+
+bool PerfProfiler::dump(const std::string& path) {
+    const std::string text = report();
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+    file << text;
+    return static_cast<bool>(file.flush());
+}
+
+void PerfProfiler::reset() {
+    const std::lock_guard<std::mutex> guard(mutex_);
+    (void)merge_locked();
+    retired_.clear();
+    dropped_.store(0, std::memory_order_relaxed);
+    for (const auto& totals : threads_) {
+        const std::lock_guard<std::mutex> thread_guard(totals->mutex);
+        totals->zones.clear();
+    }
+}
+
+} // namespace sequoia::utils::trace
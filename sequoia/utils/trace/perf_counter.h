@@ -0,0 +1,228 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <sequoia/utils/trace/zone.h>
+
+namespace sequoia::utils::trace {
+
+/**
+ * @brief 一组硬件计数器的读数（或两次读数之差）
+ */
+struct PerfSample {
+    uint64_t cycles{0};
+    uint64_t instructions{0};
+    uint64_t cache_misses{0};
+    uint64_t branch_misses{0};
+
+    PerfSample& operator+=(const PerfSample& other) noexcept {
+        cycles += other.cycles;
+        instructions += other.instructions;
+        cache_misses += other.cache_misses;
+        branch_misses += other.branch_misses;
+        return *this;
+    }
+
+    [[nodiscard]] friend PerfSample operator-(const PerfSample& lhs, const PerfSample& rhs) noexcept {
+        return PerfSample{lhs.cycles - rhs.cycles, lhs.instructions - rhs.instructions,
+                          lhs.cache_misses - rhs.cache_misses, lhs.branch_misses - rhs.branch_misses};
+    }
+
+    // 每周期指令数
+    [[nodiscard]] double ipc() const noexcept {
+        return cycles == 0 ? 0.0 : static_cast<double>(instructions) / static_cast<double>(cycles);
+    }
+
+    // 每千条指令的缓存未命中次数（MPKI）
+    [[nodiscard]] double cache_mpki() const noexcept {
+        return per_kilo_instructions(cache_misses);
+    }
+
+    // 每千条指令的分支预测失败次数
+    [[nodiscard]] double branch_mpki() const noexcept {
+        return per_kilo_instructions(branch_misses);
+    }
+
+private:
+    [[nodiscard]] double per_kilo_instructions(uint64_t count) const noexcept {
+        return instructions == 0 ? 0.0 : static_cast<double>(count) * 1000.0 / static_cast<double>(instructions);
+    }
+};
+
+/**
+ * @brief 当前线程的硬件计数器组（Linux perf_event_open，只统计用户态）
+ *
+ * @details
+ * 1. cycles 为组长，四个计数器同时调度，读数互相可比
+ * 2. 内核允许时（cap_user_rdpmc）通过 rdpmc 在用户态读取，否则退化为 read 系统调用
+ * 3. 非 Linux、无 PMU（如部分虚拟机）或 perf_event_paranoid 不允许时 available() 为 false
+ */
+class PerfCounters {
+public:
+    // 当前线程的计数器组，首次调用时打开
+    [[nodiscard]] static PerfCounters& current();
+
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    [[nodiscard]] bool available() const noexcept {
+        return fds_[0] >= 0;
+    }
+
+    // 是否通过 rdpmc 读取
+    [[nodiscard]] bool user_read() const noexcept {
+        return user_read_;
+    }
+
+    /**
+     * @brief 读取当前计数
+     *
+     * @return bool 计数器不可用或读取失败时返回 false，sample 不变
+     */
+    bool read(PerfSample& sample) const noexcept;
+
+private:
+    static constexpr size_t kCounters = 4;
+
+    PerfCounters();
+
+    void close() noexcept;
+
+private:
+    std::array<int, kCounters> fds_{-1, -1, -1, -1};
+    std::array<void*, kCounters> pages_{};
+    bool user_read_{false};
+};
+
+/**
+ * @brief 单个 zone 的硬件计数器统计（各项为所有调用的累计值）
+ */
+struct PerfZoneStats {
+    std::string name;
+    std::string file;
+    uint32_t line{0};
+    uint64_t count{0};
+    PerfSample total;
+};
+
+/**
+ * @brief 按 zone 累计硬件计数器（T_SCOPED_PERF，需开启 UTIL_TRACE_PERF）
+ *
+ * @details
+ * 1. 每个线程累计到自己的表中（只有本线程与 snapshot 竞争，锁几乎无争用），snapshot 时合并
+ * 2. 每个 zone 进出各读一次计数器组，开销为数百周期，适合毫秒级以下但非纳秒级的热点
+ * 3. 计数器不可用时 zone 不记录，report 中注明原因
+ *
+ * @code
+ * void parse_batch() {
+ *     T_SCOPED_PERF("parse_batch");
+ *     ...
+ * }
+ * logger->info("{}", PerfProfiler::instance().report());  // IPC、缓存 / 分支 MPKI
+ * @endcode
+ */
+class PerfProfiler {
+public:
+    [[nodiscard]] static PerfProfiler& instance();
+
+    PerfProfiler(const PerfProfiler&) = delete;
+    PerfProfiler& operator=(const PerfProfiler&) = delete;
+
+    /**
+     * @brief 累计一次 zone 的计数器增量（ScopedPerfZone 在析构时调用）
+     *
+     * @details 线程首次记录或首次遇到 site 时需要分配，分配失败时丢弃样本并计入 dropped，不抛异常
+     */
+    void record(const ZoneSite* site, const PerfSample& delta) noexcept;
+
+    // 按 cycles 降序
+    [[nodiscard]] std::vector<PerfZoneStats> snapshot();
+
+    // 同名的多个调用点合并统计，未记录过时返回 std::nullopt
+    [[nodiscard]] std::optional<PerfZoneStats> find(std::string_view name);
+
+    [[nodiscard]] std::string report();
+
+    /**
+     * @brief 将报表写入文件
+     *
+     * @return bool 文件无法打开或写入失败时返回 false
+     */
+    bool dump(const std::string& path);
+
+    // 因分配失败被丢弃的样本总数
+    [[nodiscard]] uint64_t dropped() const noexcept {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+    void reset();
+
+private:
+    struct ZoneTotals {
+        uint64_t count{0};
+        PerfSample total;
+    };
+
+    struct ThreadTotals {
+        std::mutex mutex;
+        std::unordered_map<const ZoneSite*, ZoneTotals> zones;
+        bool retired{false};
+    };
+
+    struct ThreadExit;
+
+    PerfProfiler() = default;
+
+    ThreadTotals* register_thread();
+    // 合并各线程累计值，调用方持有 mutex_
+    [[nodiscard]] std::unordered_map<const ZoneSite*, ZoneTotals> merge_locked();
+
+private:
+    static inline thread_local ThreadTotals* thread_totals_{nullptr};
+
+    std::mutex mutex_;
+    std::vector<std::shared_ptr<ThreadTotals>> threads_;
+    // 已退出线程的累计值
+    std::unordered_map<const ZoneSite*, ZoneTotals> retired_;
+    std::atomic<uint64_t> dropped_{0};
+};
+
+/**
+ * @brief 作用域硬件计数：构造与析构时各读一次计数器组
+ */
+class ScopedPerfZone {
+public:
+    explicit ScopedPerfZone(const ZoneSite* site) noexcept
+        : site_(site), counters_(PerfCounters::current()) {
+        active_ = counters_.read(start_);
+    }
+
+    ~ScopedPerfZone() noexcept {
+        PerfSample end;
+        if (active_ && counters_.read(end)) {
+            PerfProfiler::instance().record(site_, end - start_);
+        }
+    }
+
+    ScopedPerfZone(const ScopedPerfZone&) = delete;
+    ScopedPerfZone& operator=(const ScopedPerfZone&) = delete;
+
+private:
+    const ZoneSite* site_;
+    const PerfCounters& counters_;
+    PerfSample start_;
+    bool active_{false};
+};
+
+} // namespace sequoia::utils::trace
@@ -0,0 +1,192 @@
+#include "profiler.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <fstream>
+
+namespace sequoia::utils::trace {
+
+namespace {
+
+// 单个 zone 的直方图：不限上界（按 TSC 周期记录），2 位有效数字
+[[nodiscard]] std::unique_ptr<LatencyHistogram> makeHistogram() {
+    return std::make_unique<LatencyHistogram>(UINT64_MAX, 2);
+}
+
+} // namespace
+
+// 线程退出时标记缓冲，下次 collect 汇总剩余样本后释放
+struct Profiler::ThreadExit {
+    std::shared_ptr<detail::ThreadBuffer> buffer;
+
+    ~ThreadExit() {
+        if (buffer) {
+            buffer->retire();
+        }
+        thread_buffer_ = nullptr;
+    }
+};
+
+Profiler& Profiler::instance() {
+    // 有意不析构：进程退出时其他线程可能仍在记录
+    static Profiler* profiler = new Profiler();
+    return *profiler;
+}
+
+detail::ThreadBuffer* Profiler::register_thread() noexcept {
+    // 在 zone 的析构中调用，缓冲（约 200KB）分配失败时丢弃本次样本而不是终止进程
+    try {
+        thread_local ThreadExit thread_exit;
+
+        std::shared_ptr<detail::ThreadBuffer> buffer;
+        {
+            const std::lock_guard<std::mutex> guard(mutex_);
+            buffer = std::make_shared<detail::ThreadBuffer>(next_thread_id_++);
+            buffers_.push_back(buffer);
+        }
+        thread_exit.buffer = buffer;
+        thread_buffer_ = buffer.get();
+        return thread_buffer_;
+    } catch (...) {
+        unregistered_dropped_.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+}
+
+size_t Profiler::collect() {
+    const std::lock_guard<std::mutex> guard(mutex_);
+    return collect_locked();
+}
+
+size_t Profiler::collect_locked() {
+    size_t collected = 0;
+    const ZoneSite* last_site = nullptr;
+    LatencyHistogram* last_histogram = nullptr;
+    for (auto it = buffers_.begin(); it != buffers_.end();) {
+        const auto& buffer = *it;
+        // 先读 retired：为 true 时线程已不再写入，本次 drain 即可取完，之后释放缓冲
+        const bool retired = buffer->retired();
+        collected += buffer->drain([&](const detail::ZoneSample& sample) {
+            if (sample.site != last_site) {
+                auto& histogram = zones_[sample.site];
+                if (!histogram) {
+                    histogram = makeHistogram();
+                }
+                last_site = sample.site;
+                last_histogram = histogram.get();
+            }
+            (void)last_histogram->record(sample.end - sample.start);
+        });
+        dropped_ += buffer->take_dropped();
+        it = retired ? buffers_.erase(it) : it + 1;
+    }
+    return collected;
+}
+
+ZoneStats Profiler::make_stats(const ZoneSite* site, const LatencyHistogram& histogram, double ns_per_tick) {
+    const auto to_ns = [ns_per_tick](uint64_t ticks) {
+        return static_cast<uint64_t>(static_cast<double>(ticks) * ns_per_tick + 0.5);
+    };
+    return ZoneStats{
+        .name = site->display_name(),
+        .file = site->location.file_name(),
+        .line = site->location.line(),
+        .count = histogram.count(),
+        .total_ns = to_ns(histogram.total()),
+        .min_ns = to_ns(histogram.min()),
+        .max_ns = to_ns(histogram.max()),
+        .p50_ns = to_ns(histogram.percentile(0.50)),
+        .p90_ns = to_ns(histogram.percentile(0.90)),
+        .p99_ns = to_ns(histogram.percentile(0.99)),
+    };
+}
+
+std::vector<ZoneStats> Profiler::snapshot() {
+    // 进程启动后 1ms 内首次换算会等待，须在加锁之前完成
+    const double ns_per_tick = 1.0 / ticks_per_ns();
+    const std::lock_guard<std::mutex> guard(mutex_);
+    collect_locked();
+
+    std::vector<ZoneStats> result;
+    result.reserve(zones_.size());
+    for (const auto& [site, histogram] : zones_) {
+        result.push_back(make_stats(site, *histogram, ns_per_tick));
+    }
+    std::sort(result.begin(), result.end(),
+              [](const ZoneStats& lhs, const ZoneStats& rhs) { return lhs.total_ns > rhs.total_ns; });
+    return result;
+}
+
+std::optional<ZoneStats> Profiler::find(std::string_view name) {
+    const double ns_per_tick = 1.0 / ticks_per_ns();
+    const std::lock_guard<std::mutex> guard(mutex_);
+    collect_locked();
+
+    const ZoneSite* first_site = nullptr;
+    const auto merged = makeHistogram();
+    for (const auto& [site, histogram] : zones_) {
+        if (name != site->display_name()) {
+            continue;
+        }
+        if (first_site == nullptr) {
+            first_site = site;
+        }
+        merged->merge(*histogram);
+    }
+    if (first_site == nullptr) {
+        return std::nullopt;
+    }
+    return make_stats(first_site, *merged, ns_per_tick);
+}
+
+std::string Profiler::report() {
+    const std::vector<ZoneStats> zones = snapshot();
+
+    std::string result;
+    std::array<char, 512> line{};
+    std::snprintf(line.data(), line.size(), "%-40s %12s %14s %10s %10s %10s %10s %10s\n", "zone", "count",
+                  "total(ns)", "mean(ns)", "p50(ns)", "p90(ns)", "p99(ns)", "max(ns)");
+    result += line.data();
+    for (const auto& zone : zones) {
+        std::snprintf(line.data(), line.size(), "%-40s %12llu %14llu %10.0f %10llu %10llu %10llu %10llu\n",
+                      zone.name.c_str(), static_cast<unsigned long long>(zone.count),
+                      static_cast<unsigned long long>(zone.total_ns), zone.mean_ns(),
+                      static_cast<unsigned long long>(zone.p50_ns), static_cast<unsigned long long>(zone.p90_ns),
+                      static_cast<unsigned long long>(zone.p99_ns), static_cast<unsigned long long>(zone.max_ns));
+        result += line.data();
+    }
+    if (const uint64_t lost = dropped(); lost != 0) {
+        std::snprintf(line.data(), line.size(), "dropped samples: %llu\n", static_cast<unsigned long long>(lost));
+        result += line.data();
+    }
+    return result;
+}
+
+bool Profiler::dump(const std::string& path) {
+    const std::string text = report();
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+    file << text;
+    return static_cast<bool>(file.flush());
+}
+
+uint64_t Profiler::dropped() {
+    const std::lock_guard<std::mutex> guard(mutex_);
+    for (const auto& buffer : buffers_) {
+        dropped_ += buffer->take_dropped();
+    }
+    return dropped_ + unregistered_dropped_.load(std::memory_order_relaxed);
+}
+
+void Profiler::reset() {
+    const std::lock_guard<std::mutex> guard(mutex_);
+    collect_locked();
+    zones_.clear();
+    dropped_ = 0;
+    unregistered_dropped_.store(0, std::memory_order_relaxed);
+}
+
+} // namespace sequoia::utils::trace
@@ -0,0 +1,238 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <sequoia/utils/latency_histogram.h>
+#include <sequoia/utils/trace/zone.h>
+
+namespace sequoia::utils::trace {
+
+/**
+ * @brief 单个 zone 的耗时统计
+ */
+struct ZoneStats {
+    std::string name;
+    std::string file;
+    uint32_t line{0};
+    uint64_t count{0};
+    uint64_t total_ns{0};
+    uint64_t min_ns{0};
+    uint64_t max_ns{0};
+    uint64_t p50_ns{0};
+    uint64_t p90_ns{0};
+    uint64_t p99_ns{0};
+
+    [[nodiscard]] double mean_ns() const noexcept {
+        return count == 0 ? 0.0 : static_cast<double>(total_ns) / static_cast<double>(count);
+    }
+};
+
+namespace detail {
+
+struct ZoneSample {
+    const ZoneSite* site;
+    uint64_t start;
+    uint64_t end;
+};
+
+/**
+ * @brief 线程私有的单生产者 / 单消费者环形缓冲
+ *
+ * @details 生产者为所属线程（无锁、无分配），消费者为 Profiler::collect（持有采集锁）；满时丢弃并计数
+ */
+class ThreadBuffer {
+public:
+    static constexpr size_t kCapacity = 8192;
+
+    explicit ThreadBuffer(uint32_t thread_id) noexcept : thread_id_(thread_id) {}
+
+    void push(const ZoneSite* site, uint64_t start, uint64_t end) noexcept {
+        const uint64_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) == kCapacity) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        samples_[head % kCapacity] = ZoneSample{site, start, end};
+        head_.store(head + 1, std::memory_order_release);
+    }
+
+    // 逐个交给 consumer 后释放槽位，只能由持有采集锁的线程调用
+    template <typename Consumer>
+    size_t drain(Consumer&& consumer) {
+        const uint64_t tail = tail_.load(std::memory_order_relaxed);
+        const uint64_t head = head_.load(std::memory_order_acquire);
+        for (uint64_t i = tail; i != head; ++i) {
+            consumer(samples_[i % kCapacity]);
+        }
+        tail_.store(head, std::memory_order_release);
+        return static_cast<size_t>(head - tail);
+    }
+
+    [[nodiscard]] uint64_t take_dropped() noexcept {
+        return dropped_.exchange(0, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] uint32_t thread_id() const noexcept {
+        return thread_id_;
+    }
+
+    void retire() noexcept {
+        retired_.store(true, std::memory_order_release);
+    }
+
+    [[nodiscard]] bool retired() const noexcept {
+        return retired_.load(std::memory_order_acquire);
+    }
+
+private:
+    alignas(64) std::atomic<uint64_t> head_{0};
+    alignas(64) std::atomic<uint64_t> tail_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<bool> retired_{false};
+    uint32_t thread_id_;
+    ZoneSample samples_[kCapacity];
+};
+
+} // namespace detail
+
+/**
+ * @brief 进程内采样式性能分析器（不依赖 Tracy 服务端）
+ *
+ * @details
+ * 1. 开启 UTIL_TRACE_PROFILER 后，T_SCOPED / T_SCOPED_NAME 在作用域进出时读取 TSC，
+ *    结束时写入本线程的环形缓冲：热路径无锁、无分配，只有线程首次记录时注册一次缓冲
+ * 2. collect 将各线程缓冲汇总为每个 zone 的 LatencyHistogram（相对误差小于 1%），
+ *    snapshot / report / dump 会先 collect；长时间运行时应定期 collect，缓冲满时新样本被丢弃并计入 dropped
+ * 3. 纳秒换算见 trace::ticks_per_ns
+ *
+ * @code
+ * void on_order() {
+ *     T_SCOPED_NAME("on_order");
+ *     ...
+ * }
+ * for (const auto& zone : Profiler::instance().snapshot()) {
+ *     logger->info("{} count={} p99={}ns", zone.name, zone.count, zone.p99_ns);
+ * }
+ * Profiler::instance().dump("/tmp/profile.txt");
+ * @endcode
+ */
+class Profiler {
+public:
+    [[nodiscard]] static Profiler& instance();
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    [[nodiscard]] static bool enabled() noexcept {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    // 运行时开关，关闭后新进入的 zone 不再记录
+    static void set_enabled(bool enabled) noexcept {
+        enabled_.store(enabled, std::memory_order_relaxed);
+    }
+
+    // 记录一个已结束的 zone（ScopedZone 使用，也可用于手动计时）
+    static void record(const ZoneSite* site, uint64_t start_ticks, uint64_t end_ticks) noexcept {
+        detail::ThreadBuffer* buffer = thread_buffer_;
+        if (buffer == nullptr) [[unlikely]] {
+            buffer = instance().register_thread();
+            if (buffer == nullptr) {
+                return;
+            }
+        }
+        buffer->push(site, start_ticks, end_ticks);
+    }
+
+    /**
+     * @brief 汇总各线程缓冲中的样本
+     *
+     * @return size_t 本次汇总的样本数
+     */
+    size_t collect();
+
+    /**
+     * @brief 按总耗时降序返回每个 zone 的统计
+     */
+    [[nodiscard]] std::vector<ZoneStats> snapshot();
+
+    /**
+     * @brief 查询名称为 name 的 zone，同名的多个调用点合并统计
+     *
+     * @return std::optional<ZoneStats> 未记录过时返回 std::nullopt
+     */
+    [[nodiscard]] std::optional<ZoneStats> find(std::string_view name);
+
+    // 文本报表（每个 zone 一行）
+    [[nodiscard]] std::string report();
+
+    /**
+     * @brief 将报表写入文件
+     *
+     * @return bool 文件无法打开或写入失败时返回 false
+     */
+    bool dump(const std::string& path);
+
+    // 因缓冲满（或线程缓冲分配失败）被丢弃的样本总数
+    [[nodiscard]] uint64_t dropped();
+
+    // 清空已汇总的统计（各线程缓冲中尚未汇总的样本一并丢弃）
+    void reset();
+
+private:
+    struct ThreadExit;
+
+    Profiler() = default;
+
+    // 分配失败时返回 nullptr 并计入 dropped，下次记录时重试
+    detail::ThreadBuffer* register_thread() noexcept;
+    size_t collect_locked();
+    // ns_per_tick 由调用方在加锁前换算好
+    [[nodiscard]] static ZoneStats make_stats(const ZoneSite* site, const LatencyHistogram& histogram,
+                                              double ns_per_tick);
+
+private:
+    static inline std::atomic<bool> enabled_{true};
+    static inline thread_local detail::ThreadBuffer* thread_buffer_{nullptr};
+
+    std::mutex mutex_;
+    uint32_t next_thread_id_{0};
+    std::vector<std::shared_ptr<detail::ThreadBuffer>> buffers_;
+    std::unordered_map<const ZoneSite*, std::unique_ptr<LatencyHistogram>> zones_;
+    uint64_t dropped_{0};
+    // 线程缓冲注册失败时丢弃的样本，不持锁累加
+    std::atomic<uint64_t> unregistered_dropped_{0};
+};
+
+/**
+ * @brief 作用域计时：构造时读 TSC，析构时记录到 Profiler
+ */
+class ScopedZone {
+public:
+    // active 为 false 时不计时（用于按类别开关的 zone）
+    explicit ScopedZone(const ZoneSite* site, bool active = true) noexcept
+        : site_(active && Profiler::enabled() ? site : nullptr), start_(site_ ? detail::read_ticks() : 0) {}
+
+    ~ScopedZone() {
+        if (site_ != nullptr) {
+            Profiler::record(site_, start_, detail::read_ticks());
+        }
+    }
+
+    ScopedZone(const ScopedZone&) = delete;
+    ScopedZone& operator=(const ScopedZone&) = delete;
+
+private:
+    const ZoneSite* site_;
+    uint64_t start_;
+};
+
+} // namespace sequoia::utils::trace
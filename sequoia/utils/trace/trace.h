@@ -1,27 +1,165 @@
 #pragma once
 
+#define T_CONCAT_IMPL_(__A__, __B__) __A__##__B__
+#define T_CONCAT_(__A__, __B__) T_CONCAT_IMPL_(__A__, __B__)
+
+// 进程内后端，均可与 Tracy 共存：
+//   UTIL_TRACE_PROFILER  T_SCOPED* 汇总为每个 zone 的耗时直方图（trace::Profiler）
+//   UTIL_TRACE_CHROME    T_SCOPED* / T_FRAME_MARK* 记录为 Chrome trace-event JSON，T_SHUTDOWN 时导出（trace::ChromeTrace）
+//   UTIL_TRACE_PERF      T_SCOPED_PERF 按 zone 累计硬件计数器（trace::PerfProfiler）
+#ifdef UTIL_TRACE_PROFILER
+#include <sequoia/utils/trace/profiler.h>
+#define T_PROFILER_SCOPE_(__SITE__, __ACTIVE__) \
+    ; const ::sequoia::utils::trace::ScopedZone T_CONCAT_(t_zone_, __LINE__)(&__SITE__, __ACTIVE__)
+#else
+#define T_PROFILER_SCOPE_(__SITE__, __ACTIVE__)
+#endif
+
+#ifdef UTIL_TRACE_CHROME
+#include <sequoia/utils/trace/chrome_trace.h>
+#define T_CHROME_SCOPE_(__SITE__, __ACTIVE__) \
+    ; const ::sequoia::utils::trace::ChromeScopedZone T_CONCAT_(t_chrome_zone_, __LINE__)(&__SITE__, __ACTIVE__)
+#define T_CHROME_FRAME_(__NAME__)                                                                           \
+    static constexpr ::sequoia::utils::trace::ZoneSite T_CONCAT_(t_frame_site_, __LINE__){                 \
+        __NAME__, std::source_location::current()};                                                         \
+    ::sequoia::utils::trace::ChromeTrace::mark(&T_CONCAT_(t_frame_site_, __LINE__))
+#define T_CHROME_SHUTDOWN_ (void)::sequoia::utils::trace::ChromeTrace::instance().shutdown()
+#else
+#define T_CHROME_SCOPE_(__SITE__, __ACTIVE__)
+#define T_CHROME_FRAME_(__NAME__)
+#define T_CHROME_SHUTDOWN_ (void)0
+#endif
+
+// 硬件计数器 zone（UTIL_TRACE_PERF，仅 Linux）：T_SCOPED_PERF 统计 cycles / instructions / 缓存与分支未命中
+#ifdef UTIL_TRACE_PERF
+#include <source_location>
+#include <sequoia/utils/trace/perf_counter.h>
+#define T_SCOPED_PERF(__NAME__)                                                                             \
+    static constexpr ::sequoia::utils::trace::ZoneSite T_CONCAT_(t_perf_site_, __LINE__){                  \
+        __NAME__, std::source_location::current()};                                                         \
+    const ::sequoia::utils::trace::ScopedPerfZone T_CONCAT_(t_perf_zone_, __LINE__)(&T_CONCAT_(t_perf_site_, __LINE__))
+#else
+#define T_SCOPED_PERF(__NAME__)
+#endif
+
+#if defined(UTIL_TRACE_PROFILER) || defined(UTIL_TRACE_CHROME)
+#include <source_location>
+#define T_LOCAL_ZONE_ACTIVE_(__NAME__, __ACTIVE__)                                                          \
+    static constexpr ::sequoia::utils::trace::ZoneSite T_CONCAT_(t_zone_site_, __LINE__){                  \
+        __NAME__, std::source_location::current()}                                                          \
+    T_PROFILER_SCOPE_(T_CONCAT_(t_zone_site_, __LINE__), __ACTIVE__)                                        \
+    T_CHROME_SCOPE_(T_CONCAT_(t_zone_site_, __LINE__), __ACTIVE__)
+#else
+#define T_LOCAL_ZONE_ACTIVE_(__NAME__, __ACTIVE__)
+#endif
+#define T_LOCAL_ZONE_(__NAME__) T_LOCAL_ZONE_ACTIVE_(__NAME__, true)
+
+// 按类别开关：类别位在调用点首次执行时注册，之后每次只读一次全局掩码（见 trace/category.h）
+#if defined(UTIL_TRACE_ENABLE) || defined(UTIL_TRACE_PROFILER) || defined(UTIL_TRACE_CHROME)
+#include <sequoia/utils/trace/category.h>
+#define T_CATEGORY_ACTIVE_(__CATEGORY__)                                                                    \
+    static const uint64_t T_CONCAT_(t_category_bit_, __LINE__) =                                            \
+        ::sequoia::utils::trace::category_bit(__CATEGORY__);                                                \
+    const bool T_CONCAT_(t_category_active_, __LINE__) =                                                    \
+        ::sequoia::utils::trace::category_enabled(T_CONCAT_(t_category_bit_, __LINE__))
+#define T_CATEGORY_ENABLED(__CATEGORY__)                                                                    \
+    ([]() noexcept {                                                                                        \
+        static const uint64_t bit = ::sequoia::utils::trace::category_bit(__CATEGORY__);                   \
+        return ::sequoia::utils::trace::category_enabled(bit);                                              \
+    }())
+#else
+#define T_CATEGORY_ENABLED(__CATEGORY__) false
+#endif
+
 #ifdef UTIL_TRACE_ENABLE
 
 #include "Tracy.hpp"
 
 #define T_STARTUP tracy::StartupProfiler()
-#define T_SHUTDOWN tracy::ShutdownProfiler()
+#define T_SHUTDOWN (tracy::ShutdownProfiler(), T_CHROME_SHUTDOWN_)
+
+// 是否已连接 Tracy 服务端（未连接时可跳过昂贵的注解，如格式化消息）
+#define T_IS_CONNECTED TracyIsConnected
+
+#define T_SCOPED ZoneScoped; T_LOCAL_ZONE_(nullptr)
+#define T_SCOPED_NAME(__NAME__) ZoneScopedN(__NAME__); T_LOCAL_ZONE_(__NAME__)
+// 只在类别 __CATEGORY__ 启用时记录，如 T_SCOPED_CAT("db", "load_orders")
+#define T_SCOPED_CAT(__CATEGORY__, __NAME__)                                                                \
+    T_CATEGORY_ACTIVE_(__CATEGORY__);                                                                       \
+    ZoneNamedN(T_CONCAT_(t_tracy_zone_, __LINE__), __NAME__, T_CONCAT_(t_category_active_, __LINE__));     \
+    T_LOCAL_ZONE_ACTIVE_(__NAME__, T_CONCAT_(t_category_active_, __LINE__))
+
+// 当前作用域 zone 的附加文本 / 数值（须在 T_SCOPED* 之后使用）
+#define T_ZONE_TEXT(__TEXT__, __SIZE__) ZoneText(__TEXT__, __SIZE__)
+#define T_ZONE_VALUE(__VALUE__) ZoneValue(__VALUE__)
 
-#define T_SCOPED ZoneScoped
-#define T_SCOPED_NAME(__NAME__) ZoneScopedN(__NAME__)
+#define T_FRAME_MARK FrameMark; T_CHROME_FRAME_("frame")
+#define T_FRAME_MARK_NAME(__NAME__) FrameMarkNamed(__NAME__); T_CHROME_FRAME_(__NAME__)
 
-#define T_FRAME_MARK FrameMark
-#define T_FRAME_MARK_NAME(__NAME__) FrameMarkNamed(__NAME__)
+// 时间线上的消息：__TEXT__ 无需以 '\0' 结尾；_L 版本只接受字符串字面量（不拷贝）
+#define T_MESSAGE(__TEXT__, __SIZE__) TracyMessage(__TEXT__, __SIZE__)
+#define T_MESSAGE_COLOR(__TEXT__, __SIZE__, __COLOR__) TracyMessageC(__TEXT__, __SIZE__, __COLOR__)
+#define T_MESSAGE_L(__LITERAL__) TracyMessageL(__LITERAL__)
+
+// 数值曲线（如队列长度、缓存命中数），__NAME__ 须为字符串字面量
+#define T_PLOT(__NAME__, __VALUE__) TracyPlot(__NAME__, __VALUE__)
+#define T_PLOT_CONFIG(...) TracyPlotConfig(__VA_ARGS__)
+
+// 内存分配事件；全局 operator new/delete 的自动上报见 UTIL_TRACE_MEMORY（trace/memory.cc）
+#define T_ALLOC(__PTR__, __SIZE__) TracyAlloc(__PTR__, __SIZE__)
+#define T_FREE(__PTR__) TracyFree(__PTR__)
+#define T_ALLOC_NAME(__PTR__, __SIZE__, __NAME__) TracyAllocN(__PTR__, __SIZE__, __NAME__)
+#define T_FREE_NAME(__PTR__, __NAME__) TracyFreeN(__PTR__, __NAME__)
+
+// 可在时间线上观察等待与持有的互斥量：
+//   T_LOCKABLE(std::mutex, mutex_);
+//   std::lock_guard<T_LOCKABLE_BASE(std::mutex)> guard(mutex_);
+#define T_LOCKABLE(__TYPE__, __VAR__) TracyLockable(__TYPE__, __VAR__)
+#define T_LOCKABLE_NAME(__TYPE__, __VAR__, __NAME__) TracyLockableN(__TYPE__, __VAR__, __NAME__)
+#define T_SHARED_LOCKABLE(__TYPE__, __VAR__) TracySharedLockable(__TYPE__, __VAR__)
+#define T_LOCKABLE_BASE(__TYPE__) LockableBase(__TYPE__)
+#define T_SHARED_LOCKABLE_BASE(__TYPE__) SharedLockableBase(__TYPE__)
+#define T_LOCK_MARK(__VAR__) LockMark(__VAR__)
 
 #else
 
 #define T_STARTUP
-#define T_SHUTDOWN
+#define T_SHUTDOWN T_CHROME_SHUTDOWN_
+
+#define T_IS_CONNECTED false
+
+#define T_SCOPED T_LOCAL_ZONE_(nullptr)
+#define T_SCOPED_NAME(__NAME__) T_LOCAL_ZONE_(__NAME__)
+#if defined(UTIL_TRACE_PROFILER) || defined(UTIL_TRACE_CHROME)
+#define T_SCOPED_CAT(__CATEGORY__, __NAME__) \
+    T_CATEGORY_ACTIVE_(__CATEGORY__); T_LOCAL_ZONE_ACTIVE_(__NAME__, T_CONCAT_(t_category_active_, __LINE__))
+#else
+#define T_SCOPED_CAT(__CATEGORY__, __NAME__)
+#endif
+
+#define T_ZONE_TEXT(__TEXT__, __SIZE__)
+#define T_ZONE_VALUE(__VALUE__)
+
+#define T_FRAME_MARK T_CHROME_FRAME_("frame")
+#define T_FRAME_MARK_NAME(__NAME__) T_CHROME_FRAME_(__NAME__)
+
+#define T_MESSAGE(__TEXT__, __SIZE__)
+#define T_MESSAGE_COLOR(__TEXT__, __SIZE__, __COLOR__)
+#define T_MESSAGE_L(__LITERAL__)
+
+#define T_PLOT(__NAME__, __VALUE__)
+#define T_PLOT_CONFIG(...)
 
-#define T_SCOPED
-#define T_SCOPED_NAME(__NAME__)
+#define T_ALLOC(__PTR__, __SIZE__)
+#define T_FREE(__PTR__)
+#define T_ALLOC_NAME(__PTR__, __SIZE__, __NAME__)
+#define T_FREE_NAME(__PTR__, __NAME__)
 
-#define T_FRAME_MARK
-#define T_FRAME_MARK_NAME(__NAME__)
+#define T_LOCKABLE(__TYPE__, __VAR__) __TYPE__ __VAR__
+#define T_LOCKABLE_NAME(__TYPE__, __VAR__, __NAME__) __TYPE__ __VAR__
+#define T_SHARED_LOCKABLE(__TYPE__, __VAR__) __TYPE__ __VAR__
+#define T_LOCKABLE_BASE(__TYPE__) __TYPE__
+#define T_SHARED_LOCKABLE_BASE(__TYPE__) __TYPE__
+#define T_LOCK_MARK(__VAR__)
 
 #endif
@@ -0,0 +1,44 @@
+#include "zone.h"
+
+#include <chrono>
+#include <thread>
+
+namespace sequoia::utils::trace {
+
+namespace {
+
+[[nodiscard]] int64_t steadyNanoseconds() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+struct ClockOrigin {
+    uint64_t ticks{detail::read_ticks()};
+    int64_t ns{steadyNanoseconds()};
+};
+
+// 静态初始化阶段取零点，早于 main 中的任何 zone
+const ClockOrigin kOrigin;
+
+} // namespace
+
+double ticks_per_ns() noexcept {
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    int64_t elapsed_ns = steadyNanoseconds() - kOrigin.ns;
+    if (elapsed_ns < 1'000'000) {
+        std::this_thread::sleep_for(std::chrono::nanoseconds(1'000'000 - elapsed_ns));
+        elapsed_ns = steadyNanoseconds() - kOrigin.ns;
+    }
+    const uint64_t elapsed_ticks = detail::read_ticks() - kOrigin.ticks;
+    return static_cast<double>(elapsed_ticks) / static_cast<double>(elapsed_ns);
+#else
+    return 1.0;
+#endif
+}
+
+uint64_t origin_ticks() noexcept {
+    return kOrigin.ticks;
+}
+
+} // namespace sequoia::utils::trace
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <source_location>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+namespace sequoia::utils::trace {
+
+/**
+ * @brief zone 的静态描述（每个 T_SCOPED* 调用点一个，编译期构造）
+ */
+struct ZoneSite {
+    // 为空时使用函数名
+    const char* name;
+    std::source_location location;
+
+    [[nodiscard]] const char* display_name() const noexcept {
+        return name != nullptr ? name : location.function_name();
+    }
+};
+
+namespace detail {
+
+// x86-64 读取 TSC，其余平台退化为 steady_clock 纳秒
+[[nodiscard]] inline uint64_t read_ticks() noexcept {
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+} // namespace detail
+
+/**
+ * @brief read_ticks 计数与纳秒的换算比例
+ *
+ * @details 按进程启动以来的 TSC 与 steady_clock 增量换算，进程运行越久越准确；启动后 1ms 内调用会先等待
+ */
+[[nodiscard]] double ticks_per_ns() noexcept;
+
+// 进程启动时的 read_ticks 值，导出时间戳以此为零点
+[[nodiscard]] uint64_t origin_ticks() noexcept;
+
+} // namespace sequoia::utils::trace
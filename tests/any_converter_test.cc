@@ -0,0 +1,148 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <doctest/doctest.h>
+#include <sequoia/utils/any_converter.h>
+#include <sequoia/utils/params.h>
+#include <any>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace sequoia::utils;
+
+namespace {
+
+struct Price {
+    int64_t ticks{0};
+
+    static Price from_string(const std::string& str) {
+        if (str.empty() || str.front() != '$') {
+            throw std::invalid_argument("price must start with '$'");
+        }
+        return Price{std::stoll(str.substr(1))};
+    }
+
+    std::string to_string() const {
+        return "$" + std::to_string(ticks);
+    }
+};
+
+struct Unregistered {};
+
+} // namespace
+
+TEST_CASE("ConverterRegistry - 内置类型") {
+    const auto& registry = ConverterRegistry::instance();
+
+    SUBCASE("按运行时类型转换为文本") {
+        CHECK(registry.to_string(std::any(42)) == "42");
+        CHECK(registry.to_string(std::any(int64_t{-7})) == "-7");
+        CHECK(registry.to_string(std::any(3.14)) == "3.14");
+        CHECK(registry.to_string(std::any(uint8_t{255})) == "255");
+        CHECK(registry.to_string(std::any(std::string("text"))) == "text");
+        CHECK(registry.to_string(std::any(std::vector<int64_t>{1, 2})) == "[1, 2]");
+    }
+
+    SUBCASE("解析文本") {
+        CHECK(std::any_cast<double>(registry.from_string(typeid(double), "2.5")) == 2.5);
+        CHECK(std::any_cast<int>(registry.from_string(typeid(int), "-3")) == -3);
+        CHECK(std::any_cast<std::vector<double>>(registry.from_string(typeid(std::vector<double>), "[0.5, 1]")) ==
+              std::vector<double>{0.5, 1.0});
+    }
+
+    SUBCASE("未注册类型与非法输入不抛异常") {
+        CHECK(registry.find<Unregistered>() == nullptr);
+        CHECK_FALSE(registry.to_string(std::any(Unregistered{})).has_value());
+        CHECK_FALSE(registry.to_string(std::any()).has_value());
+        CHECK_FALSE(registry.from_string(typeid(Unregistered), "x").has_value());
+        CHECK_FALSE(registry.from_string(typeid(int), "abc").has_value());
+    }
+
+    SUBCASE("与 Params 共用类型表") {
+        CHECK(registry.find<int64_t>()->name == "int64");
+        CHECK(registry.find<std::vector<double>>()->name == "double[]");
+        CHECK(registry.find<Params>() == detail::find_param_converter(typeid(Params)));
+        CHECK(registry.find<float>() != nullptr);
+        CHECK(detail::find_param_converter(typeid(float)) == nullptr);
+
+        CHECK(Params::support(std::any(1.5)));
+        CHECK_FALSE(Params::support(std::any(1.5f)));
+        Params params;
+        set_any(params, "n", std::any(int64_t{9}));
+        CHECK(params.type("n") == "int64");
+        CHECK_THROWS_AS(set_any(params, "f", std::any(1.5f)), std::invalid_argument);
+    }
+}
+
+TEST_CASE("ConverterRegistry - 自定义类型") {
+    auto& registry = ConverterRegistry::instance();
+    CHECK(registry.register_type<Price>("price"));
+
+    CHECK(registry.find<Price>()->name == "price");
+    CHECK(registry.register_type<Price>("price"));
+    CHECK(registry.find<Price>()->name == "price");
+
+    // Params 支持的类型不可覆盖，Params 仍然接受 double
+    CHECK_FALSE(registry.register_type<double>("d"));
+    CHECK(registry.find<double>()->name == "double");
+    CHECK(registry.find<double>() == detail::find_param_converter(typeid(double)));
+    CHECK(Params::support(std::any(1.5)));
+    CHECK(registry.to_string(std::any(Price{125})) == "$125");
+    CHECK(std::any_cast<Price>(registry.from_string(typeid(Price), "$99")).ticks == 99);
+    // from_string 抛出的异常被转换为空值
+    CHECK_FALSE(registry.from_string(typeid(Price), "99").has_value());
+}
+
+TEST_CASE("ConverterRegistry - 并发注册与查找") {
+    auto& registry = ConverterRegistry::instance();
+    std::atomic<bool> stop{false};
+    std::thread writer([&] {
+        for (int i = 0; i < 1000; ++i) {
+            registry.register_type<Price>(i % 2 == 0 ? "even" : "odd");
+        }
+        stop = true;
+    });
+    bool consistent = true;
+    while (!stop) {
+        // 覆盖注册期间取得的指针始终指向完整的转换函数
+        const AnyConverter* converter = registry.find<Price>();
+        consistent = consistent && converter != nullptr && converter->append != nullptr &&
+                     (converter->name == "price" || converter->name == "even" || converter->name == "odd");
+        consistent = consistent && Params::support(std::any(int64_t{1}));
+    }
+    writer.join();
+    CHECK(consistent);
+    CHECK(registry.find<Price>()->name == "odd");
+    registry.register_type<Price>("price");
+}
+
+TEST_CASE("ConverterRegistry - 批量转换") {
+    const auto& registry = ConverterRegistry::instance();
+
+    SUBCASE("混合类型") {
+        const std::vector<std::any> values = {1, 2, 2.5, std::string("s"), Unregistered{}, std::any(), 3};
+        std::vector<std::string> out(values.size(), "stale");
+        CHECK(registry.to_strings(values, out) == 5);
+        CHECK(out == std::vector<std::string>{"1", "2", "2.5", "s", "", "", "3"});
+    }
+
+    SUBCASE("输出不足") {
+        const std::vector<std::any> values = {1, 2};
+        std::vector<std::string> out(1, "stale");
+        CHECK(registry.to_strings(values, out) == 0);
+        CHECK(out[0] == "stale");
+    }
+
+    SUBCASE("同一类型批量解析") {
+        const std::vector<std::string_view> texts = {"1", "x", "-5"};
+        std::vector<std::any> out(texts.size());
+        CHECK(registry.from_strings(typeid(int64_t), texts, out) == 2);
+        CHECK(std::any_cast<int64_t>(out[0]) == 1);
+        CHECK_FALSE(out[1].has_value());
+        CHECK(std::any_cast<int64_t>(out[2]) == -5);
+        CHECK(registry.from_strings(typeid(Unregistered), texts, out) == 0);
+    }
+}
@@ -4,7 +4,11 @@
 #include <sequoia/utils/any_to_string.h>
 #include <any>
 #include <string>
+#include <array>
 #include <cmath>
+#include <limits>
+#include <span>
+#include <vector>
 
 using namespace sequoia::utils;
 
@@ -106,6 +110,23 @@ TEST_CASE("any_to_string - 自定义类型") {
     }
 }
 
+TEST_CASE("any_to_string - 字符串与数组") {
+    SUBCASE("std::string") {
+        std::any data = std::string("hello");
+        CHECK(any_to_string<std::string>(data) == "hello");
+    }
+    
+    SUBCASE("std::vector<int64_t>") {
+        std::any data = std::vector<int64_t>{1, -2, 3};
+        CHECK(any_to_string<std::vector<int64_t>>(data) == "[1, -2, 3]");
+    }
+    
+    SUBCASE("空数组") {
+        std::any data = std::vector<double>{};
+        CHECK(any_to_string<std::vector<double>>(data) == "[]");
+    }
+}
+
 TEST_CASE("string_to_any - 整型类型") {
     SUBCASE("bool - true") {
         std::any result = string_to_any<bool>("true");
@@ -207,6 +228,29 @@ TEST_CASE("string_to_any - std::string") {
     }
 }
 
+TEST_CASE("string_to_any - 数组") {
+    SUBCASE("带方括号") {
+        std::any result = string_to_any<std::vector<int64_t>>("[1, 2, 3]");
+        CHECK(std::any_cast<std::vector<int64_t>>(result) == std::vector<int64_t>{1, 2, 3});
+    }
+    
+    SUBCASE("不带方括号") {
+        std::any result = string_to_any<std::vector<double>>("0.5,1.5");
+        CHECK(std::any_cast<std::vector<double>>(result) == std::vector<double>{0.5, 1.5});
+    }
+    
+    SUBCASE("空数组") {
+        std::any result = string_to_any<std::vector<double>>("[]");
+        CHECK(std::any_cast<std::vector<double>>(result).empty());
+    }
+    
+    SUBCASE("往返") {
+        std::vector<int64_t> original{7, 8, 9};
+        std::string str = any_to_string<std::vector<int64_t>>(std::any(original));
+        CHECK(std::any_cast<std::vector<int64_t>>(string_to_any<std::vector<int64_t>>(str)) == original);
+    }
+}
+
 TEST_CASE("string_to_any - 自定义类型") {
     SUBCASE("通过构造函数转换") {
         std::any result = string_to_any<CustomType>("42");
@@ -278,3 +322,73 @@ TEST_CASE("边界值测试") {
     }
 }
 
+TEST_CASE("format_number - 最短往返表示") {
+    SUBCASE("浮点数不补零") {
+        CHECK(format_number(3.14) == "3.14");
+        CHECK(format_number(0.1f) == "0.1");
+        CHECK(format_number(-123.456) == "-123.456");
+        CHECK(format_number(1e21) == "1e+21");
+        CHECK(any_to_string<double>(std::any(2.5)) == "2.5");
+        CHECK(any_to_string<std::vector<double>>(std::any(std::vector<double>{0.5, 1.25})) == "[0.5, 1.25]");
+    }
+
+    SUBCASE("往返逐位一致") {
+        for (double value : {0.1, 1.0 / 3.0, 2.675, 1e-300, -6.02214076e23, 9007199254740993.0}) {
+            const auto parsed = parse_number<double>(format_number(value));
+            REQUIRE(parsed.has_value());
+            CHECK(*parsed == value);
+        }
+    }
+
+    SUBCASE("整数与 bool") {
+        CHECK(format_number(std::numeric_limits<int64_t>::min()) == "-9223372036854775808");
+        CHECK(format_number(true) == "1");
+        CHECK(format_number(false) == "0");
+    }
+
+    SUBCASE("写入调用方缓冲区") {
+        std::array<char, 8> buffer{};
+        CHECK(format_number(12345, std::span<char>(buffer)) == 5);
+        CHECK(std::string_view(buffer.data(), 5) == "12345");
+        CHECK(format_number(1.0 / 3.0, std::span<char>(buffer)) == 0);
+    }
+}
+
+TEST_CASE("parse_number - 不抛异常的解析") {
+    SUBCASE("合法输入") {
+        CHECK(parse_number<int32_t>("42") == 42);
+        CHECK(parse_number<int32_t>(" +42 ") == 42);
+        CHECK(parse_number<double>("1.23e-4") == 1.23e-4);
+        CHECK(parse_number<bool>("false") == false);
+        CHECK(parse_number<uint8_t>("255") == 255);
+    }
+
+    SUBCASE("不要求以 '\\0' 结尾") {
+        const std::string_view text = "12345";
+        CHECK(parse_number<int>(text.substr(0, 3)) == 123);
+    }
+
+    SUBCASE("非法输入") {
+        CHECK_FALSE(parse_number<int32_t>("").has_value());
+        CHECK_FALSE(parse_number<int32_t>("abc").has_value());
+        CHECK_FALSE(parse_number<int32_t>("12x").has_value());
+        CHECK_FALSE(parse_number<int32_t>("+-1").has_value());
+        CHECK_FALSE(parse_number<uint32_t>("-1").has_value());
+        CHECK_FALSE(parse_number<double>("1.5.5").has_value());
+        CHECK_FALSE(parse_number<bool>("yes").has_value());
+    }
+
+    SUBCASE("超出范围") {
+        CHECK_FALSE(parse_number<int8_t>("128").has_value());
+        CHECK_FALSE(parse_number<uint64_t>("18446744073709551616").has_value());
+        CHECK_FALSE(parse_number<double>("1e400").has_value());
+    }
+
+    SUBCASE("string_to_any 失败时返回空值") {
+        CHECK_FALSE(string_to_any<int32_t>("abc").has_value());
+        CHECK_FALSE(string_to_any<int8_t>("300").has_value());
+        CHECK_FALSE(string_to_any<std::vector<int64_t>>("[1, x, 3]").has_value());
+        CHECK(std::any_cast<std::vector<int64_t>>(string_to_any<std::vector<int64_t>>("[1, 2, 3]")) ==
+              std::vector<int64_t>{1, 2, 3});
+    }
+}
@@ -0,0 +1,90 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <doctest/doctest.h>
+#include <sequoia/utils/arena_params.h>
+#include <array>
+#include <cstddef>
+
+using namespace sequoia::utils;
+
+TEST_CASE("ArenaParams - set 和 get 基本操作") {
+    ArenaParams params;
+    
+    SUBCASE("标量类型") {
+        params.set("flag", true);
+        params.set("count", 42);
+        params.set("ratio", 0.5);
+        CHECK(params.size() == 3);
+        CHECK(params.get<bool>("flag") == true);
+        CHECK(params.get<int64_t>("count") == 42);
+        CHECK(params.get<double>("ratio") == 0.5);
+    }
+    
+    SUBCASE("字符串与数组") {
+        params.set("name", "a rather long string that does not fit into sso");
+        params.set("ids", std::vector<int64_t>{1, 2, 3, 4, 5, 6});
+        CHECK(params.get<std::string>("name") == "a rather long string that does not fit into sso");
+        CHECK(params.get<std::vector<int64_t>>("ids") == std::vector<int64_t>{1, 2, 3, 4, 5, 6});
+        CHECK(params.type("ids") == "int64[]");
+    }
+    
+    SUBCASE("类型不匹配与缺失") {
+        params.set("name", "abc");
+        CHECK_THROWS_AS(params.set("name", 1), std::logic_error);
+        CHECK_THROWS_AS([&]{ (void)params.get<int>("missing"); }(), std::out_of_range);
+        CHECK(params.try_get<int>("name", 7) == 7);
+    }
+    
+    SUBCASE("remove 和 clear") {
+        params.set("a", 1);
+        params.set("b", 2);
+        CHECK(params.remove("a"));
+        CHECK_FALSE(params.remove("a"));
+        params.clear();
+        CHECK(params.empty());
+    }
+}
+
+TEST_CASE("ArenaParams - 全部内存来自缓冲区") {
+    // 上游为 null_memory_resource：任何溢出缓冲区的分配都会抛出 std::bad_alloc
+    alignas(std::max_align_t) std::array<std::byte, 8192> buffer{};
+    ArenaParams params(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+    
+    CHECK_NOTHROW([&] {
+        for (int i = 0; i < 32; ++i) {
+            params.set("request_parameter_key_" + std::to_string(i), std::string(40, 'x'));
+        }
+        params.set("weights", std::vector<double>(64, 1.5));
+    }());
+    CHECK(params.size() == 33);
+    
+    SUBCASE("clear 后可复用缓冲区") {
+        params.clear();
+        CHECK_NOTHROW(params.set("weights", std::vector<double>(64, 2.5)));
+        CHECK(params.get<std::vector<double>>("weights")[0] == 2.5);
+    }
+}
+
+TEST_CASE("ArenaParams - 与 Params 互相转换") {
+    Params inner;
+    inner.set("port", 8080);
+    
+    Params original;
+    original.set("flag", true);
+    original.set("name", "alice");
+    original.set("values", std::vector<double>{1.0, 2.0});
+    original.set("db", inner);
+    
+    ArenaParams params;
+    params.assign(original);
+    
+    SUBCASE("assign 保留全部参数") {
+        CHECK(params.size() == 4);
+        CHECK(params.get<std::string>("name") == "alice");
+        CHECK(params.get<Params>("db") == inner);
+    }
+    
+    SUBCASE("to_params 往返相等") {
+        CHECK(params.to_params() == original);
+    }
+}
@@ -2,8 +2,12 @@
 
 #include <doctest/doctest.h>
 #include <sequoia/utils/arithmetic.h>
+#include <sequoia/utils/simd/cpu.h>
+#include <array>
 #include <cmath>
+#include <cstring>
 #include <limits>
+#include <vector>
 
 using namespace sequoia::utils;
 
@@ -193,6 +197,140 @@ TEST_CASE("算术函数 - 边界值测试") {
     }
 }
 
+// ==================== 批量取整测试 ====================
+
+namespace {
+
+// 逐位比较，NaN 只要求同为 NaN
+template <typename ValueType>
+bool sameBits(ValueType lhs, ValueType rhs) {
+    if (std::isnan(lhs) || std::isnan(rhs)) {
+        return std::isnan(lhs) && std::isnan(rhs);
+    }
+    return std::memcmp(&lhs, &rhs, sizeof(ValueType)) == 0;
+}
+
+template <typename ValueType>
+std::vector<ValueType> makeRoundingInputs() {
+    std::vector<ValueType> values = {
+        0.0, -0.0, 0.5, -0.5, 1.5, 2.5, -2.5, 2.675, 3.145, -3.155, 1e-10, 1e10, -1e15,
+        std::numeric_limits<ValueType>::infinity(), -std::numeric_limits<ValueType>::infinity(),
+        std::numeric_limits<ValueType>::quiet_NaN(), std::numeric_limits<ValueType>::max(),
+        std::numeric_limits<ValueType>::denorm_min(),
+    };
+    // 大量中间值和普通值，长度不是向量宽度的整数倍
+    for (int i = -500; i < 503; ++i) {
+        values.push_back(static_cast<ValueType>(i) / 8);
+        values.push_back(static_cast<ValueType>(i) * static_cast<ValueType>(0.0137));
+        values.push_back(static_cast<ValueType>(i) * 5 + static_cast<ValueType>(0.005));
+    }
+    return values;
+}
+
+} // namespace
+
+TEST_CASE("roundEx / ceilEx / floorEx - 批量接口与逐个计算逐位一致") {
+    using simd::SimdLevel;
+
+    SUBCASE("double") {
+        const auto values = makeRoundingInputs<double>();
+        std::vector<double> out(values.size());
+        for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::AVX2, SimdLevel::AVX512}) {
+            simd::setMaxLevel(level);
+            for (int32_t ndigits = -3; ndigits <= 6; ++ndigits) {
+                REQUIRE(roundEx(values, out, ndigits) == values.size());
+                for (size_t i = 0; i < values.size(); ++i) {
+                    CHECK(sameBits(out[i], roundEx(values[i], ndigits)));
+                }
+                REQUIRE(ceilEx(values, out, ndigits) == values.size());
+                for (size_t i = 0; i < values.size(); ++i) {
+                    CHECK(sameBits(out[i], ceilEx(values[i], ndigits)));
+                }
+                REQUIRE(floorEx(values, out, ndigits) == values.size());
+                for (size_t i = 0; i < values.size(); ++i) {
+                    CHECK(sameBits(out[i], floorEx(values[i], ndigits)));
+                }
+            }
+        }
+        simd::setMaxLevel(SimdLevel::AVX512);
+    }
+
+    SUBCASE("float") {
+        const auto values = makeRoundingInputs<float>();
+        std::vector<float> out(values.size());
+        for (int32_t ndigits = -2; ndigits <= 4; ++ndigits) {
+            REQUIRE(roundEx(values, out, ndigits) == values.size());
+            for (size_t i = 0; i < values.size(); ++i) {
+                CHECK(sameBits(out[i], roundEx(values[i], ndigits)));
+            }
+            REQUIRE(ceilEx(values, out, ndigits) == values.size());
+            for (size_t i = 0; i < values.size(); ++i) {
+                CHECK(sameBits(out[i], ceilEx(values[i], ndigits)));
+            }
+        }
+    }
+
+    SUBCASE("原地计算和输出不足") {
+        std::vector<double> values = {2.5, 3.5, 3.145, -2.5, 1.0};
+        roundEx(values);
+        CHECK(values == std::vector<double>{2.0, 4.0, 3.0, -2.0, 1.0});
+
+        std::vector<double> prices = {3.141, 3.145, 3.146};
+        roundEx(prices, 2);
+        CHECK(prices[0] == roundEx(3.141, 2));
+        CHECK(prices[1] == roundEx(3.145, 2));
+        CHECK(prices[2] == roundEx(3.146, 2));
+
+        std::array<double, 2> small{};
+        CHECK(roundEx(values, small, 2) == 0);
+        CHECK(small[0] == 0.0);
+    }
+}
+
+template <int32_t NDigits, typename ValueType>
+void checkCompileTimeDigits(const std::vector<ValueType>& values) {
+    for (const ValueType value : values) {
+        CHECK(sameBits(roundEx<NDigits>(value), roundEx(value, NDigits)));
+        CHECK(sameBits(ceilEx<NDigits>(value), ceilEx(value, NDigits)));
+        CHECK(sameBits(floorEx<NDigits>(value), floorEx(value, NDigits)));
+    }
+}
+
+TEST_CASE("roundEx<N> / ceilEx<N> / floorEx<N> - 编译期小数位数") {
+    SUBCASE("10 的幂表与逐次乘 10 一致") {
+        static_assert(detail::power_of_ten<double>(0) == 1.0);
+        static_assert(detail::power_of_ten<double>(4) == 10000.0);
+        double scale = 1;
+        for (int32_t n = 0; n <= 30; ++n) {
+            CHECK(sameBits(detail::power_of_ten<double>(n), scale));
+            scale *= 10;
+        }
+        float scale_f = 1;
+        for (int32_t n = 0; n <= 30; ++n) {
+            CHECK(sameBits(detail::power_of_ten<float>(n), scale_f));
+            scale_f *= 10;
+        }
+    }
+
+    SUBCASE("与运行时 ndigits 逐位一致") {
+        const auto values = makeRoundingInputs<double>();
+        checkCompileTimeDigits<0>(values);
+        checkCompileTimeDigits<2>(values);
+        checkCompileTimeDigits<4>(values);
+        checkCompileTimeDigits<8>(values);
+        checkCompileTimeDigits<-2>(values);
+        checkCompileTimeDigits<2>(makeRoundingInputs<float>());
+    }
+
+    SUBCASE("常用精度") {
+        CHECK(roundEx<2>(3.14159) == doctest::Approx(3.14));
+        CHECK(roundEx<0>(2.5) == 2.0);
+        CHECK(roundEx<-1>(25.0) == 20.0);
+        CHECK(ceilEx<2>(3.141) == doctest::Approx(3.15));
+        CHECK(floorEx<4>(-3.14159) == doctest::Approx(-3.1415));
+    }
+}
+
 // ==================== 字符编码转换测试 ====================
 
 TEST_CASE("utf8_to_gbk - 基本功能") {
@@ -358,6 +496,93 @@ TEST_CASE("trim - 去除首尾空格") {
     }
 }
 
+TEST_CASE("toLower / toUpper - 缓冲区、批量和非 ASCII") {
+    SUBCASE("写入调用方缓冲区") {
+        std::array<char, 5> out{};
+        CHECK(toLower("HeLLo", out) == 5);
+        CHECK(std::string_view(out.data(), 5) == "hello");
+        CHECK(toUpper("HeLLo!", out) == 0);
+    }
+    
+    SUBCASE("非 ASCII 字节保持不变") {
+        std::string str = "ABC\xC4\xE3\xBA\xC3xyz\xE4\xBD\xA0";
+        toLower(str);
+        CHECK(str == "abc\xC4\xE3\xBA\xC3xyz\xE4\xBD\xA0");
+        toUpper(str);
+        CHECK(str == "ABC\xC4\xE3\xBA\xC3XYZ\xE4\xBD\xA0");
+    }
+    
+    SUBCASE("批量转换") {
+        std::vector<std::string> strs{"Key_A", "KEY_b"};
+        toLower(strs);
+        CHECK(strs == std::vector<std::string>{"key_a", "key_b"});
+        toUpper(strs);
+        CHECK(strs == std::vector<std::string>{"KEY_A", "KEY_B"});
+    }
+    
+    SUBCASE("各指令集结果一致") {
+        std::string all;
+        for (int i = 0; i < 256 * 3; ++i) {
+            all.push_back(static_cast<char>(i));
+        }
+        std::string expected_lower = all;
+        std::string expected_upper = all;
+        for (size_t i = 0; i < all.size(); ++i) {
+            const auto c = static_cast<unsigned char>(all[i]);
+            expected_lower[i] = (c >= 'A' && c <= 'Z') ? static_cast<char>(c + 32) : all[i];
+            expected_upper[i] = (c >= 'a' && c <= 'z') ? static_cast<char>(c - 32) : all[i];
+        }
+        
+        for (auto level : {simd::SimdLevel::Scalar, simd::SimdLevel::SSE2, simd::SimdLevel::AVX2}) {
+            simd::setMaxLevel(level);
+            std::string lower = all;
+            toLower(lower);
+            CHECK(lower == expected_lower);
+            std::string upper = all;
+            toUpper(upper);
+            CHECK(upper == expected_upper);
+        }
+        simd::setMaxLevel(simd::SimdLevel::AVX512);
+    }
+}
+
+TEST_CASE("trim_view - 去除首尾空白的视图") {
+    SUBCASE("返回子视图") {
+        const std::string str = " \t hello world \r\n";
+        const std::string_view view = trim_view(str);
+        CHECK(view == "hello world");
+        CHECK(view.data() == str.data() + 3);
+    }
+    
+    SUBCASE("全是空白和空字符串") {
+        CHECK(trim_view("  \t\n").empty());
+        CHECK(trim_view("").empty());
+    }
+    
+    SUBCASE("编译期求值") {
+        static_assert(trim_view("  key  ") == "key");
+    }
+    
+    SUBCASE("原地 trim 不重新分配") {
+        std::string str = "   a fairly long string that does not fit in SSO   ";
+        const char* data = str.data();
+        trim(str);
+        CHECK(str == "a fairly long string that does not fit in SSO");
+        CHECK(str.data() == data);
+    }
+    
+    SUBCASE("批量处理") {
+        std::vector<std::string> strs{" a ", "b\t", "\nc"};
+        trim(strs);
+        CHECK(strs == std::vector<std::string>{"a", "b", "c"});
+        
+        std::array<std::string_view, 2> views{" x ", "  y"};
+        trim_view(views);
+        CHECK(views[0] == "x");
+        CHECK(views[1] == "y");
+    }
+}
+
 TEST_CASE("split - 字符分割") {
     SUBCASE("使用逗号分割") {
         std::string str = "a,b,c,d";
@@ -452,3 +677,74 @@ TEST_CASE("byteToHexWithPrefix - 字节转十六进制（带前缀）") {
     }
 }
 
+
+TEST_CASE("byteToHex - 大小写与调用方缓冲区") {
+    SUBCASE("小写输出") {
+        CHECK(byteToHex("\xAB\xCD\xEF", HexCase::Lower) == "abcdef");
+        CHECK(byteToHex("\xAB\xCD\xEF") == "ABCDEF");
+        CHECK(byteToHexWithPrefix("\xAB", HexCase::Lower) == "0xab ");
+    }
+    
+    SUBCASE("写入调用方缓冲区") {
+        std::array<char, 8> out{};
+        CHECK(byteToHex("abcd", out) == 8);
+        CHECK(std::string_view(out.data(), 8) == "61626364");
+    }
+    
+    SUBCASE("缓冲区不足") {
+        std::array<char, 7> out{};
+        CHECK(byteToHex("abcd", out) == 0);
+        CHECK(byteToHexWithPrefix("ab", out) == 0);
+    }
+}
+
+TEST_CASE("hexToByte - 十六进制转字节") {
+    SUBCASE("大小写混合") {
+        CHECK(hexToByte("61626364") == "abcd");
+        CHECK(hexToByte("aBcDeF") == "\xAB\xCD\xEF");
+        CHECK(hexToByte("") == "");
+    }
+    
+    SUBCASE("非法输入") {
+        CHECK_FALSE(hexToByte("616").has_value());
+        CHECK_FALSE(hexToByte("6g").has_value());
+        CHECK_FALSE(hexToByte("0x61").has_value());
+        // 非法字符位于 SIMD 块内部
+        CHECK_FALSE(hexToByte(std::string(64, 'a') + "zz" + std::string(64, 'b')).has_value());
+    }
+    
+    SUBCASE("缓冲区不足") {
+        std::array<char, 1> out{};
+        CHECK_FALSE(hexToByte("6162", out).has_value());
+        CHECK(hexToByte("61", out) == 1);
+        CHECK(out[0] == 'a');
+    }
+}
+
+TEST_CASE("byteToHex / hexToByte - 各指令集结果一致") {
+    using simd::SimdLevel;
+    
+    std::string bytes;
+    for (int i = 0; i < 300; ++i) {
+        bytes.push_back(static_cast<char>(i * 37 + 11));
+    }
+    
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2}) {
+        simd::setMaxLevel(level);
+        for (size_t len = 0; len <= bytes.size(); len += 7) {
+            const std::string_view input(bytes.data(), len);
+            
+            std::string expected;
+            for (const char c : input) {
+                constexpr char kDigits[] = "0123456789abcdef";
+                expected.push_back(kDigits[static_cast<unsigned char>(c) >> 4]);
+                expected.push_back(kDigits[static_cast<unsigned char>(c) & 0x0F]);
+            }
+            
+            CHECK(byteToHex(input, HexCase::Lower) == expected);
+            CHECK(hexToByte(expected) == input);
+            CHECK(hexToByte(byteToHex(input)) == input);
+        }
+    }
+    simd::setMaxLevel(SimdLevel::AVX512);
+}
@@ -0,0 +1,382 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+// 本测试直接验证 Chrome trace 导出，不依赖构建时是否开启 UTIL_TRACE_CHROME
+#ifndef UTIL_TRACE_CHROME
+#define UTIL_TRACE_CHROME 1
+#endif
+
+#include <doctest/doctest.h>
+#include <sequoia/utils/trace/chrome_trace.h>
+#include <sequoia/utils/trace/trace.h>
+
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <new>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <variant>
+#include <vector>
+
+using namespace sequoia::utils::trace;
+
+namespace {
+
+// 置位后当前线程的对齐分配抛出 bad_alloc，模拟事件环（alignas(64)）分配失败
+thread_local bool fail_aligned_new = false;
+
+// 校验用的最小 JSON 解析器：格式错误时返回 nullptr
+struct JsonValue;
+using JsonObject = std::map<std::string, std::shared_ptr<JsonValue>>;
+using JsonArray = std::vector<std::shared_ptr<JsonValue>>;
+
+struct JsonValue {
+    std::variant<std::nullptr_t, bool, double, std::string, JsonArray, JsonObject> value;
+
+    [[nodiscard]] const JsonObject& object() const { return std::get<JsonObject>(value); }
+    [[nodiscard]] const JsonArray& array() const { return std::get<JsonArray>(value); }
+    [[nodiscard]] const std::string& string() const { return std::get<std::string>(value); }
+    [[nodiscard]] double number() const { return std::get<double>(value); }
+};
+
+class JsonParser {
+public:
+    explicit JsonParser(std::string_view text) : text_(text) {}
+
+    std::shared_ptr<JsonValue> parse() {
+        auto value = parseValue();
+        skipSpace();
+        return pos_ == text_.size() ? value : nullptr;
+    }
+
+private:
+    void skipSpace() {
+        while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+            ++pos_;
+        }
+    }
+
+    bool consume(char ch) {
+        skipSpace();
+        if (pos_ < text_.size() && text_[pos_] == ch) {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+
+    std::shared_ptr<JsonValue> parseValue() {
+        skipSpace();
+        if (pos_ >= text_.size()) {
+            return nullptr;
+        }
+        const char ch = text_[pos_];
+        if (ch == '{') {
+            return parseObject();
+        }
+        if (ch == '[') {
+            return parseArray();
+        }
+        if (ch == '"') {
+            std::string str;
+            return parseString(str) ? std::make_shared<JsonValue>(JsonValue{str}) : nullptr;
+        }
+        if (text_.substr(pos_, 4) == "true" || text_.substr(pos_, 4) == "null") {
+            const bool is_true = text_[pos_] == 't';
+            pos_ += 4;
+            return is_true ? std::make_shared<JsonValue>(JsonValue{true}) : std::make_shared<JsonValue>();
+        }
+        if (text_.substr(pos_, 5) == "false") {
+            pos_ += 5;
+            return std::make_shared<JsonValue>(JsonValue{false});
+        }
+        const size_t begin = pos_;
+        while (pos_ < text_.size() && (std::isdigit(static_cast<unsigned char>(text_[pos_])) ||
+                                       std::string_view("+-.eE").find(text_[pos_]) != std::string_view::npos)) {
+            ++pos_;
+        }
+        if (begin == pos_) {
+            return nullptr;
+        }
+        return std::make_shared<JsonValue>(JsonValue{std::stod(std::string(text_.substr(begin, pos_ - begin)))});
+    }
+
+    bool parseString(std::string& out) {
+        if (!consume('"')) {
+            return false;
+        }
+        while (pos_ < text_.size()) {
+            const char ch = text_[pos_++];
+            if (ch == '"') {
+                return true;
+            }
+            if (ch == '\\') {
+                if (pos_ >= text_.size()) {
+                    return false;
+                }
+                const char escaped = text_[pos_++];
+                if (escaped == 'u') {
+                    pos_ += 4;
+                    out += '?';
+                } else {
+                    out += escaped == 'n' ? '\n' : escaped == 't' ? '\t' : escaped;
+                }
+            } else if (static_cast<unsigned char>(ch) < 0x20) {
+                return false;
+            } else {
+                out += ch;
+            }
+        }
+        return false;
+    }
+
+    std::shared_ptr<JsonValue> parseArray() {
+        consume('[');
+        JsonArray array;
+        if (consume(']')) {
+            return std::make_shared<JsonValue>(JsonValue{array});
+        }
+        do {
+            auto element = parseValue();
+            if (!element) {
+                return nullptr;
+            }
+            array.push_back(element);
+        } while (consume(','));
+        return consume(']') ? std::make_shared<JsonValue>(JsonValue{array}) : nullptr;
+    }
+
+    std::shared_ptr<JsonValue> parseObject() {
+        consume('{');
+        JsonObject object;
+        if (consume('}')) {
+            return std::make_shared<JsonValue>(JsonValue{object});
+        }
+        do {
+            std::string key;
+            skipSpace();
+            if (!parseString(key) || !consume(':')) {
+                return nullptr;
+            }
+            auto element = parseValue();
+            if (!element) {
+                return nullptr;
+            }
+            object[key] = element;
+        } while (consume(','));
+        return consume('}') ? std::make_shared<JsonValue>(JsonValue{object}) : nullptr;
+    }
+
+    std::string_view text_;
+    size_t pos_{0};
+};
+
+std::string readFile(const std::filesystem::path& path) {
+    std::ifstream file(path);
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+// 取出 traceEvents 中名称为 name 的事件
+std::vector<const JsonObject*> eventsNamed(const JsonValue& root, std::string_view name) {
+    std::vector<const JsonObject*> result;
+    for (const auto& event : root.object().at("traceEvents")->array()) {
+        const auto& object = event->object();
+        if (object.at("name")->string() == name) {
+            result.push_back(&object);
+        }
+    }
+    return result;
+}
+
+void outerZone() {
+    T_SCOPED_NAME("chrome_test::outer");
+    {
+        T_SCOPED_NAME("chrome_test::inner");
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+} // namespace
+
+TEST_CASE("ChromeTrace - 文件结构") {
+    auto& trace = ChromeTrace::instance();
+    (void)trace.flush();
+
+    outerZone();
+    T_FRAME_MARK_NAME("chrome_test::frame");
+
+    const auto path = std::filesystem::temp_directory_path() / "sequoia_chrome_trace_test.json";
+    REQUIRE(trace.flush(path.string()));
+    const auto root = JsonParser(readFile(path)).parse();
+    std::filesystem::remove(path);
+    REQUIRE(root != nullptr);
+
+    const auto& object = root->object();
+    CHECK(object.at("displayTimeUnit")->string() == "ns");
+    CHECK(object.at("otherData")->object().at("lost_events")->string() == "0");
+
+    for (const auto& event : object.at("traceEvents")->array()) {
+        const auto& fields = event->object();
+        REQUIRE(fields.contains("name"));
+        REQUIRE(fields.contains("ph"));
+        REQUIRE(fields.contains("pid"));
+        REQUIRE(fields.contains("tid"));
+        const std::string& phase = fields.at("ph")->string();
+        CHECK((phase == "X" || phase == "i" || phase == "M"));
+        if (phase != "M") {
+            CHECK(fields.contains("ts"));
+        }
+    }
+
+    const auto outer = eventsNamed(*root, "chrome_test::outer");
+    const auto inner = eventsNamed(*root, "chrome_test::inner");
+    REQUIRE(outer.size() == 1);
+    REQUIRE(inner.size() == 1);
+    CHECK(outer[0]->at("ph")->string() == "X");
+    CHECK(outer[0]->at("args")->object().at("file")->string().find("chrome_trace_test") != std::string::npos);
+
+    // 内层 zone 嵌套在外层之内，耗时约 1ms（单位微秒）
+    const double outer_ts = outer[0]->at("ts")->number();
+    const double outer_end = outer_ts + outer[0]->at("dur")->number();
+    const double inner_ts = inner[0]->at("ts")->number();
+    const double inner_end = inner_ts + inner[0]->at("dur")->number();
+    CHECK(outer_ts <= inner_ts);
+    CHECK(inner_end <= outer_end + 0.001);
+    CHECK(inner[0]->at("dur")->number() >= 900.0);
+    CHECK(inner[0]->at("tid")->number() == outer[0]->at("tid")->number());
+
+    const auto frames = eventsNamed(*root, "chrome_test::frame");
+    REQUIRE(frames.size() == 1);
+    CHECK(frames[0]->at("ph")->string() == "i");
+    CHECK(frames[0]->at("ts")->number() >= outer_end);
+}
+
+TEST_CASE("ChromeTrace - 增量导出与多线程") {
+    auto& trace = ChromeTrace::instance();
+    (void)trace.flush();
+
+    constexpr int kThreads = 3;
+    constexpr int kZones = 100;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([] {
+            for (int i = 0; i < kZones; ++i) {
+                T_SCOPED_NAME("chrome_test::worker");
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const auto root = JsonParser(trace.flush()).parse();
+    REQUIRE(root != nullptr);
+    const auto workers = eventsNamed(*root, "chrome_test::worker");
+    CHECK(workers.size() == kThreads * kZones);
+    std::set<double> tids;
+    for (const auto* event : workers) {
+        tids.insert(event->at("tid")->number());
+    }
+    CHECK(tids.size() == kThreads);
+
+    // 已导出的事件不会重复导出
+    const auto again = JsonParser(trace.flush()).parse();
+    REQUIRE(again != nullptr);
+    CHECK(eventsNamed(*again, "chrome_test::worker").empty());
+}
+
+TEST_CASE("ChromeTrace - 环满时覆盖最旧事件") {
+    auto& trace = ChromeTrace::instance();
+    (void)trace.flush();
+
+    static constexpr ZoneSite site{"chrome_test::overflow", std::source_location::current()};
+    const size_t total = detail::EventRing::kCapacity + 500;
+    for (size_t i = 0; i < total; ++i) {
+        ChromeTrace::record(&site, origin_ticks() + i, origin_ticks() + i + 1);
+    }
+
+    const auto root = JsonParser(trace.flush()).parse();
+    REQUIRE(root != nullptr);
+    const auto events = eventsNamed(*root, "chrome_test::overflow");
+    CHECK(events.size() == detail::EventRing::kCapacity - 1);
+    CHECK(root->object().at("otherData")->object().at("lost_events")->string() == "501");
+}
+
+// UTIL_TRACE_MEMORY 已替换全局 operator new，此时不再替换
+#if !(defined(UTIL_TRACE_ENABLE) && defined(UTIL_TRACE_MEMORY))
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    const auto align = static_cast<std::size_t>(alignment);
+    void* ptr = fail_aligned_new ? nullptr : std::aligned_alloc(align, (size + align) / align * align);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+TEST_CASE("ChromeTrace - 事件环分配失败") {
+    auto& trace = ChromeTrace::instance();
+    (void)trace.flush();
+
+    static constexpr ZoneSite site{"chrome_test::no_ring", std::source_location::current()};
+    std::thread worker([] {
+        fail_aligned_new = true;
+        // 不抛出、不终止，事件计入 lost_events
+        ChromeTrace::record(&site, origin_ticks(), origin_ticks() + 1);
+        ChromeTrace::mark(&site);
+        fail_aligned_new = false;
+        // 分配恢复后重新注册
+        ChromeTrace::record(&site, origin_ticks(), origin_ticks() + 1);
+    });
+    worker.join();
+
+    const auto root = JsonParser(trace.flush()).parse();
+    REQUIRE(root != nullptr);
+    CHECK(eventsNamed(*root, "chrome_test::no_ring").size() == 1);
+    CHECK(root->object().at("otherData")->object().at("lost_events")->string() == "2");
+}
+
+#endif
+
+TEST_CASE("ChromeTrace - 运行时开关与 T_SHUTDOWN") {
+    auto& trace = ChromeTrace::instance();
+    (void)trace.flush();
+
+    ChromeTrace::set_enabled(false);
+    {
+        T_SCOPED_NAME("chrome_test::disabled");
+    }
+    ChromeTrace::set_enabled(true);
+    {
+        T_SCOPED_NAME("chrome_test::enabled");
+    }
+
+    const auto path = std::filesystem::temp_directory_path() / "sequoia_chrome_trace_shutdown.json";
+    trace.set_output_path(path.string());
+    CHECK(trace.output_path() == path.string());
+    T_SHUTDOWN;
+
+    const auto root = JsonParser(readFile(path)).parse();
+    std::filesystem::remove(path);
+    REQUIRE(root != nullptr);
+    CHECK(eventsNamed(*root, "chrome_test::disabled").empty());
+    CHECK(eventsNamed(*root, "chrome_test::enabled").size() == 1);
+
+    CHECK_FALSE(trace.flush("/nonexistent_dir/sequoia_chrome_trace.json"));
+}
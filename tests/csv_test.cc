@@ -0,0 +1,147 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <doctest/doctest.h>
+#include <sequoia/utils/csv.h>
+#include <sequoia/utils/simd/cpu.h>
+#include <string>
+#include <vector>
+
+using namespace sequoia::utils;
+
+namespace {
+
+using Records = std::vector<std::vector<std::string>>;
+
+Records parse(const CsvTokenizer& tokenizer, std::string_view buffer) {
+    CsvIndex index;
+    CHECK(tokenizer.tokenize(buffer, index) == buffer.size());
+    Records records;
+    for (size_t i = 0; i < index.record_count(); ++i) {
+        auto& record = records.emplace_back();
+        for (const CsvField& field : index.record(i)) {
+            record.push_back(tokenizer.unescape(buffer, field));
+        }
+    }
+    return records;
+}
+
+} // namespace
+
+TEST_CASE("CsvTokenizer - 基本解析") {
+    const CsvTokenizer tokenizer;
+
+    SUBCASE("多条记录") {
+        CHECK(parse(tokenizer, "a,b,c\n1,2,3\n") == Records{{"a", "b", "c"}, {"1", "2", "3"}});
+    }
+
+    SUBCASE("末尾没有换行") {
+        CHECK(parse(tokenizer, "a,b\n1,") == Records{{"a", "b"}, {"1", ""}});
+    }
+
+    SUBCASE("CRLF 换行") {
+        CHECK(parse(tokenizer, "a,b\r\n1,2\r\n") == Records{{"a", "b"}, {"1", "2"}});
+    }
+
+    SUBCASE("跳过空行") {
+        CHECK(parse(tokenizer, "a\n\n\nb\n") == Records{{"a"}, {"b"}});
+        CHECK(parse(CsvTokenizer({.skip_empty_lines = false}), "a\n\nb\n") == Records{{"a"}, {""}, {"b"}});
+    }
+
+    SUBCASE("空缓冲区") {
+        CHECK(parse(tokenizer, "").empty());
+    }
+}
+
+TEST_CASE("CsvTokenizer - 引号和转义") {
+    SUBCASE("引号内的分隔符和换行属于字段") {
+        const CsvTokenizer tokenizer;
+        CHECK(parse(tokenizer, "\"a,b\",\"line1\nline2\"\n") == Records{{"a,b", "line1\nline2"}});
+    }
+
+    SUBCASE("双引号转义") {
+        const CsvTokenizer tokenizer;
+        const std::string buffer = "\"say \"\"hi\"\"\",x\n";
+        CsvIndex index;
+        CHECK(tokenizer.tokenize(buffer, index) == buffer.size());
+        const CsvField& field = index.record(0)[0];
+        CHECK(field.quoted);
+        CHECK(field.escaped);
+        CHECK(field.view(buffer) == "say \"\"hi\"\"");
+        CHECK(tokenizer.unescape(buffer, field) == "say \"hi\"");
+    }
+
+    SUBCASE("反斜杠转义") {
+        const CsvTokenizer tokenizer({.escape = '\\'});
+        CHECK(parse(tokenizer, "\"a\\\"b\",c\n") == Records{{"a\"b", "c"}});
+    }
+
+    SUBCASE("字段中间的引号按普通字符处理") {
+        const CsvTokenizer tokenizer;
+        CHECK(parse(tokenizer, "a\"b,c\n") == Records{{"a\"b", "c"}});
+    }
+
+    SUBCASE("TSV 不识别引号") {
+        const CsvTokenizer tokenizer(CsvDialect::tsv());
+        CHECK(parse(tokenizer, "\"a\tb\"\n") == Records{{"\"a", "b\""}});
+    }
+
+    SUBCASE("未闭合的引号延伸到末尾") {
+        const CsvTokenizer tokenizer;
+        CHECK(parse(tokenizer, "a,\"bc\nd") == Records{{"a", "bc\nd"}});
+    }
+}
+
+TEST_CASE("CsvTokenizer - 流式解析") {
+    const CsvTokenizer tokenizer;
+    CsvIndex index;
+
+    SUBCASE("只消费完整记录") {
+        const std::string_view chunk = "a,b\nc,\"d\n";
+        CHECK(tokenizer.tokenize(chunk, index, false) == 4);
+        CHECK(index.record_count() == 1);
+        CHECK(index.field_count() == 2);
+    }
+
+    SUBCASE("分块结果与整体解析一致") {
+        std::string data;
+        for (int i = 0; i < 500; ++i) {
+            data += std::to_string(i) + ",\"q" + std::to_string(i) + "\"\"x\",tail\n";
+        }
+
+        size_t records = 0;
+        std::string pending;
+        for (size_t pos = 0; pos < data.size(); pos += 97) {
+            pending += data.substr(pos, 97);
+            const size_t consumed = tokenizer.tokenize(pending, index, false);
+            for (size_t i = 0; i < index.record_count(); ++i) {
+                const auto fields = index.record(i);
+                REQUIRE(fields.size() == 3);
+                CHECK(fields[0].view(pending) == std::to_string(records));
+                CHECK(tokenizer.unescape(pending, fields[1]) == "q" + std::to_string(records) + "\"x");
+                ++records;
+            }
+            pending.erase(0, consumed);
+        }
+        CHECK(pending.empty());
+        CHECK(records == 500);
+    }
+}
+
+TEST_CASE("CsvTokenizer - 各指令集结果一致") {
+    using simd::SimdLevel;
+
+    std::string data;
+    for (int i = 0; i < 300; ++i) {
+        data += "field" + std::to_string(i) + ",\"quoted, " + std::to_string(i * 3) + "\",,x\r\n";
+    }
+
+    const CsvTokenizer tokenizer;
+    simd::setMaxLevel(SimdLevel::Scalar);
+    const Records expected = parse(tokenizer, data);
+    CHECK(expected.size() == 300);
+    CHECK(expected[7] == std::vector<std::string>{"field7", "quoted, 21", "", "x"});
+
+    simd::setMaxLevel(SimdLevel::AVX2);
+    CHECK(parse(tokenizer, data) == expected);
+    simd::setMaxLevel(SimdLevel::AVX512);
+}
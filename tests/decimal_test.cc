@@ -0,0 +1,160 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <doctest/doctest.h>
+#include <sequoia/utils/arithmetic.h>
+#include <sequoia/utils/decimal.h>
+#include <cmath>
+#include <limits>
+
+using namespace sequoia::utils;
+
+TEST_CASE("Decimal - 构造与格式化") {
+    SUBCASE("to_string 保留全部小数位") {
+        CHECK(Decimal(12345, 2).to_string() == "123.45");
+        CHECK(Decimal(-1050, 3).to_string() == "-1.050");
+        CHECK(Decimal(5, 3).to_string() == "0.005");
+        CHECK(Decimal(-5, 1).to_string() == "-0.5");
+        CHECK(Decimal(42, 0).to_string() == "42");
+        CHECK(Decimal(std::numeric_limits<int64_t>::min(), 0).to_string() == "-9223372036854775808");
+    }
+
+    SUBCASE("make 校验 scale") {
+        auto value = Decimal::make(12345, 2);
+        REQUIRE(value.has_value());
+        CHECK(value->to_string() == "123.45");
+        CHECK(Decimal::make(1, Decimal::kMaxScale).has_value());
+        CHECK_FALSE(Decimal::make(1, -1).has_value());
+        CHECK_FALSE(Decimal::make(1, Decimal::kMaxScale + 1).has_value());
+        static_assert(Decimal::make(5, 1)->mantissa() == 5);
+    }
+
+    SUBCASE("from_string") {
+        auto value = Decimal::from_string("-123.4500");
+        REQUIRE(value.has_value());
+        CHECK(value->mantissa() == -1234500);
+        CHECK(value->scale() == 4);
+        CHECK(Decimal::from_string("+7")->to_string() == "7");
+        CHECK(Decimal::from_string("9223372036854775807").has_value());
+        CHECK(Decimal::from_string("-9223372036854775808").has_value());
+
+        CHECK_FALSE(Decimal::from_string("").has_value());
+        CHECK_FALSE(Decimal::from_string("-").has_value());
+        CHECK_FALSE(Decimal::from_string("1.").has_value());
+        CHECK_FALSE(Decimal::from_string(".5").has_value());
+        CHECK_FALSE(Decimal::from_string("1.2.3").has_value());
+        CHECK_FALSE(Decimal::from_string("1e5").has_value());
+        CHECK_FALSE(Decimal::from_string("9223372036854775808").has_value());
+        CHECK_FALSE(Decimal::from_string("0.1234567890123456789").has_value());  // 超过 18 位小数
+    }
+}
+
+TEST_CASE("Decimal - 与 double 互相转换") {
+    SUBCASE("from_double 基于最短往返表示舍入") {
+        CHECK(Decimal::from_double(2.675, 2)->to_string() == "2.68");   // 二进制下略小于 2.675
+        CHECK(Decimal::from_double(2.665, 2)->to_string() == "2.66");   // 五成双
+        CHECK(Decimal::from_double(1.005, 2)->to_string() == "1.00");
+        CHECK(Decimal::from_double(-2.5, 0)->to_string() == "-2");
+        CHECK(Decimal::from_double(0.1 + 0.2, 2)->to_string() == "0.30");
+        CHECK(Decimal::from_double(1e-30, 4)->to_string() == "0.0000");
+        CHECK(Decimal::from_double(123456.0, 3)->to_string() == "123456.000");
+        CHECK(Decimal::from_double(2.675, 2, RoundingMode::TowardZero)->to_string() == "2.67");
+        CHECK(Decimal::from_double(2.665, 2, RoundingMode::HalfAwayFromZero)->to_string() == "2.67");
+        CHECK(Decimal::from_double(1e-30, 4, RoundingMode::AwayFromZero)->to_string() == "0.0001");
+    }
+
+    SUBCASE("非法参数") {
+        CHECK_FALSE(Decimal::from_double(std::numeric_limits<double>::quiet_NaN(), 2).has_value());
+        CHECK_FALSE(Decimal::from_double(std::numeric_limits<double>::infinity(), 2).has_value());
+        CHECK_FALSE(Decimal::from_double(1e30, 2).has_value());
+        CHECK_FALSE(Decimal::from_double(1.0, 19).has_value());
+        CHECK_FALSE(Decimal::from_double(1.0, -1).has_value());
+    }
+
+    SUBCASE("to_double 往返") {
+        for (double value : {0.1, 2.675, -1234.5678, 1e-18, 3.14159265358979, 0.0}) {
+            CHECK(Decimal::from_string(std::to_string(value).substr(0, 10))->to_double() ==
+                  std::stod(std::to_string(value).substr(0, 10)));
+        }
+        CHECK(Decimal(123456789012345678, 2).to_double() == 1234567890123456.78);
+        CHECK(Decimal::from_double(0.3, 18)->to_double() == 0.3);
+    }
+}
+
+TEST_CASE("Decimal - 精确运算") {
+    const Decimal price = *Decimal::from_string("19.99");
+    const Decimal quantity = *Decimal::from_string("3");
+
+    SUBCASE("rescale") {
+        CHECK(Decimal(2675, 3).rescale(2)->to_string() == "2.68");
+        CHECK(Decimal(2665, 3).rescale(2)->to_string() == "2.66");
+        CHECK(Decimal(-2665, 3).rescale(2)->to_string() == "-2.66");
+        CHECK(Decimal(-2665, 3).rescale(2, RoundingMode::HalfAwayFromZero)->to_string() == "-2.67");
+        CHECK(Decimal(-2661, 3).rescale(2, RoundingMode::AwayFromZero)->to_string() == "-2.67");
+        CHECK(Decimal(25, 1).rescale(4)->to_string() == "2.5000");
+        CHECK_FALSE(Decimal(std::numeric_limits<int64_t>::max(), 0).rescale(1).has_value());
+        CHECK_FALSE(Decimal(1, 0).rescale(19).has_value());
+    }
+
+    SUBCASE("加减乘除") {
+        CHECK(price.add(quantity)->to_string() == "22.99");
+        CHECK(price.sub(Decimal(2000, 2))->to_string() == "-0.01");
+        CHECK(price.mul(quantity, 2)->to_string() == "59.97");
+        CHECK(Decimal(1, 1).mul(Decimal(1, 1), 1)->to_string() == "0.0");  // 0.01 五成双到 0.0
+        CHECK(Decimal(100, 0).div(Decimal(3, 0), 4)->to_string() == "33.3333");
+        CHECK(Decimal(2, 0).div(Decimal(3, 0), 2)->to_string() == "0.67");
+        CHECK(Decimal(-1, 0).div(Decimal(8, 0), 2)->to_string() == "-0.12");   // -0.125 五成双
+        CHECK(Decimal(1, 0).div(Decimal(-8, 0), 2, RoundingMode::HalfAwayFromZero)->to_string() == "-0.13");
+        CHECK_FALSE(price.div(Decimal(0, 2), 2).has_value());
+    }
+
+    SUBCASE("溢出") {
+        const Decimal max(std::numeric_limits<int64_t>::max(), 0);
+        CHECK_FALSE(max.add(Decimal(1, 0)).has_value());
+        CHECK_FALSE(max.mul(Decimal(2, 0), 0).has_value());
+        CHECK(max.mul(max, 0).has_value() == false);
+        CHECK(max.mul(Decimal(1, 18), 0)->to_string() == "9");
+        CHECK_FALSE(max.div(Decimal(1, 18), 18).has_value());
+    }
+
+    SUBCASE("按数值比较") {
+        CHECK(Decimal(150, 2) == Decimal(15, 1));
+        CHECK(Decimal(149, 2) < Decimal(15, 1));
+        CHECK(Decimal(-1, 0) < Decimal(1, 18));
+        CHECK(Decimal(5, 1).neg() == Decimal(-50, 2));
+        CHECK(Decimal(std::numeric_limits<int64_t>::max(), 2).neg()->mantissa() == -std::numeric_limits<int64_t>::max());
+        CHECK_FALSE(Decimal(std::numeric_limits<int64_t>::min(), 2).neg().has_value());
+        static_assert(Decimal(-3, 0).neg()->mantissa() == 3);
+    }
+}
+
+TEST_CASE("roundExact - 十进制精确舍入") {
+    SUBCASE("修正 roundEx 的二进制误差") {
+        // 1.015 * 100 == 101.49999999999999，8.345 * 100 == 834.5000000000001
+        CHECK(roundEx(1.015, 2) == 1.01);
+        CHECK(roundExact(1.015, 2) == 1.02);
+        CHECK(roundEx(8.345, 2) == 8.35);
+        CHECK(roundExact(8.345, 2) == 8.34);
+        CHECK(roundExact(2.675, 2) == 2.68);
+        CHECK(roundExact(2.665, 2) == 2.66);
+        CHECK(roundExact(1.005, 2) == 1.0);
+        CHECK(roundExact(0.125, 2) == 0.12);
+        CHECK(roundExact(0.375, 2) == 0.38);
+    }
+
+    SUBCASE("与 roundEx 在精确中间值上一致") {
+        for (double value : {2.5, 3.5, -2.5, 0.25, 1234.5, 3.14159}) {
+            CHECK(roundExact(value) == roundEx(value));
+        }
+        CHECK(roundExact(125.0, -1) == 120.0);
+        CHECK(roundExact(135.0, -1) == 140.0);
+        CHECK(roundExact(1254.567, -2) == 1300.0);
+    }
+
+    SUBCASE("边界") {
+        CHECK(std::signbit(roundExact(-0.001, 2)));
+        CHECK(roundExact(1e300, 2) == 1e300);
+        CHECK(roundExact(123456789.123456789, 12) == 123456789.123456789);
+        CHECK(std::isnan(roundExact(std::numeric_limits<double>::quiet_NaN(), 2)));
+        CHECK(roundExact(2.675, 2, RoundingMode::TowardZero) == 2.67);
+    }
+}
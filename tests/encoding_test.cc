@@ -0,0 +1,406 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <doctest/doctest.h>
+#include <sequoia/utils/encoding.h>
+#include <sequoia/utils/simd/cpu.h>
+#include <array>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace sequoia::utils;
+
+namespace {
+
+// "你好" 的 GBK 编码
+const std::string kGbkHello = "\xC4\xE3\xBA\xC3";
+
+} // namespace
+
+TEST_CASE("convert_encoding - 调用方缓冲区") {
+    SUBCASE("缓冲区足够") {
+        std::array<char, 16> out{};
+        auto written = utf8_to_gbk("你好", out);
+        REQUIRE(written.has_value());
+        CHECK(std::string_view(out.data(), *written) == kGbkHello);
+
+        written = gbk_to_utf8(kGbkHello, out);
+        REQUIRE(written.has_value());
+        CHECK(std::string_view(out.data(), *written) == "你好");
+    }
+
+    SUBCASE("缓冲区不足") {
+        std::array<char, 3> out{};
+        CHECK_FALSE(gbk_to_utf8(kGbkHello, out).has_value());
+    }
+
+    SUBCASE("非法序列和不支持的编码") {
+        std::array<char, 16> out{};
+        CHECK_FALSE(utf8_to_gbk("\xFF\xFE", out).has_value());
+        CHECK_FALSE(convert_encoding("abc", out, "NO-SUCH-ENCODING", "UTF-8").has_value());
+    }
+
+    SUBCASE("失败后缓存的描述符仍可继续使用") {
+        // gbk_to_utf8 使用内置映射表，这里经 convert_encoding 走 iconv 描述符缓存
+        std::array<char, 16> out{};
+        CHECK_FALSE(convert_encoding("\xE4\xBD", out, "UTF-16LE", "UTF-8").has_value());
+        auto written = convert_encoding("你", out, "UTF-16LE", "UTF-8");
+        REQUIRE(written.has_value());
+        CHECK(std::string_view(out.data(), *written) == "\x60\x4F");
+
+        // 有状态编码：输出不足时停在双字节模式，下次使用前需重置为 ASCII 模式
+        std::array<char, 5> small{};
+        CHECK_FALSE(convert_encoding("日本", small, "ISO-2022-JP", "UTF-8").has_value());
+        written = convert_encoding("a", out, "ISO-2022-JP", "UTF-8");
+        REQUIRE(written.has_value());
+        CHECK(std::string_view(out.data(), *written) == "a");
+    }
+}
+
+TEST_CASE("convert_encoding - 自动扩容") {
+    SUBCASE("长文本") {
+        std::string utf8;
+        for (int i = 0; i < 10000; ++i) {
+            utf8 += "编码转换abc";
+        }
+        const auto gbk = convert_encoding(utf8, "GBK", "UTF-8");
+        REQUIRE(gbk.has_value());
+        CHECK(convert_encoding(*gbk, "UTF-8", "GBK") == utf8);
+    }
+
+    SUBCASE("输出远大于输入") {
+        const std::string ascii(1000, 'a');
+        const auto utf32 = convert_encoding(ascii, "UTF-32LE", "UTF-8");
+        REQUIRE(utf32.has_value());
+        CHECK(utf32->size() == 4000);
+    }
+
+    SUBCASE("输入被截断") {
+        CHECK_FALSE(convert_encoding("\xC4\xE3\xBA", "UTF-8", "GBK").has_value());
+        CHECK(gbk_to_utf8("\xC4\xE3\xBA") == "\xC4\xE3\xBA");  // 失败时返回原字符串
+    }
+
+    SUBCASE("多线程各自使用缓存") {
+        auto worker = [] {
+            for (int i = 0; i < 1000; ++i) {
+                CHECK(gbk_to_utf8(utf8_to_gbk("多线程")) == "多线程");
+            }
+        };
+        std::thread t1(worker);
+        std::thread t2(worker);
+        t1.join();
+        t2.join();
+    }
+}
+
+TEST_CASE("StreamingConverter - 分块转换") {
+    std::string utf8;
+    for (int i = 0; i < 2000; ++i) {
+        utf8 += "流式转换" + std::to_string(i);
+    }
+    const std::string gbk = utf8_to_gbk(utf8);
+
+    SUBCASE("多字节序列跨块") {
+        for (size_t chunk_size : {1, 3, 7, 4096}) {
+            StreamingConverter converter("UTF-8", "GBK");
+            REQUIRE(converter.is_valid());
+            std::string out;
+            for (size_t pos = 0; pos < gbk.size(); pos += chunk_size) {
+                CHECK(converter.convert(std::string_view(gbk).substr(pos, chunk_size), out));
+            }
+            CHECK(converter.finish(out));
+            CHECK(out == utf8);
+        }
+    }
+
+    SUBCASE("输入被截断") {
+        StreamingConverter converter("UTF-8", "GBK");
+        std::string out;
+        CHECK(converter.convert("\xC4\xE3\xBA", out));
+        CHECK(converter.pending_size() == 1);
+        CHECK_FALSE(converter.finish(out));
+        CHECK(out == "你");
+    }
+
+    SUBCASE("非法序列后需要 reset") {
+        StreamingConverter converter("GBK", "UTF-8");
+        std::string out;
+        CHECK_FALSE(converter.convert("a\xFF", out));
+        CHECK_FALSE(converter.convert("b", out));
+        converter.reset();
+        CHECK(converter.convert("b", out));
+        CHECK(out == "ab");
+    }
+
+    SUBCASE("不支持的编码") {
+        StreamingConverter converter("NO-SUCH-ENCODING", "UTF-8");
+        std::string out;
+        CHECK_FALSE(converter.is_valid());
+        CHECK_FALSE(converter.convert("abc", out));
+    }
+}
+
+TEST_CASE("内置 GBK 转换 - 已知码位") {
+    // {GBK, UTF-8}
+    const std::pair<std::string_view, std::string_view> kKnown[] = {
+        {"\x80", "\u20AC"},          // 单字节欧元符号
+        {"\x81\x40", "\u4E02"},      // 双字节区起点
+        {"\xA1\xA1", "\u3000"},      // 全角空格
+        {"\xB0\xA1", "\u554A"},      // GB2312 汉字区起点
+        {"\xD7\xF9", "\u5EA7"},      // GB2312 汉字区终点
+        {"\xFE\x4F", "\uFA29"},      // 最后一个有映射的码位
+    };
+
+    SUBCASE("双向转换") {
+        for (const auto& [gbk, utf8] : kKnown) {
+            std::array<char, 8> out{};
+            auto written = gbk_to_utf8(gbk, out);
+            REQUIRE(written.has_value());
+            CHECK(std::string_view(out.data(), *written) == utf8);
+
+            written = utf8_to_gbk(utf8, out);
+            REQUIRE(written.has_value());
+            CHECK(std::string_view(out.data(), *written) == gbk);
+        }
+    }
+
+    SUBCASE("用户自定义区不映射到私用区") {
+        std::array<char, 8> out{};
+        for (std::string_view code : {"\xAA\xA1", "\xAF\xFE", "\xF8\xA1", "\xFE\xFE", "\xA1\x40", "\xA7\xA0"}) {
+            CHECK_FALSE(gbk_to_utf8(code, out).has_value());
+        }
+        CHECK_FALSE(utf8_to_gbk("\uE000", out).has_value());
+        CHECK_FALSE(utf8_to_gbk("\uE4C5", out).has_value());
+    }
+
+    SUBCASE("非法首字节和尾字节") {
+        std::array<char, 8> out{};
+        for (std::string_view code : {"\xFF", "\xFF\x41", "\x81\x7F", "\x81\xFF", "\x81\x3F"}) {
+            CHECK_FALSE(gbk_to_utf8(code, out).has_value());
+        }
+        // 尾字节为 ASCII 时只跳过首字节
+        std::vector<TranscodeError> errors;
+        CHECK(gbk_to_utf8("\x81\x30", InvalidPolicy::Skip, &errors) == "0");
+        REQUIRE(errors.size() == 1);
+        CHECK(errors[0].length == 1);
+        // 尾字节在 GBK 范围内时跳过整个双字节
+        errors.clear();
+        CHECK(gbk_to_utf8("\xFE\xFE" "a", InvalidPolicy::Skip, &errors) == "a");
+        REQUIRE(errors.size() == 1);
+        CHECK(errors[0].length == 2);
+    }
+
+    SUBCASE("无法映射的 Unicode") {
+        std::array<char, 8> out{};
+        for (std::string_view utf8 : {"\u0080", "\u00A5", "\U0001F600"}) {
+            CHECK_FALSE(utf8_to_gbk(utf8, out).has_value());
+        }
+    }
+
+    SUBCASE("非法 UTF-8 序列") {
+        std::array<char, 16> out{};
+        for (std::string_view bad : {"\xC0\xAF", "\xE0\x80\xAF", "\xED\xA0\x80", "\xF4\x90\x80\x80",
+                                     "\x80", "\xF0\x9F\x98\x80", "\xE4\xBD"}) {
+            CHECK_FALSE(utf8_to_gbk(bad, out).has_value());
+        }
+    }
+
+    SUBCASE("ASCII 连续段与多字节字符交错") {
+        std::string utf8;
+        for (int i = 0; i < 500; ++i) {
+            utf8 += std::string(static_cast<size_t>(i % 70), 'a') + "中文";
+        }
+        std::string expected;
+        for (int i = 0; i < 500; ++i) {
+            expected += std::string(static_cast<size_t>(i % 70), 'a') + "\xD6\xD0\xCE\xC4";
+        }
+        const std::string gbk = utf8_to_gbk(utf8);
+        CHECK(gbk == expected);
+        CHECK(gbk_to_utf8(gbk) == utf8);
+    }
+}
+
+TEST_CASE("非法序列处理策略") {
+    SUBCASE("UTF-8 -> GBK 替换、跳过和失败") {
+        const std::string_view input = "a\xFF你\xE4\xBDz";
+        std::vector<TranscodeError> errors;
+        CHECK(utf8_to_gbk(input, InvalidPolicy::Replace, &errors) == "a?\xC4\xE3?z");
+        REQUIRE(errors.size() == 2);
+        CHECK(errors[0].offset == 1);
+        CHECK(errors[0].length == 1);
+        CHECK(errors[1].offset == 5);
+        CHECK(errors[1].length == 2);  // 被截断的序列只替换一次
+
+        CHECK(utf8_to_gbk(input, InvalidPolicy::Skip) == "a\xC4\xE3z");
+        CHECK(utf8_to_gbk(input, InvalidPolicy::Fail, &errors) == "a");
+        REQUIRE(errors.size() == 1);
+        CHECK(errors[0].offset == 1);
+    }
+
+    SUBCASE("GBK -> UTF-8 非法尾字节不吞掉后续 ASCII") {
+        std::vector<TranscodeError> errors;
+        CHECK(gbk_to_utf8("\xC4" "0\xC4\xE3\xFF", InvalidPolicy::Replace, &errors) == "\xEF\xBF\xBD" "0你\xEF\xBF\xBD");
+        REQUIRE(errors.size() == 2);
+        CHECK(errors[0].offset == 0);
+        CHECK(errors[1].offset == 4);
+        CHECK(gbk_to_utf8("\xC4\xE3\xBA", InvalidPolicy::Skip) == "你");
+    }
+
+    SUBCASE("无法映射的字符") {
+        std::vector<TranscodeError> errors;
+        CHECK(utf8_to_gbk("a\xF0\x9F\x98\x80" "b", InvalidPolicy::Replace, &errors) == "a?b");
+        REQUIRE(errors.size() == 1);
+        CHECK(errors[0].length == 4);
+    }
+
+    SUBCASE("合法输入与严格转换一致") {
+        const std::string utf8 = "混合 ASCII 与中文";
+        CHECK(utf8_to_gbk(utf8, InvalidPolicy::Fail) == utf8_to_gbk(utf8));
+        CHECK(gbk_to_utf8(utf8_to_gbk(utf8), InvalidPolicy::Fail) == utf8);
+    }
+}
+
+TEST_CASE("Transcoder - 增量转换") {
+    std::string gbk;
+    std::string expected;
+    for (int i = 0; i < 500; ++i) {
+        gbk += kGbkHello + std::to_string(i) + "\xFF";
+        expected += "你好" + std::to_string(i) + "\xEF\xBF\xBD";
+    }
+
+    SUBCASE("任意分块与一次性转换结果一致") {
+        for (size_t chunk_size : {1, 2, 3, 5, 4096}) {
+            Transcoder transcoder(TranscodeDirection::GbkToUtf8);
+            std::string out;
+            for (size_t pos = 0; pos < gbk.size(); pos += chunk_size) {
+                CHECK(transcoder.feed(std::string_view(gbk).substr(pos, chunk_size), out));
+            }
+            CHECK(transcoder.finish(out));
+            CHECK(out == expected);
+            CHECK(transcoder.error_count() == 500);
+            REQUIRE(transcoder.errors().size() == 500);
+            CHECK(gbk[transcoder.errors().back().offset] == '\xFF');
+        }
+    }
+
+    SUBCASE("UTF-8 多字节序列跨块") {
+        const std::string utf8 = "流式😀转换";
+        for (size_t chunk_size : {1, 2, 3}) {
+            Transcoder transcoder(TranscodeDirection::Utf8ToGbk, InvalidPolicy::Replace, "*");
+            std::string out;
+            for (size_t pos = 0; pos < utf8.size(); pos += chunk_size) {
+                transcoder.feed(std::string_view(utf8).substr(pos, chunk_size), out);
+            }
+            CHECK(transcoder.finish(out));
+            CHECK(out == utf8_to_gbk("流式") + "*" + utf8_to_gbk("转换"));
+            REQUIRE(transcoder.errors().size() == 1);
+            CHECK(transcoder.errors()[0].offset == 6);
+        }
+    }
+
+    SUBCASE("finish 时输入被截断") {
+        Transcoder transcoder(TranscodeDirection::Utf8ToGbk, InvalidPolicy::Fail);
+        std::string out;
+        CHECK(transcoder.feed("你\xE5\xA5", out));
+        CHECK(transcoder.pending_size() == 2);
+        CHECK_FALSE(transcoder.finish(out));
+        CHECK(out == "\xC4\xE3");
+        REQUIRE(transcoder.errors().size() == 1);
+        CHECK(transcoder.errors()[0].offset == 3);
+
+        transcoder.reset();
+        out.clear();
+        CHECK(transcoder.feed("好", out));
+        CHECK(transcoder.finish(out));
+        CHECK(out == "\xBA\xC3");
+        CHECK(transcoder.errors().empty());
+    }
+}
+
+TEST_CASE("UTF-8 校验与字符计数") {
+    using simd::SimdLevel;
+
+    SUBCASE("非法序列的位置") {
+        for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::AVX2}) {
+            simd::setMaxLevel(level);
+            const std::array<std::string_view, 7> valid_pieces = {"a", "Hello, ", "é", "中文", "😀", "\x7F", "\xF4\x8F\xBF\xBF"};
+            const std::array<std::string_view, 8> bad_pieces = {"\xFF", "\x80", "\xC0\xAF", "\xE0\x80\xAF",
+                                                                "\xED\xA0\x80", "\xF4\x90\x80\x80", "\xE4\xBD", "\xF0\x9F\x98"};
+            for (size_t count = 0; count < 80; ++count) {
+                std::string valid;
+                for (size_t i = 0; i < count; ++i) {
+                    valid += valid_pieces[(i * 5 + count) % valid_pieces.size()];
+                }
+                CHECK(is_valid_utf8(valid));
+                CHECK_FALSE(find_invalid_utf8(valid).has_value());
+
+                for (std::string_view bad : bad_pieces) {
+                    // 非法序列放在中间和末尾，覆盖跨 32 字节块的情况
+                    const std::string middle = valid + std::string(bad) + "中";
+                    CHECK_FALSE(is_valid_utf8(middle));
+                    CHECK(find_invalid_utf8(middle) == valid.size());
+
+                    const std::string tail = valid + std::string(bad);
+                    CHECK_FALSE(is_valid_utf8(tail));
+                    CHECK(find_invalid_utf8(tail) == valid.size());
+                }
+            }
+        }
+        simd::setMaxLevel(SimdLevel::AVX512);
+    }
+
+    SUBCASE("与严格转换的结果一致") {
+        // 两字节组合全覆盖，前面加填充使组合落在块边界两侧
+        for (size_t padding : {0, 30, 31}) {
+            for (int first = 0x80; first <= 0xFF; ++first) {
+                for (int second = 0x00; second <= 0xFF; ++second) {
+                    for (std::string_view suffix : {"", "\x80", "\x80\x80"}) {
+                        const std::string input = std::string(padding, 'x') + static_cast<char>(first) +
+                                                  static_cast<char>(second) + std::string(suffix);
+                        std::array<char, 128> out{};
+                        const bool convertible = convert_encoding(input, out, "UTF-16LE", "UTF-8").has_value();
+                        CHECK(is_valid_utf8(input) == convertible);
+                    }
+                }
+            }
+        }
+    }
+
+    SUBCASE("码位个数") {
+        for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::AVX2}) {
+            simd::setMaxLevel(level);
+            CHECK(utf8_length("") == 0);
+            CHECK(utf8_length("abc") == 3);
+            CHECK(utf8_length("你好abc😀") == 6);
+
+            std::string text;
+            for (int i = 0; i < 1000; ++i) {
+                text += "字符a";
+            }
+            CHECK(utf8_length(text) == 3000);
+        }
+        simd::setMaxLevel(SimdLevel::AVX512);
+    }
+
+    SUBCASE("显示宽度") {
+        for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::AVX2}) {
+            simd::setMaxLevel(level);
+            CHECK(utf8_display_width("") == 0);
+            CHECK(utf8_display_width("hello") == 5);
+            CHECK(utf8_display_width("你好") == 4);
+            CHECK(utf8_display_width("ＡＢ") == 4);        // 全角
+            CHECK(utf8_display_width("e\xCC\x81") == 1);  // 组合重音符
+            CHECK(utf8_display_width("😀") == 2);
+            CHECK(utf8_display_width("a\tb\n") == 2);     // 控制字符
+            CHECK(utf8_display_width("a\xFF" "b\xE4\xBD") == 4);
+
+            std::string text;
+            for (int i = 0; i < 100; ++i) {
+                text += "宽度测试 width\x01";
+            }
+            CHECK(utf8_display_width(text) == 100 * 14);
+        }
+        simd::setMaxLevel(SimdLevel::AVX512);
+    }
+}
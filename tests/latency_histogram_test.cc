@@ -0,0 +1,211 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <doctest/doctest.h>
+#include <sequoia/utils/latency_histogram.h>
+
+#include <cmath>
+#include <thread>
+#include <vector>
+
+using namespace sequoia::utils;
+
+TEST_CASE("LatencyHistogram - 记录与统计") {
+    LatencyHistogram histogram;
+    CHECK(histogram.count() == 0);
+    CHECK(histogram.min() == 0);
+    CHECK(histogram.max() == 0);
+    CHECK(histogram.percentile(0.99) == 0);
+
+    for (uint64_t value = 1; value <= 1000; ++value) {
+        CHECK(histogram.record(value));
+    }
+    CHECK(histogram.count() == 1000);
+    CHECK(histogram.total() == 500500);
+    CHECK(histogram.min() == 1);
+    CHECK(histogram.max() == 1000);
+    CHECK(histogram.mean() == doctest::Approx(500.5));
+
+    SUBCASE("超过 highest_trackable 的值不记录") {
+        LatencyHistogram small(1000);
+        CHECK(small.record(1000));
+        CHECK_FALSE(small.record(1001));
+        CHECK(small.count() == 1);
+        CHECK(small.overflow() == 1);
+    }
+
+    SUBCASE("reset") {
+        histogram.reset();
+        CHECK(histogram.count() == 0);
+        CHECK(histogram.total() == 0);
+        CHECK(histogram.min() == 0);
+        CHECK(histogram.percentile(0.5) == 0);
+    }
+}
+
+TEST_CASE("LatencyHistogram - 精度与分位数") {
+    SUBCASE("小于线性桶数的值精确记录") {
+        LatencyHistogram histogram(1'000'000, 2);
+        CHECK(histogram.lowest_equivalent(100) == 100);
+        CHECK(histogram.highest_equivalent(100) == 100);
+    }
+
+    SUBCASE("相对误差不超过 10^-digits") {
+        for (uint32_t digits = 1; digits <= 4; ++digits) {
+            const LatencyHistogram histogram(UINT64_MAX, digits);
+            const double limit = std::pow(10.0, -static_cast<double>(digits));
+            for (uint64_t value = 1; value < (uint64_t{1} << 62); value = value * 3 + 1) {
+                const uint64_t low = histogram.lowest_equivalent(value);
+                const uint64_t high = histogram.highest_equivalent(value);
+                REQUIRE(low <= value);
+                REQUIRE(value <= high);
+                CHECK(static_cast<double>(high - low) <= static_cast<double>(low) * limit + 1.0);
+            }
+        }
+        const LatencyHistogram histogram(UINT64_MAX, 1);
+        CHECK(histogram.highest_equivalent(UINT64_MAX) == UINT64_MAX);
+    }
+
+    SUBCASE("均匀分布的分位数") {
+        LatencyHistogram histogram(10'000'000, 3);
+        for (uint64_t value = 1; value <= 1'000'000; ++value) {
+            histogram.record(value);
+        }
+        CHECK(histogram.percentile(0.0) == 1);
+        CHECK(histogram.percentile(0.5) == doctest::Approx(500'000).epsilon(0.001));
+        CHECK(histogram.percentile(0.99) == doctest::Approx(990'000).epsilon(0.001));
+        CHECK(histogram.percentile(0.999) == doctest::Approx(999'000).epsilon(0.001));
+        CHECK(histogram.percentile(1.0) == 1'000'000);
+    }
+
+    SUBCASE("批量记录") {
+        LatencyHistogram histogram;
+        histogram.record(10, 99);
+        histogram.record(5000, 1);
+        CHECK(histogram.count() == 100);
+        CHECK(histogram.percentile(0.99) == 10);
+        CHECK(histogram.percentile(1.0) == 5000);
+    }
+}
+
+TEST_CASE("LatencyHistogram - 合并与并发记录") {
+    SUBCASE("每线程一个实例再合并") {
+        constexpr int kThreads = 4;
+        std::vector<LatencyHistogram> locals;
+        for (int i = 0; i < kThreads; ++i) {
+            locals.emplace_back();
+        }
+        std::vector<std::thread> threads;
+        for (int i = 0; i < kThreads; ++i) {
+            threads.emplace_back([&histogram = locals[i], i] {
+                for (uint64_t value = 0; value < 10000; ++value) {
+                    histogram.record(value + static_cast<uint64_t>(i) * 10000);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        LatencyHistogram merged;
+        for (const auto& local : locals) {
+            merged.merge(local);
+        }
+        CHECK(merged.count() == 40000);
+        CHECK(merged.min() == 0);
+        CHECK(merged.max() == 39999);
+        CHECK(merged.percentile(0.5) == doctest::Approx(20000).epsilon(0.01));
+    }
+
+    SUBCASE("多线程同时记录同一实例") {
+        LatencyHistogram shared;
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 4; ++i) {
+            threads.emplace_back([&shared] {
+                for (uint64_t value = 1; value <= 10000; ++value) {
+                    shared.record(value);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        CHECK(shared.count() == 40000);
+        CHECK(shared.total() == 4 * 50005000ull);
+        CHECK(shared.max() == 10000);
+    }
+
+    SUBCASE("不同配置的直方图") {
+        LatencyHistogram coarse(1'000'000, 1);
+        coarse.record(123456);
+        coarse.record(2'000'000);
+        LatencyHistogram fine(100'000, 3);
+        fine.merge(coarse);
+        CHECK(fine.count() == 0);
+        CHECK(fine.overflow() == 2);
+
+        LatencyHistogram wide(UINT64_MAX, 3);
+        wide.merge(coarse);
+        CHECK(wide.count() == 1);
+        CHECK(wide.min() == 123456);
+        CHECK(wide.max() == 123456);
+        CHECK(wide.overflow() == 1);
+    }
+
+    SUBCASE("桶数相同但范围更大") {
+        LatencyHistogram narrow(1000, 3);
+        LatencyHistogram wider(1023, 3);
+        wider.record(500);
+        wider.record(1020);
+        narrow.merge(wider);
+        CHECK(narrow.count() == 1);
+        CHECK(narrow.overflow() == 1);
+        CHECK(narrow.min() == 500);
+        CHECK(narrow.max() == 500);
+        CHECK(narrow.max() <= narrow.highest_trackable());
+
+        // 范围更小的一方仍走直接相加
+        LatencyHistogram target(1023, 3);
+        target.merge(narrow);
+        CHECK(target.count() == 1);
+        CHECK(target.overflow() == 1);
+        CHECK(target.max() == 500);
+    }
+}
+
+TEST_CASE("LatencyHistogram - 序列化") {
+    LatencyHistogram histogram(1'000'000'000, 3);
+    for (uint64_t value = 0; value < 5000; value += 7) {
+        histogram.record(value * value);
+    }
+    histogram.record(2'000'000'000);
+
+    const std::string bytes = histogram.serialize();
+    // 只写非空桶，远小于桶数组本身
+    CHECK(bytes.size() < 8 * 1024);
+
+    auto restored = LatencyHistogram::deserialize(bytes);
+    REQUIRE(restored.has_value());
+    CHECK(restored->highest_trackable() == histogram.highest_trackable());
+    CHECK(restored->significant_digits() == 3);
+    CHECK(restored->count() == histogram.count());
+    CHECK(restored->total() == histogram.total());
+    CHECK(restored->min() == histogram.min());
+    CHECK(restored->max() == histogram.max());
+    CHECK(restored->overflow() == 1);
+    for (double quantile : {0.1, 0.5, 0.9, 0.99, 0.999}) {
+        CHECK(restored->percentile(quantile) == histogram.percentile(quantile));
+    }
+    CHECK(restored->serialize() == bytes);
+
+    const auto empty = LatencyHistogram::deserialize(LatencyHistogram().serialize());
+    REQUIRE(empty.has_value());
+    CHECK(empty->count() == 0);
+    CHECK(empty->min() == 0);
+
+    CHECK_FALSE(LatencyHistogram::deserialize("").has_value());
+    CHECK_FALSE(LatencyHistogram::deserialize("XXXX").has_value());
+    CHECK_FALSE(LatencyHistogram::deserialize(bytes.substr(0, bytes.size() - 1)).has_value());
+    std::string wrong_version = bytes;
+    wrong_version[4] = 2;
+    CHECK_FALSE(LatencyHistogram::deserialize(wrong_version).has_value());
+}
@@ -0,0 +1,105 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <doctest/doctest.h>
+#include <sequoia/utils/metrics/reporter.h>
+#include <sequoia/utils/trace/message.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace sequoia::utils;
+using namespace sequoia::utils::metrics;
+
+namespace {
+
+std::string readFile(const std::filesystem::path& path) {
+    std::ifstream file(path);
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+// Logger 转发的每条消息（与写入 spdlog 的文本相同，带 "[级别] [模块] " 前缀）
+std::mutex logged_mutex;
+std::vector<std::string> logged_lines;
+
+void captureLine(std::string_view text, uint32_t) {
+    const std::lock_guard<std::mutex> guard(logged_mutex);
+    logged_lines.emplace_back(text);
+}
+
+bool logged(std::string_view line) {
+    const std::lock_guard<std::mutex> guard(logged_mutex);
+    return std::any_of(logged_lines.begin(), logged_lines.end(), [line](const std::string& text) {
+        return text.size() >= line.size() && text.compare(text.size() - line.size(), line.size(), line) == 0;
+    });
+}
+
+} // namespace
+
+TEST_CASE("MetricsReporter - 启动与停止") {
+    MetricsRegistry registry;
+    MetricsReporter reporter(registry);
+    const auto path = std::filesystem::temp_directory_path() / "sequoia_metrics_reporter_test.prom";
+    std::filesystem::remove(path);
+
+    CHECK_FALSE(reporter.start(std::chrono::milliseconds(0), nullptr, path.string()));
+    CHECK_FALSE(reporter.start(std::chrono::milliseconds(10), nullptr));
+    CHECK_FALSE(reporter.running());
+
+    Counter* ticks = registry.counter("reporter_test_ticks_total");
+    ticks->inc(7);
+    REQUIRE(reporter.start(std::chrono::milliseconds(10), nullptr, path.string()));
+    CHECK(reporter.running());
+    CHECK_FALSE(reporter.start(std::chrono::milliseconds(10), nullptr, path.string()));
+
+    for (int i = 0; i < 200 && !std::filesystem::exists(path); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    CHECK(readFile(path).find("reporter_test_ticks_total 7\n") != std::string::npos);
+
+    // 停止前再报告一次
+    ticks->inc();
+    reporter.stop();
+    CHECK_FALSE(reporter.running());
+    CHECK(readFile(path).find("reporter_test_ticks_total 8\n") != std::string::npos);
+
+    // 可以再次启动
+    REQUIRE(reporter.start(std::chrono::milliseconds(10), nullptr, path.string()));
+    reporter.stop();
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("MetricsReporter - 写入日志") {
+    MetricsRegistry registry;
+    Params labels;
+    labels.set("side", "buy");
+    registry.counter("reporter_test_orders_total", labels)->inc(2);
+    registry.gauge("reporter_test_depth")->set(3);
+
+    const MetricsReporter reporter(registry);
+    const auto logger = log::Logger::defaultLogger();
+    REQUIRE(logger != nullptr);
+    (void)trace::set_message_sink(&captureLine);
+    CHECK(reporter.report(logger));
+    (void)trace::set_message_sink(nullptr);
+
+    // 每个样本一行，不输出 # HELP / # TYPE
+    CHECK(logged("] metric reporter_test_orders_total{side=\"buy\"} 2"));
+    CHECK(logged("] metric reporter_test_depth 3"));
+    {
+        const std::lock_guard<std::mutex> guard(logged_mutex);
+        CHECK(logged_lines.size() == 2);
+        CHECK(std::none_of(logged_lines.begin(), logged_lines.end(),
+                           [](const std::string& text) { return text.find('#') != std::string::npos; }));
+    }
+
+    CHECK_FALSE(reporter.report(nullptr, "/nonexistent_dir/metrics.prom"));
+    log::Logger::shutdown();
+}
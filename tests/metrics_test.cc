@@ -0,0 +1,130 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <doctest/doctest.h>
+#include <sequoia/utils/metrics/metrics.h>
+
+#include <bit>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace sequoia::utils;
+using namespace sequoia::utils::metrics;
+
+TEST_CASE("Counter / Gauge - 多线程更新") {
+    Counter counter;
+    Gauge gauge;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; ++i) {
+        threads.emplace_back([&] {
+            for (int j = 0; j < 10000; ++j) {
+                counter.inc();
+                gauge.add(1.0);
+            }
+            counter.inc(5);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    CHECK(counter.value() == 80040);
+    CHECK(gauge.value() == doctest::Approx(80000.0));
+
+    gauge.set(-2.5);
+    gauge.sub(0.5);
+    CHECK(gauge.value() == doctest::Approx(-3.0));
+
+    CHECK(metrics::detail::shard_count() >= 1);
+    CHECK(std::has_single_bit(metrics::detail::shard_count()));
+    CHECK(metrics::detail::current_shard() < metrics::detail::shard_count());
+}
+
+TEST_CASE("MetricsRegistry - 注册") {
+    MetricsRegistry registry;
+
+    Params buy;
+    buy.set("side", "buy");
+    Params sell;
+    sell.set("side", "sell");
+
+    Counter* orders_buy = registry.counter("orders_total", buy, "Orders received");
+    Counter* orders_sell = registry.counter("orders_total", sell);
+    REQUIRE(orders_buy != nullptr);
+    REQUIRE(orders_sell != nullptr);
+    CHECK(orders_buy != orders_sell);
+    // 相同名称与标签返回同一个指标
+    CHECK(registry.counter("orders_total", buy) == orders_buy);
+    CHECK(registry.size() == 2);
+
+    // 同名不同类型
+    CHECK(registry.gauge("orders_total") == nullptr);
+    CHECK(registry.summary("orders_total") == nullptr);
+
+    CHECK(registry.gauge("queue_depth") != nullptr);
+    CHECK(registry.summary("latency_ns") != nullptr);
+    CHECK(registry.size() == 4);
+}
+
+TEST_CASE("MetricsRegistry - 标签与名称") {
+    CHECK(sanitize_metric_name("orders_total") == "orders_total");
+    CHECK(sanitize_metric_name("http.requests-total") == "http_requests_total");
+    CHECK(sanitize_metric_name("1st") == "_1st");
+    CHECK(sanitize_metric_name("ns:metric") == "ns:metric");
+    CHECK(sanitize_metric_name("") == "_");
+
+    Params labels;
+    labels.set("venue", "SH\"E\\X\n");
+    labels.set("id", 42);
+    labels.set("ratio", 0.5);
+    labels.set("live", true);
+    labels.set("bad:key", "v");
+    labels.set("list", std::vector<double>{1.0, 2.0});
+    CHECK(format_labels(labels) ==
+          R"({bad_key="v",id="42",live="true",ratio="0.5",venue="SH\"E\\X\n"})");
+    CHECK(format_labels(Params()).empty());
+}
+
+TEST_CASE("MetricsRegistry - Prometheus 文本格式") {
+    MetricsRegistry registry;
+    Params buy;
+    buy.set("side", "buy");
+
+    registry.counter("orders_total", buy, "Orders received\nper side")->inc(3);
+    registry.gauge("queue_depth", {}, "Pending orders")->set(1.5);
+    Summary* latency = registry.summary("latency_ns", buy, "", 1'000'000, 3);
+    for (uint64_t value = 1; value <= 100; ++value) {
+        latency->observe(value);
+    }
+
+    const std::string expected =
+        "# TYPE latency_ns summary\n"
+        "latency_ns{side=\"buy\",quantile=\"0.5\"} 50\n"
+        "latency_ns{side=\"buy\",quantile=\"0.9\"} 90\n"
+        "latency_ns{side=\"buy\",quantile=\"0.99\"} 99\n"
+        "latency_ns_sum{side=\"buy\"} 5050\n"
+        "latency_ns_count{side=\"buy\"} 100\n"
+        "# HELP orders_total Orders received\\nper side\n"
+        "# TYPE orders_total counter\n"
+        "orders_total{side=\"buy\"} 3\n"
+        "# HELP queue_depth Pending orders\n"
+        "# TYPE queue_depth gauge\n"
+        "queue_depth 1.5\n";
+    CHECK(registry.expose() == expected);
+
+    const std::string samples = registry.expose(false);
+    CHECK(samples.find('#') == std::string::npos);
+    CHECK(samples.find("orders_total{side=\"buy\"} 3\n") != std::string::npos);
+
+    const auto path = std::filesystem::temp_directory_path() / "sequoia_metrics_test.prom";
+    REQUIRE(registry.dump(path.string()));
+    std::ifstream file(path);
+    std::stringstream content;
+    content << file.rdbuf();
+    CHECK(content.str() == expected);
+    CHECK_FALSE(std::filesystem::exists(path.string() + ".tmp"));
+    std::filesystem::remove(path);
+
+    CHECK_FALSE(registry.dump("/nonexistent_dir/metrics.prom"));
+}
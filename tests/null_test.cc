@@ -2,9 +2,12 @@
 
 #include <doctest/doctest.h>
 #include <sequoia/utils/null.h>
+#include <sequoia/utils/simd/cpu.h>
 #include <limits>
 #include <cmath>
+#include <optional>
 #include <string>
+#include <vector>
 
 using namespace sequoia::utils;
 
@@ -299,3 +302,86 @@ TEST_CASE("Null - 特殊浮点值比较") {
     }
 }
 
+namespace {
+
+// 哨兵分布不规则，覆盖整块、跨块和尾部
+template <typename T>
+std::vector<T> makeSentinelValues(size_t size, size_t first_null) {
+    std::vector<T> values(size);
+    for (size_t i = 0; i < size; ++i) {
+        const bool null = i >= first_null && (i == first_null || i % 5 == 2 || i % 11 == 7);
+        values[i] = null ? static_cast<T>(Null<T>()) : static_cast<T>(i % 100);
+    }
+    return values;
+}
+
+template <typename T>
+void checkSentinelKernels() {
+    for (size_t size : {0, 1, 5, 8, 16, 31, 32, 33, 64, 100, 257}) {
+        for (size_t first_null : {size_t{0}, size / 2, size}) {
+            const auto values = makeSentinelValues<T>(size, first_null);
+
+            std::optional<size_t> first;
+            size_t nulls = 0;
+            std::vector<T> compacted;
+            for (size_t i = 0; i < size; ++i) {
+                if (is_null(values[i])) {
+                    first = first ? first : std::optional<size_t>(i);
+                    ++nulls;
+                } else {
+                    compacted.push_back(values[i]);
+                }
+            }
+
+            CHECK(find_first_null<T>(values) == first);
+            CHECK(count_null<T>(values) == nulls);
+
+            std::vector<T> out(size);
+            REQUIRE(compact_non_null<T>(values, out) == compacted.size());
+            out.resize(compacted.size());
+            CHECK(out == compacted);
+
+            // 原地紧凑化
+            auto in_place = values;
+            REQUIRE(compact_non_null<T>(in_place, in_place) == compacted.size());
+            in_place.resize(compacted.size());
+            CHECK(in_place == compacted);
+
+            auto replaced = values;
+            CHECK(replace_null<T>(replaced, T{42}) == nulls);
+            for (size_t i = 0; i < size; ++i) {
+                CHECK(replaced[i] == (is_null(values[i]) ? T{42} : values[i]));
+            }
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("is_null - 哨兵判断") {
+    CHECK(is_null(std::numeric_limits<int32_t>::max()));
+    CHECK_FALSE(is_null(int32_t{0}));
+    CHECK(is_null(std::numeric_limits<double>::quiet_NaN()));
+    CHECK(is_null(-std::numeric_limits<float>::quiet_NaN()));
+    CHECK_FALSE(is_null(std::numeric_limits<double>::infinity()));
+}
+
+TEST_CASE("哨兵批量操作 - 各指令集与逐个判断一致") {
+    using simd::SimdLevel;
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::AVX2}) {
+        simd::setMaxLevel(level);
+        checkSentinelKernels<double>();
+        checkSentinelKernels<float>();
+        checkSentinelKernels<int64_t>();
+        checkSentinelKernels<uint64_t>();
+        checkSentinelKernels<int32_t>();
+        checkSentinelKernels<uint32_t>();
+    }
+    simd::setMaxLevel(SimdLevel::AVX512);
+
+    SUBCASE("输出不足") {
+        const std::vector<double> values = {1.0, NAN, 2.0};
+        std::vector<double> out(2);
+        CHECK(compact_non_null<double>(values, out) == 0);
+    }
+}
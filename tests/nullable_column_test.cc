@@ -0,0 +1,154 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <doctest/doctest.h>
+#include <sequoia/utils/nullable_column.h>
+#include <sequoia/utils/simd/cpu.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+using namespace sequoia::utils;
+
+namespace {
+
+// 每 3 个或每 7 个元素置一个哨兵，值取整数以便浮点求和可精确比较
+template <typename T>
+std::vector<T> makeSentinelValues(size_t size) {
+    std::vector<T> values(size);
+    for (size_t i = 0; i < size; ++i) {
+        if (i % 3 == 1 || i % 7 == 5) {
+            values[i] = Null<T>();
+        } else {
+            values[i] = static_cast<T>((i * 37) % 1000);
+            if constexpr (std::is_signed_v<T>) {
+                values[i] = static_cast<T>(values[i] - 500);
+            }
+        }
+    }
+    return values;
+}
+
+template <typename T>
+void checkAgainstReference(size_t size) {
+    const auto values = makeSentinelValues<T>(size);
+    const auto column = NullableColumn<T>::from_sentinel(values);
+
+    size_t nulls = 0;
+    typename NullableColumn<T>::sum_type sum = 0;
+    std::optional<T> low;
+    std::optional<T> high;
+    for (size_t i = 0; i < size; ++i) {
+        if (is_null(values[i])) {
+            ++nulls;
+            CHECK(column.is_null(i));
+            CHECK(column.values()[i] == T{});
+            continue;
+        }
+        CHECK(column.get(i) == values[i]);
+        sum += values[i];
+        low = low ? std::min(*low, values[i]) : values[i];
+        high = high ? std::max(*high, values[i]) : values[i];
+    }
+
+    CHECK(column.null_count() == nulls);
+    CHECK(column.sum() == sum);
+    CHECK(column.min() == low);
+    CHECK(column.max() == high);
+
+    const auto filled = column.fill_null(T{7});
+    const auto sentinel = column.to_sentinel();
+    for (size_t i = 0; i < size; ++i) {
+        CHECK(filled[i] == (is_null(values[i]) ? T{7} : values[i]));
+        CHECK(is_null(sentinel[i]) == is_null(values[i]));
+    }
+}
+
+template <typename T>
+void checkAllSizes() {
+    for (size_t size : {0, 1, 3, 4, 7, 8, 9, 63, 64, 65, 100, 128, 1000}) {
+        checkAgainstReference<T>(size);
+    }
+}
+
+} // namespace
+
+TEST_CASE("NullableColumn - 基本操作") {
+    NullableColumn<int64_t> column;
+    column.push_back(5);
+    column.push_null();
+    column.push_back(-3);
+
+    CHECK(column.size() == 3);
+    CHECK(column.null_count() == 1);
+    CHECK(column.get(0) == 5);
+    CHECK_FALSE(column.get(1).has_value());
+    CHECK(column.sum() == 2);
+    CHECK(column.min() == -3);
+    CHECK(column.max() == 5);
+
+    column.set(1, 10);
+    CHECK(column.null_count() == 0);
+    CHECK(column.max() == 10);
+    column.set_null(0);
+    column.set_null(0);
+    CHECK(column.null_count() == 1);
+    CHECK(column.values()[0] == 0);
+
+    SUBCASE("全为 null") {
+        NullableColumn<double> empty(10);
+        CHECK(empty.null_count() == 10);
+        CHECK(empty.sum() == 0.0);
+        CHECK_FALSE(empty.min().has_value());
+        CHECK_FALSE(empty.max().has_value());
+    }
+}
+
+TEST_CASE("NullableColumn - Arrow 有效位图布局") {
+    NullableColumn<int32_t> column;
+    for (int i = 0; i < 10; ++i) {
+        if (i % 2 == 0) {
+            column.push_back(i);
+        } else {
+            column.push_null();
+        }
+    }
+    const auto bitmap = column.validity_bitmap();
+    REQUIRE(bitmap.size() == 2);
+    CHECK(bitmap[0] == 0b01010101);
+    // 超出 size 的位为 0
+    CHECK(bitmap[1] == 0b00000001);
+}
+
+TEST_CASE("NullableColumn - 哨兵编码互转") {
+    const std::vector<double> prices = {1.5, NAN, 2.5, NAN};
+    const auto column = NullableColumn<double>::from_sentinel(prices);
+    CHECK(column.null_count() == 2);
+    CHECK(column.sum() == 4.0);
+
+    std::vector<double> out(4);
+    CHECK(column.to_sentinel(out) == 4);
+    CHECK(out[0] == 1.5);
+    CHECK(out[1] == Null<double>());
+    std::vector<double> small(3);
+    CHECK(column.to_sentinel(small) == 0);
+
+    const std::vector<uint32_t> counts = {Null<uint32_t>(), 4, 6};
+    const auto count_column = NullableColumn<uint32_t>::from_sentinel(counts);
+    CHECK(count_column.is_null(0));
+    CHECK(count_column.sum() == 10);
+}
+
+TEST_CASE("NullableColumn - 各指令集与逐元素计算一致") {
+    using simd::SimdLevel;
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        simd::setMaxLevel(level);
+        checkAllSizes<double>();
+        checkAllSizes<int64_t>();
+        checkAllSizes<float>();
+        checkAllSizes<int32_t>();
+        checkAllSizes<uint64_t>();
+    }
+    simd::setMaxLevel(SimdLevel::AVX512);
+}
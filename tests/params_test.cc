@@ -435,14 +435,182 @@ TEST_CASE("Params - support 静态方法") {
         CHECK(Params::support(std::any(42)) == true);
         CHECK(Params::support(std::any(100LL)) == true);
         CHECK(Params::support(std::any(3.14)) == true);
+        CHECK(Params::support(std::any(std::string("test"))) == true);
+        CHECK(Params::support(std::any(std::vector<double>{1.0})) == true);
+        CHECK(Params::support(std::any(std::vector<int64_t>{1})) == true);
+        CHECK(Params::support(std::any(Params())) == true);
     }
     
     SUBCASE("不支持的类型") {
-        CHECK(Params::support(std::any(std::string("test"))) == false);
+        CHECK(Params::support(std::any(3.14f)) == false);
+        CHECK(Params::support(std::any(std::vector<int>{1})) == false);
         CHECK(Params::support(std::any()) == false);
     }
 }
 
+// ==================== 字符串、数组与嵌套参数测试 ====================
+
+TEST_CASE("Params - 字符串类型") {
+    Params params;
+    
+    SUBCASE("设置和获取字符串") {
+        params.set("name", std::string("sequoia"));
+        CHECK(params.get<std::string>("name") == "sequoia");
+        CHECK(params.type("name") == "string");
+    }
+    
+    SUBCASE("字符串字面量按 std::string 存储") {
+        params.set("path", "/tmp/data");
+        CHECK(params.get<std::string>("path") == "/tmp/data");
+    }
+    
+    SUBCASE("类型不匹配") {
+        params.set("name", "abc");
+        CHECK_THROWS_AS(params.set("name", 1), std::logic_error);
+        CHECK_THROWS_AS([&]{ (void)params.get<int>("name"); }(), std::runtime_error);
+    }
+}
+
+TEST_CASE("Params - 数组类型") {
+    Params params;
+    
+    SUBCASE("double 数组") {
+        const std::vector<double> values{1.5, 2.5, 3.5};
+        params.set("weights", values);
+        CHECK(params.get<std::vector<double>>("weights") == values);
+        CHECK(params.type("weights") == "double[]");
+    }
+    
+    SUBCASE("int64 数组（超过内联容量）") {
+        std::vector<int64_t> values;
+        for (int64_t i = 0; i < 100; ++i) {
+            values.push_back(i * 1000000000000);
+        }
+        params.set("ids", values);
+        CHECK(params.get<std::vector<int64_t>>("ids") == values);
+        CHECK(params.type("ids") == "int64[]");
+    }
+    
+    SUBCASE("double 数组与 int64 数组不兼容") {
+        params.set("values", std::vector<double>{1.0});
+        CHECK_THROWS_AS(params.set("values", std::vector<int64_t>{1}), std::logic_error);
+    }
+}
+
+TEST_CASE("Params - 嵌套参数") {
+    Params inner;
+    inner.set("host", "localhost");
+    inner.set("port", 8080);
+    
+    Params params;
+    params.set("db", inner);
+    
+    SUBCASE("获取嵌套参数") {
+        auto db = params.get<Params>("db");
+        CHECK(db == inner);
+        CHECK(db.get<int>("port") == 8080);
+        CHECK(params.type("db") == "params");
+    }
+    
+    SUBCASE("拷贝后修改互不影响") {
+        Params copy(params);
+        inner.set("port", 9090);
+        copy.set("db", inner);
+        CHECK(params.get<Params>("db").get<int>("port") == 8080);
+        CHECK(copy.get<Params>("db").get<int>("port") == 9090);
+        CHECK(params < copy);
+    }
+}
+
+TEST_CASE("Params - to_string 与 from_string 往返") {
+    Params inner;
+    inner.set("x", 1);
+    inner.set("y", std::vector<double>{0.5, 1.5});
+    
+    Params params;
+    params.set("flag", true);
+    params.set("count", 10);
+    params.set("big", int64_t{10000000000});
+    params.set("ratio", 0.25);
+    params.set("name", "a \"quoted\", text");
+    params.set("ids", std::vector<int64_t>{1, 2, 3});
+    params.set("nested", inner);
+    
+    SUBCASE("输出格式") {
+        std::string str = params.to_string();
+        CHECK(str.find("ids=[1, 2, 3]") != std::string::npos);
+        CHECK(str.find("nested={x=1, y=[0.5, 1.5]}") != std::string::npos);
+        CHECK(str.find(R"(name="a \"quoted\", text")") != std::string::npos);
+    }
+    
+    SUBCASE("解析后相等") {
+        Params parsed = Params::from_string(params.to_string());
+        CHECK(parsed == params);
+        CHECK(parsed.type("big") == "int64");
+        CHECK(parsed.type("count") == "int");
+    }
+    
+    SUBCASE("保留类型") {
+        Params typed;
+        typed.set("whole", 1.0);
+        typed.set("negative_zero", -0.0);
+        typed.set("precise", 0.1 + 0.2);
+        typed.set("huge", 1e300);
+        typed.set("doubles", std::vector<double>{1.0, 2.5});
+        typed.set("empty_ints", std::vector<int64_t>{});
+        typed.set("empty_doubles", std::vector<double>{});
+        Params nested;
+        nested.set("empty", std::vector<int64_t>{});
+        nested.set("whole", 2.0);
+        typed.set("nested", nested);
+
+        const std::string str = typed.to_string();
+        CHECK(str.find("whole=1.0") != std::string::npos);
+        CHECK(str.find("doubles=[1.0, 2.5]") != std::string::npos);
+        CHECK(str.find("empty_ints=int64[]") != std::string::npos);
+        CHECK(str.find("empty_doubles=double[]") != std::string::npos);
+
+        Params parsed = Params::from_string(str);
+        CHECK(parsed == typed);
+        CHECK(parsed.type("whole") == "double");
+        CHECK(parsed.type("negative_zero") == "double");
+        CHECK(parsed.get<double>("precise") == 0.1 + 0.2);
+        CHECK(parsed.get<double>("huge") == 1e300);
+        CHECK(parsed.type("doubles") == "double[]");
+        CHECK(parsed.type("empty_ints") == "int64[]");
+        CHECK(parsed.type("empty_doubles") == "double[]");
+        CHECK(parsed.get<Params>("nested").type("empty") == "int64[]");
+        CHECK(parsed.get<Params>("nested").type("whole") == "double");
+        CHECK(Params::from_string("a=[]").type("a") == "double[]");
+        CHECK_THROWS_AS((void)Params::from_string("a=int64[]x"), std::invalid_argument);
+    }
+
+    SUBCASE("格式错误抛出异常") {
+        CHECK_THROWS_AS((void)Params::from_string("a"), std::invalid_argument);
+        CHECK_THROWS_AS((void)Params::from_string("a={b=1"), std::invalid_argument);
+        CHECK_THROWS_AS((void)Params::from_string("a=[1, }"), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Params - get_any 和 set_any") {
+    Params params;
+    
+    SUBCASE("数组以 std::vector 交换") {
+        set_any(params, "v", std::any(std::vector<double>{1.0, 2.0}));
+        auto value = get_any(params, "v");
+        CHECK(std::any_cast<std::vector<double>>(value) == std::vector<double>{1.0, 2.0});
+    }
+    
+    SUBCASE("不支持的类型抛出异常") {
+        CHECK_THROWS_AS(set_any(params, "f", std::any(1.0f)), std::invalid_argument);
+    }
+    
+    SUBCASE("类型不匹配抛出异常") {
+        params.set("s", "text");
+        CHECK_THROWS_AS(set_any(params, "s", std::any(1)), std::logic_error);
+    }
+}
+
 // ==================== 宏功能测试 ====================
 
 class TestClassWithParams {
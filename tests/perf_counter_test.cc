@@ -0,0 +1,145 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+// 本测试直接验证硬件计数器 zone，不依赖构建时是否开启 UTIL_TRACE_PERF
+#ifndef UTIL_TRACE_PERF
+#define UTIL_TRACE_PERF 1
+#endif
+
+#include <doctest/doctest.h>
+#include <sequoia/utils/trace/perf_counter.h>
+#include <sequoia/utils/trace/trace.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+using namespace sequoia::utils::trace;
+
+namespace {
+
+uint64_t busyLoop(uint64_t iterations) {
+    T_SCOPED_PERF("perf_test::busy_loop");
+    volatile uint64_t sum = 0;
+    for (uint64_t i = 0; i < iterations; ++i) {
+        sum = sum + i * 2654435761u;
+    }
+    return sum;
+}
+
+} // namespace
+
+TEST_CASE("PerfSample - 差值与比率") {
+    const PerfSample begin{100, 200, 3, 4};
+    const PerfSample end{1100, 2200, 5, 10};
+    const PerfSample delta = end - begin;
+    CHECK(delta.cycles == 1000);
+    CHECK(delta.instructions == 2000);
+    CHECK(delta.cache_misses == 2);
+    CHECK(delta.branch_misses == 6);
+    CHECK(delta.ipc() == doctest::Approx(2.0));
+    CHECK(delta.cache_mpki() == doctest::Approx(1.0));
+    CHECK(delta.branch_mpki() == doctest::Approx(3.0));
+
+    PerfSample total;
+    total += delta;
+    total += delta;
+    CHECK(total.cycles == 2000);
+    CHECK(total.ipc() == doctest::Approx(2.0));
+
+    const PerfSample empty;
+    CHECK(empty.ipc() == 0.0);
+    CHECK(empty.cache_mpki() == 0.0);
+    CHECK(empty.branch_mpki() == 0.0);
+}
+
+TEST_CASE("PerfCounters - 读取") {
+    const PerfCounters& counters = PerfCounters::current();
+    PerfSample begin;
+    if (!counters.available()) {
+        MESSAGE("hardware counters unavailable, only checking the fallback path");
+        CHECK_FALSE(counters.read(begin));
+        CHECK(begin.cycles == 0);
+        CHECK_FALSE(counters.user_read());
+        return;
+    }
+
+    REQUIRE(counters.read(begin));
+    (void)busyLoop(1'000'000);
+    PerfSample end;
+    REQUIRE(counters.read(end));
+    const PerfSample delta = end - begin;
+    CHECK(delta.instructions > 1'000'000);
+    CHECK(delta.cycles > 0);
+    CHECK(delta.ipc() > 0.0);
+}
+
+TEST_CASE("PerfProfiler - 按 zone 累计") {
+    auto& profiler = PerfProfiler::instance();
+    profiler.reset();
+
+    static constexpr ZoneSite site{"perf_test::manual", std::source_location::current()};
+    profiler.record(&site, PerfSample{1000, 1500, 3, 6});
+    profiler.record(&site, PerfSample{1000, 2500, 1, 2});
+
+    std::thread worker([&profiler] { profiler.record(&site, PerfSample{2000, 4000, 4, 8}); });
+    worker.join();
+
+    const auto stats = profiler.find("perf_test::manual");
+    REQUIRE(stats.has_value());
+    CHECK(stats->count == 3);
+    CHECK(stats->total.cycles == 4000);
+    CHECK(stats->total.instructions == 8000);
+    CHECK(stats->total.ipc() == doctest::Approx(2.0));
+    CHECK(stats->total.cache_mpki() == doctest::Approx(1.0));
+    CHECK(stats->total.branch_mpki() == doctest::Approx(2.0));
+    CHECK(stats->file.find("perf_counter_test") != std::string::npos);
+
+    // 已退出线程的累计值在多次 snapshot 后保持不变
+    CHECK(profiler.find("perf_test::manual")->count == 3);
+    CHECK_FALSE(profiler.find("perf_test::missing").has_value());
+
+    // ScopedPerfZone 在析构时记录，record 不会抛出异常
+    static_assert(noexcept(profiler.record(&site, PerfSample{})));
+    static_assert(std::is_nothrow_destructible_v<ScopedPerfZone>);
+    CHECK(profiler.dropped() == 0);
+
+    const std::string report = profiler.report();
+    CHECK(report.find("perf_test::manual") != std::string::npos);
+    CHECK(report.find("IPC") != std::string::npos);
+    CHECK(report.find("dropped") == std::string::npos);
+
+    const auto path = std::filesystem::temp_directory_path() / "sequoia_perf_counter_test.txt";
+    REQUIRE(profiler.dump(path.string()));
+    std::ifstream file(path);
+    std::stringstream content;
+    content << file.rdbuf();
+    CHECK(content.str() == report);
+    std::filesystem::remove(path);
+
+    profiler.reset();
+    CHECK_FALSE(profiler.find("perf_test::manual").has_value());
+}
+
+TEST_CASE("PerfProfiler - T_SCOPED_PERF") {
+    auto& profiler = PerfProfiler::instance();
+    profiler.reset();
+
+    for (int i = 0; i < 3; ++i) {
+        (void)busyLoop(100'000);
+    }
+
+    const auto stats = profiler.find("perf_test::busy_loop");
+    if (!PerfCounters::current().available()) {
+        // 计数器不可用时 zone 不记录
+        CHECK_FALSE(stats.has_value());
+        CHECK(profiler.report().find("unavailable") != std::string::npos);
+        return;
+    }
+    REQUIRE(stats.has_value());
+    CHECK(stats->count == 3);
+    CHECK(stats->total.instructions > 300'000);
+    CHECK(stats->total.ipc() > 0.0);
+}
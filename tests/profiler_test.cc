@@ -0,0 +1,229 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+// 本测试直接验证进程内分析器，不依赖构建时是否开启 UTIL_TRACE_PROFILER
+#ifndef UTIL_TRACE_PROFILER
+#define UTIL_TRACE_PROFILER 1
+#endif
+
+#include <doctest/doctest.h>
+#include <sequoia/utils/trace/profiler.h>
+#include <sequoia/utils/trace/trace.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace sequoia::utils::trace;
+
+namespace {
+
+// 置位后当前线程的对齐分配抛出 bad_alloc，模拟线程缓冲（alignas(64)）分配失败
+thread_local bool fail_aligned_new = false;
+
+void sleepZone() {
+    T_SCOPED_NAME("profiler_test::sleep");
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+}
+
+void functionZone() {
+    T_SCOPED;
+}
+
+} // namespace
+
+TEST_CASE("Profiler - 基本统计") {
+    auto& profiler = Profiler::instance();
+    profiler.reset();
+
+    for (int i = 0; i < 5; ++i) {
+        sleepZone();
+    }
+
+    const auto stats = profiler.find("profiler_test::sleep");
+    REQUIRE(stats.has_value());
+    CHECK(stats->count == 5);
+    CHECK(stats->min_ns >= 1'500'000);
+    CHECK(stats->p50_ns >= stats->min_ns);
+    CHECK(stats->p99_ns <= stats->max_ns);
+    CHECK(stats->max_ns < 1'000'000'000);
+    CHECK(stats->total_ns >= stats->count * stats->min_ns);
+    CHECK(stats->line > 0);
+    CHECK(stats->file.find("profiler_test") != std::string::npos);
+
+    CHECK_FALSE(profiler.find("profiler_test::missing").has_value());
+}
+
+TEST_CASE("Profiler - T_SCOPED 使用函数名") {
+    auto& profiler = Profiler::instance();
+    profiler.reset();
+
+    functionZone();
+
+    const auto zones = profiler.snapshot();
+    REQUIRE(zones.size() == 1);
+    CHECK(zones[0].count == 1);
+    CHECK(zones[0].name.find("functionZone") != std::string::npos);
+}
+
+TEST_CASE("Profiler - 分位数") {
+    auto& profiler = Profiler::instance();
+    profiler.reset();
+
+    static constexpr ZoneSite site{"profiler_test::manual", std::source_location::current()};
+    const double scale = ticks_per_ns();
+    // 1..100 微秒各一个样本
+    for (uint64_t us = 1; us <= 100; ++us) {
+        const auto ticks = static_cast<uint64_t>(static_cast<double>(us * 1000) * scale);
+        Profiler::record(&site, 1000, 1000 + ticks);
+    }
+
+    const auto stats = profiler.find("profiler_test::manual");
+    REQUIRE(stats.has_value());
+    CHECK(stats->count == 100);
+    // 分桶相对误差不超过 1/16，时钟换算另有少量误差
+    CHECK(stats->p50_ns == doctest::Approx(50'000).epsilon(0.08));
+    CHECK(stats->p90_ns == doctest::Approx(90'000).epsilon(0.08));
+    CHECK(stats->p99_ns == doctest::Approx(99'000).epsilon(0.08));
+    CHECK(stats->max_ns == doctest::Approx(100'000).epsilon(0.02));
+    CHECK(stats->min_ns == doctest::Approx(1'000).epsilon(0.02));
+}
+
+TEST_CASE("Profiler - 多线程") {
+    auto& profiler = Profiler::instance();
+    profiler.reset();
+
+    constexpr int kThreads = 4;
+    constexpr int kZones = 1000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([] {
+            for (int i = 0; i < kZones; ++i) {
+                T_SCOPED_NAME("profiler_test::worker");
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // 线程已退出，其缓冲中的样本仍应被汇总
+    const auto stats = profiler.find("profiler_test::worker");
+    REQUIRE(stats.has_value());
+    CHECK(stats->count == kThreads * kZones);
+    CHECK(profiler.dropped() == 0);
+}
+
+// UTIL_TRACE_MEMORY 已替换全局 operator new，此时不再替换
+#if !(defined(UTIL_TRACE_ENABLE) && defined(UTIL_TRACE_MEMORY))
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    const auto align = static_cast<std::size_t>(alignment);
+    void* ptr = fail_aligned_new ? nullptr : std::aligned_alloc(align, (size + align) / align * align);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+TEST_CASE("Profiler - 线程缓冲分配失败") {
+    auto& profiler = Profiler::instance();
+    profiler.reset();
+
+    static constexpr ZoneSite site{"profiler_test::no_buffer", std::source_location::current()};
+    std::thread worker([] {
+        fail_aligned_new = true;
+        // 不抛出、不终止，样本计入 dropped
+        Profiler::record(&site, 0, 10);
+        Profiler::record(&site, 0, 10);
+        fail_aligned_new = false;
+        // 分配恢复后重新注册
+        Profiler::record(&site, 0, 10);
+    });
+    worker.join();
+
+    CHECK(profiler.dropped() == 2);
+    const auto stats = profiler.find("profiler_test::no_buffer");
+    REQUIRE(stats.has_value());
+    CHECK(stats->count == 1);
+
+    profiler.reset();
+    CHECK(profiler.dropped() == 0);
+}
+
+#endif
+
+TEST_CASE("Profiler - 缓冲满时丢弃") {
+    auto& profiler = Profiler::instance();
+    profiler.reset();
+
+    static constexpr ZoneSite site{"profiler_test::overflow", std::source_location::current()};
+    const size_t total = detail::ThreadBuffer::kCapacity + 100;
+    for (size_t i = 0; i < total; ++i) {
+        Profiler::record(&site, 0, 10);
+    }
+
+    CHECK(profiler.dropped() == 100);
+    const auto stats = profiler.find("profiler_test::overflow");
+    REQUIRE(stats.has_value());
+    CHECK(stats->count == detail::ThreadBuffer::kCapacity);
+
+    // 汇总后缓冲可继续写入
+    Profiler::record(&site, 0, 10);
+    CHECK(profiler.find("profiler_test::overflow")->count == detail::ThreadBuffer::kCapacity + 1);
+
+    profiler.reset();
+    CHECK(profiler.dropped() == 0);
+    CHECK_FALSE(profiler.find("profiler_test::overflow").has_value());
+}
+
+TEST_CASE("Profiler - 运行时开关") {
+    auto& profiler = Profiler::instance();
+    profiler.reset();
+
+    Profiler::set_enabled(false);
+    for (int i = 0; i < 10; ++i) {
+        T_SCOPED_NAME("profiler_test::disabled");
+    }
+    Profiler::set_enabled(true);
+    CHECK_FALSE(profiler.find("profiler_test::disabled").has_value());
+
+    {
+        T_SCOPED_NAME("profiler_test::disabled");
+    }
+    CHECK(profiler.find("profiler_test::disabled")->count == 1);
+}
+
+TEST_CASE("Profiler - 报表输出") {
+    auto& profiler = Profiler::instance();
+    profiler.reset();
+
+    sleepZone();
+
+    const std::string report = profiler.report();
+    CHECK(report.find("p99(ns)") != std::string::npos);
+    CHECK(report.find("profiler_test::sleep") != std::string::npos);
+
+    const auto path = std::filesystem::temp_directory_path() / "sequoia_profiler_test.txt";
+    REQUIRE(profiler.dump(path.string()));
+    std::ifstream file(path);
+    std::stringstream content;
+    content << file.rdbuf();
+    CHECK(content.str().find("profiler_test::sleep") != std::string::npos);
+    std::filesystem::remove(path);
+
+    CHECK_FALSE(profiler.dump("/nonexistent_dir/sequoia_profiler_test.txt"));
+}
@@ -0,0 +1,70 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <doctest/doctest.h>
+#include <sequoia/utils/small_vector.h>
+#include <utility>
+
+using namespace sequoia::utils;
+
+TEST_CASE("SmallVector - 内联存储") {
+    SmallVector<int64_t, 4> values{1, 2, 3};
+    
+    SUBCASE("不超过内联容量时不分配") {
+        CHECK(values.size() == 3);
+        CHECK(values.is_inline());
+        CHECK(values[2] == 3);
+    }
+    
+    SUBCASE("超过内联容量时转为堆存储") {
+        values.push_back(4);
+        CHECK(values.is_inline());
+        values.push_back(5);
+        CHECK_FALSE(values.is_inline());
+        CHECK(values.size() == 5);
+        CHECK(values.to_vector() == std::vector<int64_t>{1, 2, 3, 4, 5});
+    }
+
+    SUBCASE("扩容时追加自身元素") {
+        values.push_back(values[0]);
+        values.push_back(values[3]);
+        for (int64_t i = 0; i < 4; ++i) {
+            values.push_back(values[static_cast<size_t>(i)]);
+        }
+        CHECK(values.capacity() == 16);
+        CHECK(values.to_vector() == std::vector<int64_t>{1, 2, 3, 1, 1, 1, 2, 3, 1});
+    }
+}
+
+TEST_CASE("SmallVector - 拷贝和移动") {
+    SmallVector<double, 2> small{1.0, 2.0};
+    SmallVector<double, 2> large(std::vector<double>{1.0, 2.0, 3.0});
+    
+    SUBCASE("拷贝") {
+        SmallVector<double, 2> copy = large;
+        CHECK(copy == large);
+        copy = small;
+        CHECK(copy == small);
+    }
+    
+    SUBCASE("移动堆存储") {
+        const double* data = large.data();
+        SmallVector<double, 2> moved = std::move(large);
+        CHECK(moved.data() == data);
+        CHECK(moved.size() == 3);
+        CHECK(large.empty());
+    }
+    
+    SUBCASE("移动内联存储") {
+        SmallVector<double, 2> moved = std::move(small);
+        CHECK(moved.is_inline());
+        CHECK(moved.to_vector() == std::vector<double>{1.0, 2.0});
+    }
+}
+
+TEST_CASE("SmallVector - 比较") {
+    SmallVector<int64_t, 4> a{1, 2};
+    SmallVector<int64_t, 4> b{1, 3};
+    CHECK(a < b);
+    CHECK(a != b);
+    CHECK(a == SmallVector<int64_t, 4>{1, 2});
+}
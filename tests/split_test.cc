@@ -0,0 +1,118 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <doctest/doctest.h>
+#include <sequoia/utils/split.h>
+#include <sequoia/utils/arithmetic.h>
+#include <sequoia/utils/simd/cpu.h>
+#include <array>
+#include <ranges>
+#include <string>
+#include <vector>
+
+using namespace sequoia::utils;
+
+namespace {
+
+template <typename Range>
+std::vector<std::string_view> collect(Range&& range) {
+    std::vector<std::string_view> result;
+    for (std::string_view field : range) {
+        result.push_back(field);
+    }
+    return result;
+}
+
+} // namespace
+
+static_assert(std::ranges::forward_range<SplitView<detail::CharDelimiter>>);
+static_assert(std::ranges::view<SplitView<detail::StringDelimiter>>);
+static_assert(std::ranges::borrowed_range<SplitView<detail::AnyOfDelimiter>>);
+
+TEST_CASE("split_view - 单字符分割") {
+    SUBCASE("基本分割") {
+        CHECK(collect(split_view("a,b,c", ',')) == std::vector<std::string_view>{"a", "b", "c"});
+    }
+
+    SUBCASE("连续分隔符和首尾分隔符产生空字段") {
+        CHECK(collect(split_view(",a,,b,", ',')) == std::vector<std::string_view>{"", "a", "", "b", ""});
+    }
+
+    SUBCASE("空字符串产生一个空字段") {
+        CHECK(collect(split_view("", ',')) == std::vector<std::string_view>{""});
+        CHECK(collect(split_view(std::string_view(), ',')) == std::vector<std::string_view>{""});
+        CHECK(collect(split_view(std::string_view(), ",")) == std::vector<std::string_view>{""});
+        CHECK(collect(split_any(std::string_view(), ",;")) == std::vector<std::string_view>{""});
+    }
+
+    SUBCASE("与 std::views 组合，只解析需要的字段") {
+        auto first_two = split_view("a,b,c,d", ',') | std::views::take(2);
+        CHECK(collect(first_two) == std::vector<std::string_view>{"a", "b"});
+    }
+}
+
+TEST_CASE("split_view - 字符串分割") {
+    SUBCASE("多字符分隔符") {
+        CHECK(collect(split_view("a::b::c", "::")) == std::vector<std::string_view>{"a", "b", "c"});
+        CHECK(collect(split_view("a:b::c:", "::")) == std::vector<std::string_view>{"a:b", "c:"});
+    }
+
+    SUBCASE("分隔符为空时不分割") {
+        CHECK(collect(split_view("hello", "")) == std::vector<std::string_view>{"hello"});
+    }
+
+    SUBCASE("分隔符比字符串长") {
+        CHECK(collect(split_view("ab", "abc")) == std::vector<std::string_view>{"ab"});
+    }
+}
+
+TEST_CASE("split_any - 多分隔符分割") {
+    SUBCASE("任一分隔符") {
+        CHECK(collect(split_any("a,b;c d", ",; ")) == std::vector<std::string_view>{"a", "b", "c", "d"});
+        CHECK(collect(split_any("a,;b", ",;")) == std::vector<std::string_view>{"a", "", "b"});
+    }
+
+    SUBCASE("超过 SIMD 字符数的分隔符集合") {
+        const DelimiterSet delimiters("0123456789");
+        CHECK(delimiters.simd_chars().empty());
+        CHECK(collect(split_any("a1b22c", delimiters)) == std::vector<std::string_view>{"a", "b", "", "c"});
+    }
+}
+
+TEST_CASE("split_into - 写入调用方数组") {
+    std::array<std::string_view, 3> fields;
+
+    SUBCASE("字段数不超过数组长度") {
+        CHECK(split_into("a,b", ',', fields) == 2);
+        CHECK(fields[0] == "a");
+        CHECK(fields[1] == "b");
+    }
+
+    SUBCASE("字段数超过数组长度时最后一个元素保存剩余内容") {
+        CHECK(split_into("a,b,c,d", ',', fields) == 3);
+        CHECK(fields[2] == "c,d");
+        CHECK(split_into("a--b--c--d", "--", fields) == 3);
+        CHECK(fields[2] == "c--d");
+    }
+
+    SUBCASE("空数组") {
+        CHECK(split_into("a,b", ',', std::span<std::string_view>{}) == 0);
+    }
+}
+
+TEST_CASE("split_view - 各指令集结果一致") {
+    using simd::SimdLevel;
+
+    std::string line;
+    for (int i = 0; i < 200; ++i) {
+        line += std::to_string(i * 7919);
+        line += (i % 5 == 0) ? ';' : ',';
+    }
+
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::AVX2}) {
+        simd::setMaxLevel(level);
+        CHECK(collect(split_view(line, ',')).size() == 161);
+        CHECK(collect(split_any(line, ",;")).size() == 201);
+        CHECK(collect(split_view(line, ";")).size() == 41);
+    }
+    simd::setMaxLevel(SimdLevel::AVX512);
+}
@@ -0,0 +1,162 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+// 用进程内分析器观察 T_SCOPED_CAT 是否记录，不依赖构建时的跟踪选项
+#ifndef UTIL_TRACE_PROFILER
+#define UTIL_TRACE_PROFILER 1
+#endif
+
+#include <doctest/doctest.h>
+#include <sequoia/utils/trace/category.h>
+#include <sequoia/utils/trace/profiler.h>
+#include <sequoia/utils/trace/trace.h>
+
+#include <algorithm>
+#include <csignal>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace sequoia::utils::trace;
+
+namespace {
+
+void dbQuery() {
+    T_SCOPED_CAT("test_db", "category_test::query");
+}
+
+void netSend() {
+    T_SCOPED_CAT("test_net", "category_test::send");
+}
+
+uint64_t zoneCount(std::string_view name) {
+    const auto stats = Profiler::instance().find(name);
+    return stats ? stats->count : 0;
+}
+
+bool contains(const std::vector<std::string>& names, std::string_view name) {
+    return std::find(names.begin(), names.end(), name) != names.end();
+}
+
+} // namespace
+
+TEST_CASE("trace 类别 - 注册与开关") {
+    set_category_mask(0);
+
+    const uint64_t db = category_bit("test_db");
+    CHECK(db != 0);
+    CHECK((db & (db - 1)) == 0);
+    CHECK(category_bit("test_db") == db);
+    CHECK(category_bit("test_net") != db);
+    CHECK(contains(categories(), "test_db"));
+
+    CHECK_FALSE(category_enabled("test_db"));
+    enable_category("test_db");
+    CHECK(category_enabled("test_db"));
+    CHECK(category_enabled(db));
+    CHECK_FALSE(category_enabled("test_net"));
+    CHECK(enabled_categories() == std::vector<std::string>{"test_db"});
+
+    disable_category("test_db");
+    CHECK_FALSE(category_enabled("test_db"));
+
+    SUBCASE("非法名称") {
+        CHECK(category_bit("") == 0);
+        CHECK(category_bit(std::string(kMaxCategoryName + 1, 'x')) == 0);
+        CHECK(category_bit(std::string(kMaxCategoryName, 'x')) != 0);
+        CHECK_FALSE(category_enabled(uint64_t{0}));
+    }
+}
+
+TEST_CASE("trace 类别 - 列表设置") {
+    CHECK(set_categories("test_db, test_net"));
+    CHECK(category_enabled("test_db"));
+    CHECK(category_enabled("test_net"));
+
+    CHECK(set_categories("test_net"));
+    CHECK_FALSE(category_enabled("test_db"));
+    CHECK(category_enabled("test_net"));
+
+    // 列表中的新名称会被注册
+    CHECK(set_categories("test_new\ttest_db"));
+    CHECK(contains(categories(), "test_new"));
+    CHECK(category_enabled("test_new"));
+
+    // all 同时启用之后注册的类别
+    CHECK(set_categories("all"));
+    CHECK(category_enabled("test_registered_later"));
+
+    CHECK(set_categories("none"));
+    CHECK(category_mask() == 0);
+    CHECK(set_categories(""));
+    CHECK(category_mask() == 0);
+
+    CHECK_FALSE(set_categories("test_db," + std::string(kMaxCategoryName + 1, 'y')));
+    CHECK(category_enabled("test_db"));
+    set_category_mask(0);
+}
+
+TEST_CASE("trace 类别 - T_SCOPED_CAT") {
+    auto& profiler = Profiler::instance();
+    profiler.reset();
+    set_category_mask(0);
+
+    dbQuery();
+    netSend();
+    CHECK(zoneCount("category_test::query") == 0);
+    CHECK(zoneCount("category_test::send") == 0);
+
+    enable_category("test_db");
+    dbQuery();
+    netSend();
+    CHECK(zoneCount("category_test::query") == 1);
+    CHECK(zoneCount("category_test::send") == 0);
+
+    CHECK(T_CATEGORY_ENABLED("test_db"));
+    CHECK_FALSE(T_CATEGORY_ENABLED("test_net"));
+
+    set_category_mask(0);
+    dbQuery();
+    CHECK(zoneCount("category_test::query") == 1);
+}
+
+TEST_CASE("trace 类别 - 信号重新加载") {
+    const auto path = std::filesystem::temp_directory_path() / "sequoia_trace_category_test.txt";
+    REQUIRE(install_category_signal(SIGUSR2, path.string()));
+    set_category_mask(0);
+    (void)category_bit("test_db");
+    (void)category_bit("test_net");
+
+    {
+        std::ofstream file(path);
+        file << "test_net\nunknown_category\n";
+    }
+    REQUIRE(std::raise(SIGUSR2) == 0);
+    CHECK(category_enabled("test_net"));
+    CHECK_FALSE(category_enabled("test_db"));
+    // 未注册的名称被忽略
+    CHECK_FALSE(contains(categories(), "unknown_category"));
+
+    {
+        std::ofstream file(path);
+        file << "all";
+    }
+    REQUIRE(std::raise(SIGUSR2) == 0);
+    CHECK(category_enabled("test_db"));
+
+    {
+        std::ofstream file(path);
+    }
+    REQUIRE(std::raise(SIGUSR2) == 0);
+    CHECK(category_mask() == 0);
+
+    std::filesystem::remove(path);
+    // 文件不存在时保持原状态
+    enable_category("test_db");
+    REQUIRE(std::raise(SIGUSR2) == 0);
+    CHECK(category_enabled("test_db"));
+
+    CHECK_FALSE(install_category_signal(SIGUSR2, ""));
+    CHECK_FALSE(install_category_signal(SIGUSR2, std::string(300, 'p')));
+    std::signal(SIGUSR2, SIG_DFL);
+    set_category_mask(0);
+}
@@ -1,9 +1,53 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 
 #include <doctest/doctest.h>
+#include <sequoia/utils/log/logger.h>
+#include <sequoia/utils/trace/category.h>
+#include <sequoia/utils/trace/memory.h>
+#include <sequoia/utils/trace/message.h>
 #include <sequoia/utils/trace/trace.h>
 #include <thread>
 #include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using namespace sequoia::utils;
+
+namespace {
+
+// 只有进程内 profiler 能在测试中观察 zone；仅启用 Tracy 时 zone 发往服务端，计数恒为 0
+#ifdef UTIL_TRACE_PROFILER
+constexpr uint64_t kZoneRecorded = 1;
+#else
+constexpr uint64_t kZoneRecorded = 0;
+#endif
+
+uint64_t zoneCount(std::string_view name) {
+#ifdef UTIL_TRACE_PROFILER
+    const auto stats = trace::Profiler::instance().find(name);
+    return stats ? stats->count : 0;
+#else
+    (void)name;
+    return 0;
+#endif
+}
+
+// 替代 Tracy 的消息接收者，记录 Logger 转发的文本与颜色
+std::mutex captured_mutex;
+std::vector<std::pair<std::string, uint32_t>> captured_messages;
+
+void captureMessage(std::string_view text, uint32_t color) {
+    const std::lock_guard<std::mutex> guard(captured_mutex);
+    captured_messages.emplace_back(text, color);
+}
+
+} // namespace
 
 // 测试函数：使用作用域跟踪
 void TracedFunction() {
@@ -79,6 +123,7 @@ TEST_CASE("Trace Test") {
 
     // 3. 测试多个连续作用域
     SUBCASE("Multiple Sequential Scopes") {
+        const uint64_t before = zoneCount("Scope2");
         {
             T_SCOPED_NAME("Scope1");
             std::this_thread::sleep_for(std::chrono::milliseconds(5));
@@ -91,34 +136,39 @@ TEST_CASE("Trace Test") {
             T_SCOPED_NAME("Scope3");
             std::this_thread::sleep_for(std::chrono::milliseconds(5));
         }
-        CHECK(true);
+        CHECK(zoneCount("Scope2") - before == kZoneRecorded);
     }
 
     // 4. 测试循环中的跟踪
     SUBCASE("Trace in Loop") {
+        const uint64_t before = zoneCount("LoopIteration");
         for (int i = 0; i < 5; ++i) {
             T_SCOPED_NAME("LoopIteration");
             std::this_thread::sleep_for(std::chrono::milliseconds(5));
         }
-        CHECK(true);
+        CHECK(zoneCount("LoopIteration") - before == 5 * kZoneRecorded);
     }
 
     // 5. 测试多个帧标记
     SUBCASE("Multiple Frame Marks") {
+        int frames = 0;
         for (int frame = 0; frame < 3; ++frame) {
+            T_SCOPED_NAME("FrameBody");
             T_FRAME_MARK;
-            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            ++frames;
         }
-
         for (int frame = 0; frame < 3; ++frame) {
+            T_SCOPED_NAME("FrameBody");
             T_FRAME_MARK_NAME("TestFrame");
-            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            ++frames;
         }
-        CHECK(true);
+        CHECK(frames == 6);
+        CHECK(zoneCount("FrameBody") == 6 * kZoneRecorded);
     }
 
     // 6. 测试条件编译（所有宏都存在）
     SUBCASE("Conditional Compilation") {
+        const uint64_t before = zoneCount("ConditionalTest");
         {
             T_SCOPED;
         }
@@ -127,7 +177,12 @@ TEST_CASE("Trace Test") {
         }
         T_FRAME_MARK;
         T_FRAME_MARK_NAME("ConditionalFrame");
-        CHECK(true);
+        CHECK(zoneCount("ConditionalTest") - before == kZoneRecorded);
+        // 未启用任何后端时宏展开为空或常量
+#if !defined(UTIL_TRACE_ENABLE) && !defined(UTIL_TRACE_PROFILER) && !defined(UTIL_TRACE_CHROME)
+        static_assert(!T_IS_CONNECTED);
+        static_assert(!T_CATEGORY_ENABLED("trace_test"));
+#endif
     }
 
     // 7. 测试 Lambda 函数中的跟踪
@@ -177,13 +232,149 @@ TEST_CASE("Trace Test") {
 
     // 11. 测试完整生命周期
     SUBCASE("Full Lifecycle") {
+        const uint64_t lifecycle = zoneCount("LifecycleTest");
+        const uint64_t named = zoneCount("CustomNamedFunction");
         {
             T_SCOPED_NAME("LifecycleTest");
             TracedFunction();
             NamedTracedFunction();
             T_FRAME_MARK;
         }
-        CHECK(true);
+        CHECK(zoneCount("LifecycleTest") - lifecycle == kZoneRecorded);
+        CHECK(zoneCount("CustomNamedFunction") - named == kZoneRecorded);
+    }
+
+    // 12. 测试 zone 附加文本与数值
+    SUBCASE("Zone Text and Value") {
+        const uint64_t before = zoneCount("ZoneAnnotation");
+        {
+            T_SCOPED_NAME("ZoneAnnotation");
+            [[maybe_unused]] constexpr std::string_view text = "symbol=600000";
+            T_ZONE_TEXT(text.data(), text.size());
+            T_ZONE_VALUE(42);
+        }
+        CHECK(zoneCount("ZoneAnnotation") - before == kZoneRecorded);
+    }
+
+    // 13. 测试消息与数值曲线
+    SUBCASE("Messages and Plots") {
+        [[maybe_unused]] constexpr std::string_view message = "order received";
+        T_MESSAGE(message.data(), message.size());
+        T_MESSAGE_COLOR(message.data(), message.size(), 0xFF0000);
+        T_MESSAGE_L("literal message");
+        for (int i = 0; i < 10; ++i) {
+            T_PLOT("QueueDepth", static_cast<int64_t>(i));
+            T_PLOT("FillRatio", i / 10.0);
+        }
+
+        // Logger 只格式化一次，同一文本写入 spdlog 并转发到时间线（此处由 captureMessage 代替 Tracy）
+        auto logger = log::Logger::defaultLogger();
+        REQUIRE(logger != nullptr);
+        captured_messages.clear();
+        CHECK(trace::set_message_sink(&captureMessage) == nullptr);
+        logger->info("order {} qty={}", 42, 1.5);
+        logger->warn("{}", std::string("{not a format}"));
+        logger->debug("below level {}", 1);
+        CHECK(trace::set_message_sink(nullptr) == &captureMessage);
+        logger->info("after reset {}", 2);
+
+        const std::lock_guard<std::mutex> guard(captured_mutex);
+        REQUIRE(captured_messages.size() == 2);
+        CHECK(captured_messages[0].first == "[INFO] [SEQUOIA] order 42 qty=1.5");
+        CHECK(captured_messages[0].second == 0);
+        CHECK(captured_messages[1].first == "[WARN] [SEQUOIA] {not a format}");
+        CHECK(captured_messages[1].second == 0xFFC000);
+        log::Logger::shutdown();
+    }
+
+    // 14. 测试内存分配事件
+    SUBCASE("Memory Events") {
+        void* ptr = std::malloc(64);
+        T_ALLOC(ptr, 64);
+        T_FREE(ptr);
+        std::free(ptr);
+
+        void* pool_ptr = std::malloc(128);
+        T_ALLOC_NAME(pool_ptr, 128, "TestPool");
+        T_FREE_NAME(pool_ptr, "TestPool");
+        std::free(pool_ptr);
+
+        // 全局 new/delete 的自动上报（UTIL_TRACE_MEMORY）；其他线程可能同时分配，只检查下界
+        const trace::MemoryStats before = trace::memory_stats();
+        auto* value = new int64_t(7);
+        auto* block = new char[100];
+        delete value;
+        delete[] block;
+        const trace::MemoryStats after = trace::memory_stats();
+#if defined(UTIL_TRACE_ENABLE) && defined(UTIL_TRACE_MEMORY)
+        CHECK(after.allocations - before.allocations >= 2);
+        CHECK(after.frees - before.frees >= 2);
+        CHECK(after.allocated_bytes - before.allocated_bytes >= sizeof(int64_t) + 100);
+#else
+        // 未替换 operator new/delete 时计数恒为 0
+        CHECK(before.allocations == 0);
+        CHECK(after.allocations == before.allocations);
+        CHECK(after.frees == before.frees);
+        CHECK(after.allocated_bytes == before.allocated_bytes);
+#endif
+    }
+
+    // 15. 测试可追踪的互斥量（未启用跟踪时退化为原类型）
+    SUBCASE("Lockable Mutex") {
+        static T_LOCKABLE(std::mutex, mutex);
+        static T_LOCKABLE_NAME(std::mutex, named_mutex, "NamedMutex");
+        static T_SHARED_LOCKABLE(std::shared_mutex, shared_mutex);
+
+        int counter = 0;
+        auto worker = [&counter]() {
+            for (int i = 0; i < 100; ++i) {
+                std::lock_guard<T_LOCKABLE_BASE(std::mutex)> guard(mutex);
+                T_LOCK_MARK(mutex);
+                ++counter;
+            }
+        };
+        std::thread t1(worker);
+        std::thread t2(worker);
+        t1.join();
+        t2.join();
+        CHECK(counter == 200);
+
+        {
+            std::unique_lock<T_LOCKABLE_BASE(std::mutex)> lock(named_mutex);
+            CHECK(lock.owns_lock());
+        }
+        {
+            std::shared_lock<T_SHARED_LOCKABLE_BASE(std::shared_mutex)> lock(shared_mutex);
+            CHECK(lock.owns_lock());
+        }
+    }
+
+    // 16. 测试连接状态查询
+    SUBCASE("Connection State") {
+        // 测试进程不连接 Tracy 服务端
+        CHECK_FALSE(T_IS_CONNECTED);
+    }
+
+    // 17. 测试按类别开关的作用域（未启用跟踪时为空操作）
+    SUBCASE("Category Scopes") {
+        trace::disable_category("trace_test");
+        for (int i = 0; i < 3; ++i) {
+            T_SCOPED_CAT("trace_test", "CategoryScope");
+        }
+        CHECK(zoneCount("CategoryScope") == 0);
+        CHECK_FALSE(T_CATEGORY_ENABLED("trace_test"));
+
+        trace::enable_category("trace_test");
+        for (int i = 0; i < 3; ++i) {
+            T_SCOPED_CAT("trace_test", "CategoryScope");
+        }
+        CHECK(zoneCount("CategoryScope") == 3 * kZoneRecorded);
+#if defined(UTIL_TRACE_ENABLE) || defined(UTIL_TRACE_PROFILER) || defined(UTIL_TRACE_CHROME)
+        CHECK(T_CATEGORY_ENABLED("trace_test"));
+#else
+        CHECK_FALSE(T_CATEGORY_ENABLED("trace_test"));
+#endif
+        trace::disable_category("trace_test");
     }
 
     // 清理跟踪系统